@@ -17,7 +17,9 @@
 *******************************************************************************/
 #define _CRT_SECURE_NO_WARNINGS
 #include "binlib.h"
+#include "crc.h"
 #include <assert.h>
+#include <string.h>
 
 
 #define POS(bit) (1 << (7-(bit & 7)))
@@ -311,20 +313,37 @@ void numericToRevBCD (void* destination, unsigned destOffset, t_numeric source,
 	}
 }
 
+/*------------------------------------------------------------------------------
+	True if t_unicode is stored in memory as UTF-16LE, so that strings can be
+	transferred with a plain copy. It is constant at compile time.
+------------------------------------------------------------------------------*/
+static int binUnicodeIsLittleEndian ()
+{
+	const t_unicode one = 1;
+	return sizeof (t_unicode) == 2 && *(const unsigned char*)&one == 1;
+}
+
 /*------------------------------------------------------------------------------
 	Reads from binary mode an unicode string
 ------------------------------------------------------------------------------*/
 void binaryToUnicode (const void* source, unsigned sourceOffset, t_unicode* target, unsigned bitLen)
 {
+	const unsigned char* src;
 	unsigned i;
 
 	assert ((sourceOffset & 7) == 0);
 	assert ((bitLen & 15) == 0);
 
+	src = (const unsigned char*)source + (sourceOffset >> 3);
 	bitLen >>= 4;
 
-	for (i=0; i<bitLen; i++) {
-		target[i] = (t_unicode)binaryToNumeric (source, sourceOffset+16*i, 16);
+	if (binUnicodeIsLittleEndian ()) {
+		memcpy (target, src, bitLen*2);
+	}
+	else {
+		for (i=0; i<bitLen; i++) {
+			target[i] = (t_unicode)(src[2*i] | (src[2*i+1] << 8));
+		}
 	}
 }
 
@@ -333,15 +352,23 @@ void binaryToUnicode (const void* source, unsigned sourceOffset, t_unicode* targ
 ------------------------------------------------------------------------------*/
 void unicodeToBinary (void* destination, unsigned destOffset, const t_unicode* source, unsigned bitLen)
 {
+	unsigned char* dst;
 	unsigned i;
 
 	assert ((destOffset & 7) == 0);
 	assert ((bitLen & 15) == 0);
 
+	dst = (unsigned char*)destination + (destOffset >> 3);
 	bitLen >>= 4;
 
-	for (i=0; i<bitLen; i++) {
-		numericToBinary (destination, destOffset+16*i, source[i], 16);
+	if (binUnicodeIsLittleEndian ()) {
+		memcpy (dst, source, bitLen*2);
+	}
+	else {
+		for (i=0; i<bitLen; i++) {
+			dst[2*i] = (unsigned char)(source[i] & 0xFF);
+			dst[2*i+1] = (unsigned char)(source[i] >> 8);
+		}
 	}
 }
 
@@ -406,6 +433,175 @@ void unicodeToAsciiBinary (void* destination, unsigned destOffset, const t_unico
 	}
 }
 
+/*------------------------------------------------------------------------------
+	Repeats the first 'length' octets; each memcpy doubles the filled part
+------------------------------------------------------------------------------*/
+void binReplicate (t_buffer* buffer, unsigned length, unsigned count)
+{
+	unsigned done = length;
+	unsigned total = length*count;
+	
+	while (done < total) {
+		unsigned chunk = (done <= total-done ? done : total-done);
+		memcpy (buffer+done, buffer, chunk);
+		done += chunk;
+	}
+}
+
+/*------------------------------------------------------------------------------
+	Encodes the character at 'source' as UTF-8
+------------------------------------------------------------------------------*/
+unsigned unicodeCharToUtf8 (const t_unicode* source, unsigned* unitsUsed, unsigned char* target)
+{
+	unsigned long c = source[0];
+	
+	(*unitsUsed) = 1;
+	if (c < 0x80) {
+		target[0] = (unsigned char)c;
+		return 1;
+	}
+	if (c < 0x800) {
+		target[0] = (unsigned char)(0xC0 | (c >> 6));
+		target[1] = (unsigned char)(0x80 | (c & 0x3F));
+		return 2;
+	}
+	if (c >= 0xD800 && c <= 0xDBFF && source[1] >= 0xDC00 && source[1] <= 0xDFFF) {
+		c = 0x10000 + ((c - 0xD800) << 10) + (source[1] - 0xDC00);
+		(*unitsUsed) = 2;
+		target[0] = (unsigned char)(0xF0 | (c >> 18));
+		target[1] = (unsigned char)(0x80 | ((c >> 12) & 0x3F));
+		target[2] = (unsigned char)(0x80 | ((c >> 6) & 0x3F));
+		target[3] = (unsigned char)(0x80 | (c & 0x3F));
+		return 4;
+	}
+	/* Unpaired surrogates are kept as they are, so that they survive a round trip */
+	target[0] = (unsigned char)(0xE0 | (c >> 12));
+	target[1] = (unsigned char)(0x80 | ((c >> 6) & 0x3F));
+	target[2] = (unsigned char)(0x80 | (c & 0x3F));
+	return 3;
+}
+
+/*------------------------------------------------------------------------------
+	Returns the number of octets of the UTF-8 form of 'source'
+------------------------------------------------------------------------------*/
+unsigned unicodeUtf8Length (const t_unicode* source)
+{
+	unsigned length = 0;
+	unsigned i = 0;
+	
+	while (source[i]) {
+		t_unicode c = source[i];
+		if (c < 0x80) {length++; i++;}
+		else if (c < 0x800) {length += 2; i++;}
+		else if (c >= 0xD800 && c <= 0xDBFF && source[i+1] >= 0xDC00 && source[i+1] <= 0xDFFF) {length += 4; i += 2;}
+		else {length += 3; i++;}
+	}
+	return length;
+}
+
+/*------------------------------------------------------------------------------
+	Converts the zero terminated 'source' into a zero terminated UTF-8 string
+------------------------------------------------------------------------------*/
+unsigned unicodeToUtf8 (char* target, unsigned targetSize, const t_unicode* source)
+{
+	unsigned char encoded [4];
+	unsigned length = 0;
+	unsigned unitsUsed;
+	unsigned n;
+	
+	assert (targetSize > 0);
+	
+	for (;;) {
+		/* ASCII run: one octet per character */
+		while (source[0] != 0 && source[0] < 0x80 && length+1 < targetSize) {
+			target[length++] = (char)source[0];
+			source++;
+		}
+		if (source[0] == 0 || source[0] < 0x80) break;
+		
+		n = unicodeCharToUtf8 (source, &unitsUsed, encoded);
+		if (length+n >= targetSize) break;
+		memcpy (target+length, encoded, n);
+		length += n;
+		source += unitsUsed;
+	}
+	target[length] = '\0';
+	return length;
+}
+
+/*------------------------------------------------------------------------------
+	Returns the length of the valid UTF-8 sequence at 'source' and its value,
+	or 0 if the octets do not form a valid sequence.
+------------------------------------------------------------------------------*/
+static unsigned utf8DecodeSequence (const unsigned char* source, unsigned sourceLen, unsigned long* value)
+{
+	unsigned len;
+	unsigned long c;
+	unsigned i;
+	
+	if (source[0] >= 0xC2 && source[0] <= 0xDF) {len = 2; c = source[0] & 0x1F;}
+	else if (source[0] >= 0xE0 && source[0] <= 0xEF) {len = 3; c = source[0] & 0x0F;}
+	else if (source[0] >= 0xF0 && source[0] <= 0xF4) {len = 4; c = source[0] & 0x07;}
+	else return 0;
+	
+	if (len > sourceLen) return 0;
+	for (i=1; i<len; i++) {
+		if ((source[i] & 0xC0) != 0x80) return 0;
+		c = (c << 6) | (source[i] & 0x3F);
+	}
+	
+	/* Reject overlong forms and values out of range */
+	if ((len == 3 && c < 0x800) || (len == 4 && (c < 0x10000 || c > 0x10FFFF))) return 0;
+	
+	(*value) = c;
+	return len;
+}
+
+/*------------------------------------------------------------------------------
+	Converts 'sourceLen' octets of UTF-8 into a zero terminated unicode string
+------------------------------------------------------------------------------*/
+unsigned utf8ToUnicode (t_unicode* target, unsigned targetChars, const char* source, unsigned sourceLen)
+{
+	const unsigned char* src = (const unsigned char*)source;
+	unsigned chars = 0;
+	unsigned stored = 0;
+	unsigned i = 0;
+	unsigned long c;
+	unsigned len;
+	
+	while (i < sourceLen) {
+		/* ASCII run: one character per octet */
+		while (i < sourceLen && src[i] < 0x80) {
+			if (chars < targetChars) target[stored++] = src[i];
+			chars++;
+			i++;
+		}
+		if (i >= sourceLen) break;
+		
+		len = utf8DecodeSequence (src+i, sourceLen-i, &c);
+		if (len == 0) {
+			/* Not UTF-8: take the octet as ISO-8859-1 */
+			c = src[i];
+			len = 1;
+		}
+		i += len;
+		
+		if (c >= 0x10000) {
+			c -= 0x10000;
+			if (chars+1 < targetChars) {
+				target[stored++] = (t_unicode)(0xD800 + (c >> 10));
+				target[stored++] = (t_unicode)(0xDC00 + (c & 0x3FF));
+			}
+			chars += 2;
+		}
+		else {
+			if (chars < targetChars) target[stored++] = (t_unicode)c;
+			chars++;
+		}
+	}
+	target[stored] = 0;
+	return chars;
+}
 
 #ifndef NDEBUG
 
@@ -477,16 +673,89 @@ void testUnicode ()
 	}
 }
 
+void testUtf8 ()
+{
+	/* A, e acute, euro sign and U+1F600 as a surrogate pair */
+	static const t_unicode txt[] = {0x41, 0xE9, 0x20AC, 0xD83D, 0xDE00, 0};
+	static const char utf8[] = "A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+	static const t_unicode unpaired[] = {0xDC00, 0x41, 0xD800, 0};
+	static const t_unicode upper[] = {'C', 0xC9, 0x394, 0x416, 0x401, 0};
+	static const t_unicode lower[] = {'c', 0xE9, 0x3B4, 0x436, 0x451, 0};
+	static const t_unicode mixed[] = {'a', 'B', 0};
+	static const t_unicode times[] = {0xD7, 0};
+	static const t_unicode divide[] = {0xF7, 0};
+	unsigned char encoded [4];
+	t_unicode back [8];
+	char out [16];
+	unsigned unitsUsed;
+	int i;
+	
+	/* ASCII */
+	assert (utf8ToUnicode (back, 7, "Ch 1", 4) == 4);
+	assert (back[0] == 'C' && back[3] == '1' && back[4] == 0);
+	assert (unicodeToUtf8 (out, sizeof (out), back) == 4);
+	assert (strcmp (out, "Ch 1") == 0);
+	
+	/* 2, 3 and 4 octet sequences, the last one from a surrogate pair */
+	assert (unicodeCharToUtf8 (txt+1, &unitsUsed, encoded) == 2 && unitsUsed == 1);
+	assert (unicodeCharToUtf8 (txt+2, &unitsUsed, encoded) == 3 && unitsUsed == 1);
+	assert (unicodeCharToUtf8 (txt+3, &unitsUsed, encoded) == 4 && unitsUsed == 2);
+	assert (memcmp (encoded, utf8+6, 4) == 0);
+	assert (unicodeUtf8Length (txt) == 10);
+	assert (unicodeToUtf8 (out, sizeof (out), txt) == 10);
+	assert (strcmp (out, utf8) == 0);
+	assert (utf8ToUnicode (back, 7, utf8, 10) == 5);
+	for (i=0; i<6; i++) {
+		assert (back[i] == txt[i]);
+	}
+	
+	/* Unpaired surrogates survive a round trip */
+	assert (unicodeToUtf8 (out, sizeof (out), unpaired) == 7);
+	assert (utf8ToUnicode (back, 7, out, 7) == 3);
+	for (i=0; i<4; i++) {
+		assert (back[i] == unpaired[i]);
+	}
+	
+	/* Invalid, overlong and truncated sequences are taken as ISO-8859-1 */
+	assert (utf8ToUnicode (back, 7, "\xE9t\xE9", 3) == 3);
+	assert (back[0] == 0xE9 && back[1] == 't' && back[2] == 0xE9);
+	assert (utf8ToUnicode (back, 7, "\xC0\xAF", 2) == 2);
+	assert (back[0] == 0xC0 && back[1] == 0xAF);
+	assert (utf8ToUnicode (back, 7, "\xE0\x80\xAF", 3) == 3);
+	assert (back[0] == 0xE0 && back[1] == 0x80 && back[2] == 0xAF);
+	assert (utf8ToUnicode (back, 7, "\xC3", 1) == 1);
+	assert (back[0] == 0xC3 && back[1] == 0);
+	
+	/* A short target keeps what fits, never half a pair, and the */
+	/* whole length is returned */
+	assert (utf8ToUnicode (back, 3, utf8, 10) == 5);
+	assert (back[0] == 0x41 && back[1] == 0xE9 && back[2] == 0x20AC && back[3] == 0);
+	assert (utf8ToUnicode (back, 4, utf8, 10) == 5);
+	assert (back[2] == 0x20AC && back[3] == 0);
+	assert (unicodeToUtf8 (out, 6, txt) == 3);
+	assert (strcmp (out, "A\xC3\xA9") == 0);
+	
+	/* Names differing in case have the same CRC, also if not ASCII */
+	assert (crc32_AddUnicodeLowerCase (0, upper) == crc32_AddUnicodeLowerCase (0, lower));
+	assert (crc32_AddUnicodeLowerCase (0, mixed) == crc32_AddAsciizLowerCase (0, "ab"));
+	assert (crc32_AddUtf8LowerCase (0, "C\xC3\x89\xCE\x94\xD0\x96\xD0\x81") == crc32_AddUnicodeLowerCase (0, lower));
+	assert (crc32_AddUnicodeLowerCase (0, times) != crc32_AddUnicodeLowerCase (0, divide));
+}
+
 void runBinlibTest ()
 {
 	testLittleEndian ();
 	testBCD ();
 	testRevBCD ();
 	testUnicode ();
+	testUtf8 ();
 }
 
 #endif
 
+int binCountAllocs = 0;
+unsigned long binNoOfAllocs = 0;
+
 #ifdef ED_DEBUG_ALLOC
 #include <stdlib.h>
 #include <stdio.h>
@@ -521,26 +790,35 @@ TEDMemHeader* ED_MemoryRoot = NULL;
 #define ED_SIGNATURE_HEADER 0x12345678
 #define ED_SIGNATURE_FOOTER 0xADACADAB
 
+/* Checks the guards of a single block */
+static void EDDebugCheckBlock (const TEDMemHeader* hdr)
+{
+	const TEDMemFooter* footer =(const TEDMemFooter*)(((const char*)hdr)+(sizeof (TEDMemHeader)+hdr->Size));
+	
+	assert (hdr->Signature == ED_SIGNATURE_HEADER);
+	assert (footer->Signature == ED_SIGNATURE_FOOTER);
+	assert (hdr->Size == footer->Size);
+	assert (hdr->AllocationId == footer->AllocationId);
+	assert (*(hdr->PrevHeaderPointer) == hdr);
+	NOWARN_UNUSED (footer);
+}
+
+/* Checks all the live blocks: not done on each call, that would be quadratic */
 void EDDebugCheckMemory ()
 {
 	const TEDMemHeader* hdr;
 	
 	for (hdr = ED_MemoryRoot; hdr != NULL; hdr = hdr->NextHeader) {
-		TEDMemFooter* footer =(TEDMemFooter*)(((char*)hdr)+(sizeof (TEDMemHeader)+hdr->Size));
-		
-		assert (hdr->Signature == ED_SIGNATURE_HEADER);
-		assert (footer->Signature == ED_SIGNATURE_FOOTER);
-		assert (hdr->Size == footer->Size);
-		assert (hdr->AllocationId == footer->AllocationId);
-		assert (*(hdr->PrevHeaderPointer) == hdr);
+		EDDebugCheckBlock (hdr);
 	}
 }
-#define ED_TRACE_ALLOCS
+
 void* EDDebugAlloc (size_t size)
 {
 	TEDMemHeader* ret;
 	TEDMemFooter* footer;
 	assert (size > 0);
+	if (binCountAllocs) binNoOfAllocs++;
 	ED_MemAllocated += size;
 	if (ED_MemAllocated > ED_MaxMemAllocated) ED_MaxMemAllocated = ED_MemAllocated;
 	ret = (TEDMemHeader*)malloc (sizeof (TEDMemHeader)+size+sizeof (TEDMemFooter));
@@ -578,21 +856,14 @@ void* EDDebugAlloc (size_t size)
 		}
 	}
 #endif
-	EDDebugCheckMemory ();
 	return (ret+1);
 }
 
 void EDDebugFree (void* ptr)
 {
 	TEDMemHeader* sptr = ((TEDMemHeader*)ptr)-1;
-	TEDMemFooter* footer =(TEDMemFooter*)(((char*)sptr)+(sizeof (TEDMemHeader)+sptr->Size));
 
-	EDDebugCheckMemory ();
-	
-	assert (sptr->Signature == ED_SIGNATURE_HEADER);
-	assert (footer->Signature == ED_SIGNATURE_FOOTER);
-	assert (sptr->Size == footer->Size);
-	assert (sptr->AllocationId == footer->AllocationId);
+	EDDebugCheckBlock (sptr);
 	memset (ptr, 0xCD, sptr->Size);
 	
 	(*sptr->PrevHeaderPointer) = sptr->NextHeader;
@@ -611,7 +882,6 @@ void EDDebugFree (void* ptr)
 		fclose (f);
 	}
 #endif
-	EDDebugCheckMemory ();
 	free (sptr);
 }
 
@@ -621,3 +891,144 @@ int EDDebugPrintSummary ()
 	return (ED_MemAllocated != 0);
 }
 #endif
+
+#ifdef ED_PROFILE_ALLOC
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* Call sites are kept in an open addressing table; the ones not fitting */
+/* are summed in the last entry */
+#define ED_PROFILE_SITES    1024
+#define ED_PROFILE_BUCKETS  32
+
+typedef struct {
+	const char* File;
+	unsigned Line;
+	unsigned long Calls;
+	unsigned long Frees;
+	size_t Bytes;
+	size_t LiveBytes;
+	size_t PeakLiveBytes;
+} TEDProfileSite;
+
+/* Precedes each block; the union keeps the block aligned as malloc does */
+typedef union {
+	struct {
+		size_t Size;
+		TEDProfileSite* Site;
+	} h;
+	long double Align;
+} TEDProfileHeader;
+
+static TEDProfileSite ED_ProfileSites [ED_PROFILE_SITES+1];
+static unsigned long ED_ProfileHistogram [ED_PROFILE_BUCKETS];
+static unsigned long ED_ProfileAllocs = 0;
+static unsigned long ED_ProfileFrees = 0;
+static size_t ED_ProfileBytes = 0;
+static size_t ED_ProfileLiveBytes = 0;
+static size_t ED_ProfilePeakLiveBytes = 0;
+static int ED_ProfileStarted = 0;
+
+static TEDProfileSite* EDProfileFindSite (const char* file, unsigned line)
+{
+	unsigned hash = (unsigned)(((size_t)file >> 3)*31u+line)*2654435761u;
+	unsigned i, n;
+	for (i=hash & (ED_PROFILE_SITES-1), n=0; n<ED_PROFILE_SITES; i=(i+1) & (ED_PROFILE_SITES-1), n++) {
+		TEDProfileSite* site = ED_ProfileSites+i;
+		if (site->File == file && site->Line == line) return site;
+		if (site->File == NULL) {
+			site->File = file;
+			site->Line = line;
+			return site;
+		}
+	}
+	ED_ProfileSites[ED_PROFILE_SITES].File = "(other sites)";
+	return ED_ProfileSites+ED_PROFILE_SITES;
+}
+
+void* EDProfileAlloc (size_t size, const char* file, unsigned line)
+{
+	TEDProfileHeader* hdr;
+	TEDProfileSite* site;
+	unsigned bucket;
+	
+	if (!ED_ProfileStarted) {
+		ED_ProfileStarted = 1;
+		atexit (EDProfilePrintSummary);
+	}
+	if (binCountAllocs) binNoOfAllocs++;
+	hdr = (TEDProfileHeader*)malloc (sizeof (TEDProfileHeader)+size);
+	if (hdr == NULL) return NULL;
+	
+	site = EDProfileFindSite (file, line);
+	hdr->h.Size = size;
+	hdr->h.Site = site;
+	site->Calls++;
+	site->Bytes += size;
+	site->LiveBytes += size;
+	if (site->LiveBytes > site->PeakLiveBytes) site->PeakLiveBytes = site->LiveBytes;
+	
+	ED_ProfileAllocs++;
+	ED_ProfileBytes += size;
+	ED_ProfileLiveBytes += size;
+	if (ED_ProfileLiveBytes > ED_ProfilePeakLiveBytes) ED_ProfilePeakLiveBytes = ED_ProfileLiveBytes;
+	
+	/* Bucket n holds the sizes from 2^(n-1)+1 to 2^n */
+	for (bucket=0; bucket+1<ED_PROFILE_BUCKETS && ((size_t)1 << bucket) < size; bucket++);
+	ED_ProfileHistogram[bucket]++;
+	return (hdr+1);
+}
+
+void EDProfileFree (void* ptr)
+{
+	TEDProfileHeader* hdr;
+	if (ptr == NULL) return;
+	hdr = ((TEDProfileHeader*)ptr)-1;
+	assert (hdr->h.Site->LiveBytes >= hdr->h.Size);
+	hdr->h.Site->LiveBytes -= hdr->h.Size;
+	hdr->h.Site->Frees++;
+	ED_ProfileLiveBytes -= hdr->h.Size;
+	ED_ProfileFrees++;
+	free (hdr);
+}
+
+static int EDProfileCompareSites (const void* a, const void* b)
+{
+	const TEDProfileSite* sa = *(const TEDProfileSite* const*)a;
+	const TEDProfileSite* sb = *(const TEDProfileSite* const*)b;
+	if (sa->Bytes != sb->Bytes) return (sa->Bytes < sb->Bytes ? 1 : -1);
+	return (sa->Calls < sb->Calls ? 1 : (sa->Calls > sb->Calls ? -1 : 0));
+}
+
+void EDProfilePrintSummary (void)
+{
+	static TEDProfileSite* sorted [ED_PROFILE_SITES+1];
+	unsigned noOfSites = 0;
+	unsigned i;
+	
+	for (i=0; i<=ED_PROFILE_SITES; i++) {
+		if (ED_ProfileSites[i].Calls) sorted[noOfSites++] = ED_ProfileSites+i;
+	}
+	qsort (sorted, noOfSites, sizeof (sorted[0]), EDProfileCompareSites);
+	
+	fprintf (stderr, "Allocation profile: %lu allocation(s), %lu free(s), %lu bytes, peak live %lu bytes, leaked %lu bytes\n",
+		ED_ProfileAllocs, ED_ProfileFrees, (unsigned long)ED_ProfileBytes, (unsigned long)ED_ProfilePeakLiveBytes, (unsigned long)ED_ProfileLiveBytes);
+	fprintf (stderr, "%10s %12s %12s %12s %10s  %s\n", "Calls", "Bytes", "Peak live", "Leaked", "Blocks", "Site");
+	for (i=0; i<noOfSites; i++) {
+		const TEDProfileSite* site = sorted[i];
+		fprintf (stderr, "%10lu %12lu %12lu %12lu %10lu  %s:%u\n", site->Calls, (unsigned long)site->Bytes, (unsigned long)site->PeakLiveBytes,
+			(unsigned long)site->LiveBytes, site->Calls-site->Frees, site->File, site->Line);
+	}
+	fprintf (stderr, "%10s %10s\n", "Size <=", "Calls");
+	for (i=0; i<ED_PROFILE_BUCKETS; i++) {
+		if (ED_ProfileHistogram[i] == 0) continue;
+		if (i+1 < ED_PROFILE_BUCKETS) {
+			fprintf (stderr, "%10lu %10lu\n", 1ul << i, ED_ProfileHistogram[i]);
+		}
+		else {
+			fprintf (stderr, "%10s %10lu\n", "larger", ED_ProfileHistogram[i]);
+		}
+	}
+}
+#endif
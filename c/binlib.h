@@ -23,15 +23,17 @@
 	extern "C" {
 #endif
 
-#define BL_TEXT_SAMPLE_LEN 17
-
 typedef unsigned char t_buffer;
 typedef unsigned short t_unicode;
 typedef unsigned long t_numeric;
+
+/* Storage types of the numeric fields in the T_xxx structures, chosen by bit width */
+typedef unsigned char t_numeric8;
+typedef unsigned short t_numeric16;
+typedef unsigned int t_numeric32;
+
+/* Members ordered by size so that the structure has no padding holes */
 typedef struct {
-	/* Set if resolved */
-	unsigned refLineNo;
-	
 	/* Reference to the key UNICODE string within the T_xxx structure */
 	/* NULL if the reference is to a numeric field */
 	const t_unicode* resolvedName;
@@ -40,26 +42,50 @@ typedef struct {
 	/* Otherwise, it contains the value of the key itself if numeric */
 	unsigned refId;
 	
-	/* Sample of the text in the CSV file, used to report errors. Used if key is UNICODE */
-	char textSample [BL_TEXT_SAMPLE_LEN+1];
+	/* Set if resolved (record numbers are 16 bits in the binary file) */
+	unsigned short refLineNo;
+	
+	/* Line of the CSV file a UNICODE key was read from, to report it if not found; */
+	/* 0 if not read from a CSV file */
+	unsigned short csvLineNo;
 } t_reference;
 
 #define NOWARN_UNUSED(a) ((void)(a))
 
 #define INVALID_BCD     0
 
+/* Number of binAlloc calls, counted only while binCountAllocs is set */
+extern int binCountAllocs;
+extern unsigned long binNoOfAllocs;
+
+/*------------------------------------------------------------------------------
+	Allocators, chosen at build time:
+	
+	ED_DEBUG_ALLOC    guards every block and keeps the list of the live ones,
+	                  checked by EDDebugCheckMemory; define ED_TRACE_ALLOCS
+	                  too to log each call to memory.log
+	ED_PROFILE_ALLOC  counts the allocations of each call site (binAlloc is
+	                  tagged with __FILE__ and __LINE__), the live and peak
+	                  memory and the sizes, and prints them to stderr at exit;
+	                  built with "make PROFILE_ALLOC=1"
+	otherwise         malloc and free
+------------------------------------------------------------------------------*/
 #ifndef binAlloc
 #ifdef ED_DEBUG_ALLOC
 #define binAlloc EDDebugAlloc
+#elif defined(ED_PROFILE_ALLOC)
+#define binAlloc(size) EDProfileAlloc ((size), __FILE__, __LINE__)
 #else
 #include <stdlib.h>
-#define binAlloc malloc
+#define binAlloc(size) ((binCountAllocs ? (void)binNoOfAllocs++ : (void)0), malloc (size))
 #endif
 #endif
 
 #ifndef binFree
 #ifdef ED_DEBUG_ALLOC
 #define binFree EDDebugFree
+#elif defined(ED_PROFILE_ALLOC)
+#define binFree EDProfileFree
 #else
 #include <stdlib.h>
 #define binFree free
@@ -71,6 +97,11 @@ void  EDDebugFree (void* ptr);
 int EDDebugPrintSummary ();
 void EDDebugCheckMemory();
 #endif
+#ifdef ED_PROFILE_ALLOC
+void* EDProfileAlloc (size_t size, const char* file, unsigned line);
+void  EDProfileFree (void* ptr);
+void  EDProfilePrintSummary (void);
+#endif
 typedef enum {
 	BL_integer,
 	BL_unicode
@@ -189,12 +220,14 @@ extern t_numeric BCDToNumericForTones (const void* source, unsigned sourceOffset
 extern void numericToBCDForTones (void* destination, unsigned destOffset, t_numeric source);
 
 /*------------------------------------------------------------------------------
-	Reads from binary mode an unicode string
+	Reads from binary mode an unicode string (UTF-16LE). The string is
+	transferred as a block, with no per character conversion.
 ------------------------------------------------------------------------------*/
 extern void binaryToUnicode (const void* source, unsigned sourceOffset, t_unicode* target, unsigned bitLen);
 
 /*------------------------------------------------------------------------------
-	Writes in binary mode an unicode string
+	Writes in binary mode an unicode string (UTF-16LE). The string is
+	transferred as a block, with no per character conversion.
 ------------------------------------------------------------------------------*/
 extern void unicodeToBinary (void* destination, unsigned destOffset, const t_unicode* source, unsigned bitLen);
 
@@ -208,6 +241,41 @@ extern void asciiBinaryToUnicode (const void* source, unsigned sourceOffset, t_u
 ------------------------------------------------------------------------------*/
 extern void unicodeToAsciiBinary (void* destination, unsigned destOffset, const t_unicode* source, unsigned bitLen);
 
+/*------------------------------------------------------------------------------
+	Repeats the first 'length' octets of 'buffer' so that 'buffer' holds
+	'count' consecutive copies of them. Used to fill empty records in bulk.
+------------------------------------------------------------------------------*/
+extern void binReplicate (t_buffer* buffer, unsigned length, unsigned count);
+
+/*------------------------------------------------------------------------------
+	Encodes the character at 'source' as UTF-8 into 'target' (up to 4 octets);
+	a surrogate pair is encoded as one character. Returns the number of octets
+	written and sets 'unitsUsed' to the number of t_unicode consumed.
+------------------------------------------------------------------------------*/
+extern unsigned unicodeCharToUtf8 (const t_unicode* source, unsigned* unitsUsed, unsigned char* target);
+
+/*------------------------------------------------------------------------------
+	Returns the number of octets of the UTF-8 form of 'source'
+------------------------------------------------------------------------------*/
+extern unsigned unicodeUtf8Length (const t_unicode* source);
+
+/*------------------------------------------------------------------------------
+	Converts the zero terminated 'source' into a zero terminated UTF-8 string.
+	No more than 'targetSize' octets, terminator included, are written and the
+	characters are never split. Returns the length of the result.
+------------------------------------------------------------------------------*/
+extern unsigned unicodeToUtf8 (char* target, unsigned targetSize, const t_unicode* source);
+
+/*------------------------------------------------------------------------------
+	Converts 'sourceLen' octets of UTF-8 into a zero terminated unicode string.
+	Octets not forming a valid UTF-8 sequence are taken as ISO-8859-1, as the
+	CSV files were written by the previous versions.
+	No more than 'targetChars' characters plus the terminator are written; the
+	return value is the number of characters of the whole conversion, so that
+	the caller can detect if it did not fit.
+------------------------------------------------------------------------------*/
+extern unsigned utf8ToUnicode (t_unicode* target, unsigned targetChars, const char* source, unsigned sourceLen);
+
 
 #ifndef NDEBUG
 extern void runBinlibTest ();
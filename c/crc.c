@@ -16,6 +16,7 @@
 	ENHANCEMENTS, OR MODIFICATIONS.
 *******************************************************************************/
 #include "crc.h"
+#include <string.h>
 
 unsigned TPCCrc32Table [] = {
 	0x00000000UL, 0x77073096UL, 0xee0e612cUL, 0x990951baUL, 0x076dc419UL,
@@ -99,17 +100,69 @@ unsigned crc32_AddAsciizLowerCase (unsigned base, const char* string)
 	return base;
 }
 
+/*--------------------------------------------------------------------------
+	Lower case of the ASCII, Latin-1, Greek and Cyrillic capital letters
+--------------------------------------------------------------------------*/
+t_unicode crc32_UnicodeLowerCase (t_unicode c)
+{
+	if (c >= 'A' && c <= 'Z') return c - 'A' + 'a';
+	if (c >= 0xC0 && c <= 0xDE && c != 0xD7) return c + 0x20;
+	if (c >= 0x391 && c <= 0x3AB && c != 0x3A2) return c + 0x20;
+	if (c >= 0x400 && c <= 0x40F) return c + 0x50;
+	if (c >= 0x410 && c <= 0x42F) return c + 0x20;
+	return c;
+}
+
 /*--------------------------------------------------------------------------
 	Add an UNICODE string to the CRC. The string is considered lowercase.
+	The CRC is calculated on the UTF-8 form of the string, so that ASCII
+	names have the same CRC of crc32_AddAsciizLowerCase.
 --------------------------------------------------------------------------*/
 unsigned crc32_AddUnicodeLowerCase (unsigned base, const t_unicode* string)
 {
+	unsigned char encoded [4];
+	t_unicode lower [2];
+	unsigned unitsUsed;
 	unsigned i;
+	unsigned n;
 	char c;
-	for (i=0; string[i]; i++) {
-		c = (char)((unsigned char)(string [i]));
-		if (c >= 'A' && c <= 'Z') {c = c - 'A' + 'a';}
-		base = crc32_Add (base, c);
+	while (string[0]) {
+		if (string[0] < 0x80) {
+			c = (char)string[0];
+			if (c >= 'A' && c <= 'Z') {c = c - 'A' + 'a';}
+			base = crc32_Add (base, c);
+			string++;
+		}
+		else {
+			lower[0] = crc32_UnicodeLowerCase (string[0]);
+			lower[1] = string[1];
+			n = unicodeCharToUtf8 (lower, &unitsUsed, encoded);
+			for (i=0; i<n; i++) {
+				base = crc32_Add (base, encoded[i]);
+			}
+			string += unitsUsed;
+		}
+	}
+	return base;
+}
+
+/*--------------------------------------------------------------------------
+	Add an UTF-8 string to the CRC. The string is considered lowercase.
+--------------------------------------------------------------------------*/
+unsigned crc32_AddUtf8LowerCase (unsigned base, const char* string)
+{
+	#define CRC_UTF8_MAX_CHARS 256
+	t_unicode decoded [CRC_UTF8_MAX_CHARS+1];
+	unsigned len = (unsigned)strlen (string);
+	
+	while (len > 0) {
+		/* Decode in chunks, never splitting a character */
+		unsigned chunk = (len > CRC_UTF8_MAX_CHARS/2 ? CRC_UTF8_MAX_CHARS/2 : len);
+		while (chunk < len && (((const unsigned char*)string)[chunk] & 0xC0) == 0x80) chunk++;
+		utf8ToUnicode (decoded, CRC_UTF8_MAX_CHARS, string, chunk);
+		base = crc32_AddUnicodeLowerCase (base, decoded);
+		string += chunk;
+		len -= chunk;
 	}
 	return base;
 }
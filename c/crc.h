@@ -41,10 +41,23 @@ unsigned crc32_AddAsciiz (unsigned base, const char* string);
 unsigned crc32_AddAsciizLowerCase (unsigned base, const char* string);
 
 /*--------------------------------------------------------------------------
-	Add an UNICODE string to the CRC. The string is considered lowercase.
+	Lower case of a character, as folded by crc32_AddUnicodeLowerCase:
+	ASCII, Latin-1, Greek and Cyrillic capital letters.
+--------------------------------------------------------------------------*/
+t_unicode crc32_UnicodeLowerCase (t_unicode c);
+
+/*--------------------------------------------------------------------------
+	Add an UNICODE string to the CRC. The string is considered lowercase;
+	besides ASCII, Latin-1, Greek and Cyrillic letters are folded.
 --------------------------------------------------------------------------*/
 unsigned crc32_AddUnicodeLowerCase (unsigned base, const t_unicode* string);
 
+/*--------------------------------------------------------------------------
+	Add an UTF-8 string to the CRC. The string is considered lowercase.
+	It returns the same CRC of crc32_AddUnicodeLowerCase on the same text.
+--------------------------------------------------------------------------*/
+unsigned crc32_AddUtf8LowerCase (unsigned base, const char* string);
+
 #ifdef  __cplusplus
 }
 #endif
@@ -20,6 +20,9 @@
 #include <string.h>
 #include <stdio.h>
 
+/* Strings shorter than this are converted on the stack by csvWriteTokenUnicode */
+#define CSV_UNICODE_LOCAL_SIZE 256
+
 /*=================================================================================
 	Add one character to the buffer without exceeding its size.
 =================================================================================*/
@@ -213,31 +216,25 @@ int csvWriteEndOfLine (WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncPar
 =================================================================================*/
 int csvWriteTokenUnicode (const t_unicode* unicodeString, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter)
 {
-	int i;
-	int len;
+	unsigned len;
 	int ret;
-	char* buffer;
-	
-	/* Calculate the length of the UNICODE string */
-	for (len=0; unicodeString[len]; len++);
+	char localBuffer [CSV_UNICODE_LOCAL_SIZE];
+	char* buffer = localBuffer;
 	
-	/* Allocate the buffer */
-	buffer = (char*)binAlloc(len+1);
-	if (buffer == NULL) return CSVRET_OUT_OF_MEMORY;
+	/* Calculate the length of the UTF-8 string */
+	len = unicodeUtf8Length (unicodeString);
 	
-	for (i=0; i<len; i++) {
-		if (unicodeString [i] > 0 && unicodeString [i] <= 255) {
-			buffer[i] = (char)(unsigned char)unicodeString [i];
-		}
-		else {
-			buffer[i] = '?';
-		}
+	/* Allocate the buffer if the string is too long for the local one */
+	if (len >= sizeof (localBuffer)) {
+		buffer = (char*)binAlloc(len+1);
+		if (buffer == NULL) return CSVRET_OUT_OF_MEMORY;
 	}
-	buffer[i] = '\0';
 	
-	ret = csvWriteToken (buffer, len, writeBinaryFunc, writeBinaryFuncParameter);
+	unicodeToUtf8 (buffer, len+1, unicodeString);
+	
+	ret = csvWriteToken (buffer, (int)len, writeBinaryFunc, writeBinaryFuncParameter);
 	
-	binFree (buffer);
+	if (buffer != localBuffer) binFree (buffer);
 	
 	return ret;
 }
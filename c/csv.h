@@ -148,7 +148,8 @@ extern int csvWriteToken (const char* buffer, int bufferLength, WriteBinaryFunc
 extern int csvWriteTokenUnsigned (unsigned value, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter);
 
 /*=================================================================================
-	Same as csvWriteToken, but it writes an UNICODE string zero terminated.
+	Same as csvWriteToken, but it writes an UNICODE string zero terminated,
+	encoded as UTF-8.
 	Returns the same values of csvWriteToken, plus CSVRET_OUT_OF_MEMORY.
 =================================================================================*/
 extern int csvWriteTokenUnicode (const t_unicode* unicodeString, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter);
@@ -199,7 +199,7 @@ extern unsigned FIND_LookupTableId (const LookupTable* tab, unsigned keyCrc, con
 /* Find an entry in the lookup table. Returns 0 if not found, >=1 (the line number) if found */
 unsigned FIND_LookupTableAsciiz (const LookupTable* tab, const char* key)
 {
-	return FIND_LookupTableId (tab, crc32_AddAsciizLowerCase (0, key), NULL);
+	return FIND_LookupTableId (tab, crc32_AddUtf8LowerCase (0, key), NULL);
 }
 
 #ifndef NDEBUG
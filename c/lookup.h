@@ -65,7 +65,7 @@ extern int ADD_LookupTableNumeric (LookupTable* tab, t_numeric key, unsigned lin
 /* Find an entry in the lookup table. Returns 0 if not found, >=1 (the line number) if found */
 extern unsigned FIND_LookupTableId (const LookupTable* tab, unsigned keyCrc, const t_unicode** keyTextPtr);
 
-/* Find an entry in the lookup table. Returns 0 if not found, >=1 (the line number) if found */
+/* Find an entry in the lookup table by its UTF-8 key. Returns 0 if not found, >=1 (the line number) if found */
 extern unsigned FIND_LookupTableAsciiz (const LookupTable* tab, const char* key);
 
 #ifndef NDEBUG
@@ -32,35 +32,66 @@
 #include "md380_valid.h"
 #include "md380_tables.h"
 #include "md380_resolve.h"
+#include "md380_overlay.h"
+#include "md380_bundle.h"
+#include "md380_columnar.h"
+#include "md380_field.h"
+#include "md380_changes.h"
+#include "md380_refindex.h"
+#include "md380_reorder.h"
+#include "md380_rules.h"
+#include "md380_lib.h"
+#include "md380_server.h"
+#include "md380_stdio.h"
+#include "md380_snapshot.h"
+#include "md380_stamp.h"
+#include "md380_stats.h"
+#include "md380_arena.h"
+#include "md380_aio.h"
 
 /*============================================================================
 	LOAD A .RDT FILE
+	
+	The image is read into 'rdtBinFile', FILE_SIZE_TRDTFile octets.
+	Only the regions of the record types selected by tableMask (TABLE_xxx
+	bits) are read; the rest of the image is left zeroed.
+	The standard input ("-") is always read whole, and so is an image
+	read ahead by 'aio' (NULL if none).
+	Returns 0=ok  non-zero=error
 ============================================================================*/
-t_buffer* loadRdtFile (const char* fileName, unsigned* offset, unsigned* length)
+int loadRdtFile (const char* fileName, MD380_Aio* aio, t_buffer* rdtBinFile, unsigned tableMask, unsigned* offset, unsigned* length)
 {
-	t_buffer* rdtBinFile = NULL;
 	struct stat st;
 	size_t readSize;
 	FILE* f = NULL;
 	(*offset) = 0;
 	(*length) = FILE_SIZE_TRDTFile;
 
+	if (md380_IsStdioName (fileName)) {
+		char* errorMessage = NULL;
+		if (md380_ReadImageStream (stdin, rdtBinFile, offset, length, &errorMessage) != CSVRET_OK) {
+			if (errorMessage) {
+				fprintf (stderr, "ERROR: %s\n", errorMessage);
+				binFree (errorMessage);
+			}
+			goto errorExit;
+		}
+		return 0;
+	}
+	if (aio && md380_AioTakeImage (aio, fileName, rdtBinFile, offset, length) == CSVRET_OK) {
+		return 0;
+	}
+
 	if (stat (fileName, &st)) {
 		fprintf (stderr, "Error opening file (stat) '%s': %s\n", fileName, strerror(errno));
 		goto errorExit;
 	}
 
 	/* Size must be exact */
-	if (st.st_size != FILE_SIZE_TRDTFile) {
-		if (st.st_size != FILE_SIZE_TBINFile) {
-			fprintf (stderr, "Error in file '%s': size %u does not match expected size of %u (.rdt) or %u octets (.bin/.img)\n", fileName, (unsigned)st.st_size, FILE_SIZE_TRDTFile, FILE_SIZE_TBINFile);
+	if (md380_ImageLayout ((unsigned)st.st_size, offset, length) != CSVRET_OK) {
+		fprintf (stderr, "Error in file '%s': size %u does not match expected size of %u (.rdt) or %u octets (.bin/.img)\n", fileName, (unsigned)st.st_size, FILE_SIZE_TRDTFile, FILE_SIZE_TBINFile);
 		goto errorExit;
 	}
-		else {
-			(*offset) = FILE_OFST_TBINFile;
-			(*length) = FILE_SIZE_TBINFile;
-		}
-	}
 
 	f = fopen (fileName, "rb");
 	if (f == NULL) {
@@ -68,33 +99,69 @@ t_buffer* loadRdtFile (const char* fileName, unsigned* offset, unsigned* length)
 		goto errorExit;
 	}
 
-rdtBinFile = (t_buffer*)malloc (FILE_SIZE_TRDTFile);
-	rdtBinFile = binAlloc (FILE_SIZE_TRDTFile);
-	if (rdtBinFile == NULL) {
-		fprintf (stderr, "Error allocating %u octets for .RDT file (out of memory?)\n", FILE_SIZE_TRDTFile);
-		goto errorExit;
-	}
 	memset (rdtBinFile, 0, FILE_SIZE_TRDTFile);
 
-	readSize = fread (rdtBinFile+(*offset), 1, (*length), f);
-	if (readSize != (*length)) {
-		fprintf (stderr, "Error reading file '%s': expected %u bytes, got %u bytes\n", fileName, (unsigned)(*length), (unsigned)readSize);
-		goto errorExit;
+	if (tableMask == TABLES_ALL_TRDTFile) {
+		readSize = fread (rdtBinFile+(*offset), 1, (*length), f);
+		MD380_STATS_ADD (bytesRead, readSize);
+		if (readSize != (*length)) {
+			fprintf (stderr, "Error reading file '%s': expected %u bytes, got %u bytes\n", fileName, (unsigned)(*length), (unsigned)readSize);
+			goto errorExit;
+		}
+	}
+	else {
+		unsigned i;
+		for (i=0; i<NO_OF_RECORDS_TRDTFile; i++) {
+			const RecordDescriptor* rd = RECORDS_TRDTFile+i;
+			if ((tableMask & (1u << i)) == 0) continue;
+			assert (rd->binaryOffset >= (*offset));
+			assert (rd->binaryOffset+rd->binaryLength <= FILE_SIZE_TRDTFile);
+			if (fseek (f, rd->binaryOffset-(*offset), SEEK_SET)) {
+				fprintf (stderr, "Error reading file '%s': %s\n", fileName, strerror(errno));
+				goto errorExit;
+			}
+			readSize = fread (rdtBinFile+rd->binaryOffset, 1, rd->binaryLength, f);
+			MD380_STATS_ADD (bytesRead, readSize);
+			if (readSize != rd->binaryLength) {
+				fprintf (stderr, "Error reading file '%s': expected %u bytes at %u, got %u bytes\n", fileName, rd->binaryLength, rd->binaryOffset-(*offset), (unsigned)readSize);
+				goto errorExit;
+			}
+		}
 	}
 		
 	if (f) fclose (f);
-	return rdtBinFile;
+	return 0;
 
 errorExit:
 	if (f) fclose (f);
-	if (rdtBinFile) binFree (rdtBinFile);
-	return NULL;
+	return 1;
 }
 
 #define CLI_SC  0x1F7D1676  /* -sc  */
 #define CLI_TAB 0xFFBE32E1  /* -tab */
 #define CLI_U   0x419CCDA3  /* -u   */
 #define CLI_E   0x5C2BDDC7  /* -e   */
+#define CLI_G   0xB225BCEB  /* -g   */
+#define CLI_BUNDLE 0x27BF147C  /* -bundle */
+#define CLI_COL 0x9FEC879D  /* -col */
+#define CLI_GET 0x71665F9D  /* -get */
+#define CLI_SET 0x6A495431  /* -set */
+#define CLI_RENAME 0x5B5972CF  /* -rename */
+#define CLI_DELETE 0xB8D65A06  /* -delete */
+#define CLI_SORT 0x8F133196  /* -sort */
+#define CLI_CHECK 0xF05CEC45  /* -check */
+#define CLI_SERVER 0xD8A9F377  /* -server */
+#define CLI_WORKERS 0x22100A50  /* -workers */
+#define CLI_CACHE 0x8D952BB1  /* -cache */
+#define CLI_STAMP 0x999CDF5E  /* -stamp */
+#define CLI_JOBS 0x76A4AE71  /* -jobs */
+#define CLI_FORCE 0x5BBAC37E  /* -force */
+#define CLI_FORCE2 0xD97EE5FF  /* --force */
+#define CLI_STATS 0x9B9527FC  /* -stats */
+#define CLI_STATS2 0x1951017D  /* --stats */
+#define CLI_AIO 0x533BA5CF  /* -aio */
+#define CLI_MAXLIST 0x82B6D53E  /* -maxlist */
+#define CLI_EXITCODE 0xA7C3B6D0  /* -exitcode */
 #define CLI_QM  0xD795652D  /* -?   */
 #define CLI_H   0x229AA17A  /* -h   */
 
@@ -104,12 +171,64 @@ errorExit:
 void showCommandHelp ()
 {
 	int i;
-	printf ("USAGE: rdt2csv [-e|-u] <file.rdt/.img/.bin> [-sc|-tab] <csv-files>\n");
+	printf ("USAGE: rdt2csv [-e|-u] <file.rdt/.img/.bin> [-sc|-tab] [-bundle <file>] [-col <file>] [-cache <dir>]\n");
+	printf ("               [-stamp <file> [-force]] <csv-files>\n");
+	printf ("       rdt2csv -g <template.rdt/.img/.bin> <overlay.csv> [-sc|-tab]\n");
+	printf ("       rdt2csv -get <file.rdt/.img/.bin> <table> <line> <field>\n");
+	printf ("       rdt2csv -set <file.rdt/.img/.bin> <table> <line> <field> <value>\n");
+	printf ("       rdt2csv -rename <file.rdt/.img/.bin> <table> <line> <name>\n");
+	printf ("       rdt2csv -delete <file.rdt/.img/.bin> <table> <line>\n");
+	printf ("       rdt2csv -sort <file.rdt/.img/.bin> <table> <field>\n");
+	printf ("       rdt2csv -check <file.rdt/.img/.bin> [-cache <dir>] [-maxlist <list> <n>]\n");
+	printf ("       rdt2csv -server <socket> [-workers <n>]\n");
+	printf ("       rdt2csv -jobs <file> [-stamp <file> [-force]] [-aio <backend>] [-sc|-tab]\n");
 	printf ("\n");
 	printf ("    -e      export .rdt file to listed .csv files\n");
 	printf ("    -u      update .rdt file from listed .csv files\n");
+	printf ("    -g      generate one file per line of the overlay .csv file; the\n");
+	printf ("            overlay has a %s column and any GeneralSettings column\n", MD380_OVERLAY_FILENAME_FIELD);
 	printf ("    -sc     use semicolon (;) as CSV separator instead of comma\n");
 	printf ("    -tab    use tab as CSV separator instead of comma\n");
+	printf ("    -bundle single file holding all the tables; with -u, the listed\n");
+	printf ("            .csv files override the tables of the bundle\n");
+	printf ("    -col    with -e, also export all the tables to a binary columnar\n");
+	printf ("            file (see md380_colreader.h)\n");
+	printf ("    -cache  with -e and -check, keep in <dir> the decoded images and\n");
+	printf ("            reuse them when the same image comes again\n");
+	printf ("    -stamp  with -e and -u, skip the job if its files did not change\n");
+	printf ("            since the run recorded in <file> (see md380_stamp.h)\n");
+	printf ("    -force  with -stamp, run the jobs anyway and record them again\n");
+	printf ("    -exitcode with -u, -rename, -delete and -sort, exit with status 0\n");
+	printf ("            only if the file was changed: %d if not changed, 1 if\n", MAIN_NOT_CHANGED);
+	printf ("            not saved due to rules violations\n");
+	printf ("    -stats  print the time of each phase and some counters at the end\n");
+	printf ("            (also --stats; not with -server)\n");
+	printf ("    -jobs   run the jobs of <file>, a .csv file holding the command\n");
+	printf ("            line of one -e or -u job per line\n");
+	printf ("    -aio    with -jobs, how the images are read ahead and the .csv\n");
+	printf ("            files written while converting: auto (default), uring,\n");
+	printf ("            threads or off (see md380_aio.h)\n");
+	printf ("    -get    print a single field of the file\n");
+	printf ("    -set    change a single field of the file in place, without any\n");
+	printf ("            validation; <table> is a record type or a <csv-files>\n");
+	printf ("            option without dash, <line> starts from 1, references\n");
+	printf ("            are given as line numbers\n");
+	printf ("    -rename change the name (or the id for contacts) of a record and\n");
+	printf ("            all the references to it\n");
+	printf ("    -delete remove a record, clearing the references to it and\n");
+	printf ("            renumbering the following ones\n");
+	printf ("    -sort   sort the records of a table by a number or name field,\n");
+	printf ("            renumbering the references to them\n");
+	printf ("    -check  report duplicate channels, empty or long lists, RX group\n");
+	printf ("            lists with non group contacts and unused records\n");
+	printf ("    -maxlist with -check, report the lists of type <list> (zone, scan\n");
+	printf ("            or rxgrp) having more than <n> members; not checked if\n");
+	printf ("            not given\n");
+	printf ("    -server serve export, update and validate jobs on a Unix domain\n");
+	printf ("            socket (see md380_server.h) until SIGINT or SIGTERM\n");
+	printf ("    -workers number of jobs served at the same time (default %d)\n", MD380_SERVER_DEFAULT_WORKERS);
+	printf ("    -       as .rdt or .csv file name, read from standard input or\n");
+	printf ("            write to standard output (see md380_stdio.h)\n");
 	printf ("\n<csv-files>:\n");
 	
 	for (i=0; i<NO_OF_CLI_COMMANDS; i++) {
@@ -152,11 +271,200 @@ int analyzeCommandLine (int argc, char** argv, MD380_Configuration* config)
 				}
 				break;
 			}
+			/* READ BUNDLE FILE NAME */
+			case CLI_BUNDLE: {
+				if (config->bundleFileName != NULL) {
+					fprintf (stderr, "Error in parameter %d (%s): bundle already defined in previous parameter\n", (int)PARNO, *argv);
+					return 1;
+				}
+				if (argc <= 1) {
+					fprintf (stderr, "Error in parameter %d (%s): missing bundle file name\n", (int)PARNO, *argv);
+					return 1;
+				}
+				argc--;
+				argv++;
+				config->bundleFileName = binAlloc (strlen (*argv)+1);
+				if (config->bundleFileName == NULL) {
+					fprintf (stderr, "Error in parameter %d (%s): out of memory\n", (int)PARNO, *argv);
+					return 1;
+				}
+				strcpy (config->bundleFileName, *argv);
+				break;
+			}
+			/* READ COLUMNAR FILE NAME */
+			case CLI_COL: {
+				if (config->columnarFileName != NULL) {
+					fprintf (stderr, "Error in parameter %d (%s): columnar file already defined in previous parameter\n", (int)PARNO, *argv);
+					return 1;
+				}
+				if (argc <= 1) {
+					fprintf (stderr, "Error in parameter %d (%s): missing columnar file name\n", (int)PARNO, *argv);
+					return 1;
+				}
+				argc--;
+				argv++;
+				config->columnarFileName = binAlloc (strlen (*argv)+1);
+				if (config->columnarFileName == NULL) {
+					fprintf (stderr, "Error in parameter %d (%s): out of memory\n", (int)PARNO, *argv);
+					return 1;
+				}
+				strcpy (config->columnarFileName, *argv);
+				break;
+			}
+			/* READ SERVER SOCKET NAME */
+			case CLI_SERVER: {
+				if (config->updateMode != modeUnset) {
+					fprintf (stderr, "Error in parameter %d (%s): action already defined in previous parameter\n", (int)PARNO, *argv);
+					return 1;
+				}
+				if (argc <= 1) {
+					fprintf (stderr, "Error in parameter %d (%s): missing socket name\n", (int)PARNO, *argv);
+					return 1;
+				}
+				argc--;
+				argv++;
+				config->serverSocketName = binAlloc (strlen (*argv)+1);
+				if (config->serverSocketName == NULL) {
+					fprintf (stderr, "Error in parameter %d (%s): out of memory\n", (int)PARNO, *argv);
+					return 1;
+				}
+				strcpy (config->serverSocketName, *argv);
+				config->updateMode = modeServer;
+				break;
+			}
+			/* READ NUMBER OF SERVER WORKERS */
+			case CLI_WORKERS: {
+				char* end;
+				if (argc <= 1) {
+					fprintf (stderr, "Error in parameter %d (%s): missing number of workers\n", (int)PARNO, *argv);
+					return 1;
+				}
+				argc--;
+				argv++;
+				config->serverWorkers = (unsigned)strtoul (*argv, &end, 10);
+				if (**argv < '0' || **argv > '9' || *end != 0 || config->serverWorkers == 0 || config->serverWorkers > MD380_SERVER_MAX_WORKERS) {
+					fprintf (stderr, "Error in parameter %d (%s): number of workers must be 1 to %d\n", (int)PARNO, *argv, MD380_SERVER_MAX_WORKERS);
+					return 1;
+				}
+				break;
+			}
+			/* READ LIST SIZE LIMIT */
+			case CLI_MAXLIST: {
+				unsigned* limit = NULL;
+				char* end;
+				if (argc <= 2) {
+					fprintf (stderr, "Error in parameter %d (%s): missing list type or size\n", (int)PARNO, *argv);
+					return 1;
+				}
+				argc--;
+				argv++;
+				if (strcmp (*argv, "zone") == 0) limit = &config->maxZoneChannels;
+				if (strcmp (*argv, "scan") == 0) limit = &config->maxScanChannels;
+				if (strcmp (*argv, "rxgrp") == 0) limit = &config->maxGroupContacts;
+				if (limit == NULL) {
+					fprintf (stderr, "Error in parameter %d (%s): unknown list type, use zone, scan or rxgrp\n", (int)PARNO, *argv);
+					return 1;
+				}
+				argc--;
+				argv++;
+				(*limit) = (unsigned)strtoul (*argv, &end, 10);
+				if (**argv < '0' || **argv > '9' || *end != 0) {
+					fprintf (stderr, "Error in parameter %d (%s): invalid list size\n", (int)PARNO, *argv);
+					return 1;
+				}
+				break;
+			}
+			/* READ SNAPSHOT CACHE DIRECTORY */
+			case CLI_CACHE: {
+				if (config->cacheDirName != NULL) {
+					fprintf (stderr, "Error in parameter %d (%s): cache directory already defined in previous parameter\n", (int)PARNO, *argv);
+					return 1;
+				}
+				if (argc <= 1) {
+					fprintf (stderr, "Error in parameter %d (%s): missing cache directory name\n", (int)PARNO, *argv);
+					return 1;
+				}
+				argc--;
+				argv++;
+				config->cacheDirName = binAlloc (strlen (*argv)+1);
+				if (config->cacheDirName == NULL) {
+					fprintf (stderr, "Error in parameter %d (%s): out of memory\n", (int)PARNO, *argv);
+					return 1;
+				}
+				strcpy (config->cacheDirName, *argv);
+				break;
+			}
+			/* READ STAMP AND JOBS FILE NAMES */
+			case CLI_STAMP:
+			case CLI_JOBS: {
+				char** target = (argCrc == CLI_STAMP ? &config->stampFileName : &config->jobsFileName);
+				if ((*target) != NULL) {
+					fprintf (stderr, "Error in parameter %d (%s): file already defined in previous parameter\n", (int)PARNO, *argv);
+					return 1;
+				}
+				if (argc <= 1) {
+					fprintf (stderr, "Error in parameter %d (%s): missing file name\n", (int)PARNO, *argv);
+					return 1;
+				}
+				argc--;
+				argv++;
+				(*target) = binAlloc (strlen (*argv)+1);
+				if ((*target) == NULL) {
+					fprintf (stderr, "Error in parameter %d (%s): out of memory\n", (int)PARNO, *argv);
+					return 1;
+				}
+				strcpy ((*target), *argv);
+				break;
+			}
+			/* RUN JOBS EVEN IF UP TO DATE */
+			case CLI_FORCE:
+			case CLI_FORCE2: {
+				config->forceJobs = 1;
+				break;
+			}
+			case CLI_STATS:
+			case CLI_STATS2: {
+				config->showStats = 1;
+				break;
+			}
+			case CLI_EXITCODE: {
+				config->exitIfNotChanged = 1;
+				break;
+			}
+			/* READ ASYNCHRONOUS I/O BACKEND */
+			case CLI_AIO: {
+				static const char* backendNames[] = {"auto", "uring", "threads", "off"};
+				int k;
+				if (argc <= 1) {
+					fprintf (stderr, "Error in parameter %d (%s): missing backend\n", (int)PARNO, *argv);
+					return 1;
+				}
+				argc--;
+				argv++;
+				/* In the order of MD380_AIO_xxx */
+				for (k=0; k<4; k++) {
+					if (strcmp (*argv, backendNames[k]) == 0) break;
+				}
+				if (k == 4) {
+					fprintf (stderr, "Error in parameter %d (%s): unknown backend, use auto, uring, threads or off\n", (int)PARNO, *argv);
+					return 1;
+				}
+				config->aioBackend = k;
+				break;
+			}
 			/* READ ACTION COMMAND */
 			case CLI_U:
+			case CLI_G:
+			case CLI_GET:
+			case CLI_SET:
+			case CLI_RENAME:
+			case CLI_DELETE:
+			case CLI_SORT:
+			case CLI_CHECK:
 			case CLI_E: {
 				if (config->updateMode != modeUnset) {
-					fprintf (stderr, "Error in parameter %d (%s): %s already defined in previous parameter\n", (int)PARNO, *argv, (config->updateMode == modeExport ? "-e" : "-u"));
+					static const char* modeNames[] = {"", "-e", "-u", "-g", "-get", "-set", "-rename", "-delete", "-sort", "-check", "-server"};
+					fprintf (stderr, "Error in parameter %d (%s): %s already defined in previous parameter\n", (int)PARNO, *argv, modeNames[config->updateMode]);
 					return 1;
 				}
 				if (argc <= 1) {
@@ -176,6 +484,66 @@ int analyzeCommandLine (int argc, char** argv, MD380_Configuration* config)
 				switch (argCrc) {
 					case CLI_U: config->updateMode = modeUpdate; break;
 					case CLI_E: config->updateMode = modeExport; break;
+					case CLI_G: config->updateMode = modeGenerate; break;
+					case CLI_GET: config->updateMode = modeGet; break;
+					case CLI_SET: config->updateMode = modeSet; break;
+					case CLI_RENAME: config->updateMode = modeRename; break;
+					case CLI_DELETE: config->updateMode = modeDelete; break;
+					case CLI_SORT: config->updateMode = modeSort; break;
+					case CLI_CHECK: config->updateMode = modeCheck; break;
+				}
+				
+				/* Fetch table, line, field and value; -rename has no field, */
+				/* -delete has neither field nor value, -sort has no line */
+				if (argCrc == CLI_GET || argCrc == CLI_SET || argCrc == CLI_RENAME || argCrc == CLI_DELETE || argCrc == CLI_SORT) {
+					char** targets [4];
+					const char* names [4];
+					unsigned noOfTargets = 1;
+					unsigned k;
+					char* end;
+					targets[0] = &config->fieldRecordName; names[0] = "table";
+					if (argCrc != CLI_SORT) {targets[noOfTargets] = NULL; names[noOfTargets++] = "line";}
+					if (argCrc == CLI_GET || argCrc == CLI_SET || argCrc == CLI_SORT) {targets[noOfTargets] = &config->fieldName; names[noOfTargets++] = "field";}
+					if (argCrc == CLI_SET) {targets[noOfTargets] = &config->fieldValue; names[noOfTargets++] = "value";}
+					if (argCrc == CLI_RENAME) {targets[noOfTargets] = &config->fieldValue; names[noOfTargets++] = "name";}
+					for (k=0; k<noOfTargets; k++) {
+						if (argc <= 1) {
+							fprintf (stderr, "Error in parameter %d (%s): missing %s\n", (int)PARNO, *argv, names[k]);
+							return 1;
+						}
+						argc--;
+						argv++;
+						if (targets[k] == NULL) {
+							config->fieldRecordNo = (unsigned)strtoul (*argv, &end, 10);
+							if (**argv < '0' || **argv > '9' || *end != 0) {
+								fprintf (stderr, "Error in parameter %d (%s): invalid line number\n", (int)PARNO, *argv);
+								return 1;
+							}
+							continue;
+						}
+						(*targets[k]) = binAlloc (strlen (*argv)+1);
+						if ((*targets[k]) == NULL) {
+							fprintf (stderr, "Error in parameter %d (%s): out of memory\n", (int)PARNO, *argv);
+							return 1;
+						}
+						strcpy ((*targets[k]), *argv);
+					}
+				}
+				
+				/* Fetch the overlay file name */
+				if (argCrc == CLI_G) {
+					if (argc <= 1) {
+						fprintf (stderr, "Error in parameter %d (%s): missing overlay .csv file name\n", (int)PARNO, *argv);
+						return 1;
+					}
+					argc--;
+					argv++;
+					config->overlayFileName = binAlloc (strlen (*argv)+1);
+					if (config->overlayFileName == NULL) {
+						fprintf (stderr, "Error in parameter %d (%s): out of memory\n", (int)PARNO, *argv);
+						return 1;
+					}
+					strcpy (config->overlayFileName, *argv);
 				}
 				break;
 			}
@@ -221,6 +589,63 @@ void ReportViolationFunc (void* param, const char* recordType, int recordNumber,
 	fprintf ((FILE*)param, "field %s, violation: %s\n", fieldName, text);
 }
 
+/*============================================================================
+	Encodes the changed records of the tables in 'changedMask' and of the
+	tables referring to them, whose references may have been renumbered,
+	and writes back their regions of the file.
+	Returns 0=ok  non-zero=error (as main); 'notChangedRet' if no record
+	changed
+============================================================================*/
+int saveChangedRecords (const char* fileName, t_buffer* rdtBinFile, unsigned offset, const TRDTFile* container, unsigned changedMask, MD380_Changes* changes, int notChangedRet)
+{
+	char* errorMessage = NULL;
+	unsigned encodeMask = changedMask;
+	unsigned i;
+	int ret;
+	MD380_StatsTimer timer;
+	
+	for (i=0; i<NO_OF_RECORDS_TRDTFile; i++) {
+		if (RECORDS_TRDTFile[i].referencedTables & changedMask) encodeMask |= (1u << i);
+	}
+	MD380_STATS_START (&timer);
+	ret = md380_EncodeChanges (rdtBinFile, container, encodeMask, changes);
+	MD380_STATS_STOP (&timer, MD380_PHASE_ENCODE);
+	if (ret != CSVRET_OK) {
+		fprintf (stderr, "Error allocating the list of changes (out of memory?)\n");
+		return 2;
+	}
+	md380_ReportChanges (changes, stderr);
+	
+	/* The standard output gets the whole image, changed or not */
+	if (md380_IsStdioName (fileName)) {
+		MD380_STATS_START (&timer);
+		ret = md380_WriteImageStream (stdout, rdtBinFile, offset, (offset ? FILE_SIZE_TBINFile : FILE_SIZE_TRDTFile), &errorMessage);
+		MD380_STATS_STOP (&timer, MD380_PHASE_SAVE);
+		if (ret != CSVRET_OK) {
+			fprintf (stderr, "ERROR: %s\n", errorMessage);
+			binFree (errorMessage);
+			return 4;
+		}
+		return (changes->noOfRanges ? 0 : notChangedRet);
+	}
+	if (changes->noOfRanges == 0) {
+		fprintf (stderr, "File '%s' not changed\n", fileName);
+		return notChangedRet;
+	}
+
+	/* Save the changed regions of the RDT file */
+	MD380_STATS_START (&timer);
+	ret = md380_WriteChanges (fileName, rdtBinFile, offset, changes, &errorMessage);
+	MD380_STATS_STOP (&timer, MD380_PHASE_SAVE);
+	if (ret != CSVRET_OK) {
+		fprintf (stderr, "ERROR: %s\n", errorMessage);
+		binFree (errorMessage);
+		return 4;
+	}
+	fprintf (stderr, "File '%s' updated\n", fileName);
+	return 0;
+}
+
 #if 0
 void testTone (unsigned char ch1, unsigned char ch2, t_numeric value)
 {
@@ -246,77 +671,225 @@ int main (int argc, char* argv[])
 }
 #endif
 /*============================================================================
-	MAIN
+	RUN A CONFIGURATION
+	Executes the action of a command line; 'violations' is set to the
+	number of rules violations found. The image and the container are
+	taken from 'arena', to be reset by the caller. With 'aio' (NULL if
+	none) the image can be the one read ahead and the .csv files are
+	queued to it.
+	Returns 0=ok  non-zero=error (as main)
 ============================================================================*/
-int main (int argc, char* argv[])
+int runConfiguration (MD380_Configuration* config, MD380_Arena* arena, MD380_Aio* aio, int* violations)
 {
 	t_buffer* rdtBinFile = NULL;
 	TRDTFile* container = NULL;
+	const TRDTFile* sourceContainer = NULL;
+	MD380_Snapshot snapshot;
 	int ret = 0;
-	MD380_Configuration config;
 	char* errorMessage = NULL;
 	MD380Tables md380tables;
+	MD380_Changes changes;
 	int noOfViolations=0;
 	unsigned offset, length;
+	unsigned decodeMask, bindMask;
+	MD380_StatsTimer timer;
 	
-	/* Print copyright information */	
-	fprintf (stderr, "rdt2csv r.%u - (c)%s by Davide Achilli IZ2UUF - iz2uuf@iz2uuf.net\n", SUBVERSION_RELEASE_N, LATEST_COMPILATION_YEAR);
-
-	INIT_MD380_Configuration (&config);
 	INIT_MD380Tables (&md380tables);
-
-#ifndef NDEBUG
-	TEST_LOOKUP ();
-	runBinlibTest ();
-#endif
-
-	ret = analyzeCommandLine (argc-1, argv+1, &config);
-	if (ret) goto exitMain;
+	INIT_MD380_Changes (&changes);
+	INIT_MD380_Snapshot (&snapshot);
 
 	/*--------------------------------------------------------------
 		The rdt file name must be available
 	--------------------------------------------------------------*/
-	if (config.rdtFileName == NULL) {
-		fprintf (stderr, "Error, no .rdt file specified (specify either -e or -u)\n");
+	if (config->rdtFileName == NULL) {
+		fprintf (stderr, "Error, no .rdt file specified (specify either -e, -u, -g, -get, -set, -rename, -delete, -sort or -check)\n");
 		ret = 1;
-		goto exitMain;
+		goto exitFunc;
+	}
+	if (config->columnarFileName != NULL && config->updateMode != modeExport) {
+		fprintf (stderr, "Error, -col can be used only with -e\n");
+		ret = 1;
+		goto exitFunc;
+	}
+	if ((config->maxZoneChannels || config->maxScanChannels || config->maxGroupContacts) && config->updateMode != modeCheck) {
+		fprintf (stderr, "Error, -maxlist can be used only with -check\n");
+		ret = 1;
+		goto exitFunc;
+	}
+	if (config->exitIfNotChanged && config->updateMode != modeUpdate && config->updateMode != modeRename && config->updateMode != modeDelete && config->updateMode != modeSort) {
+		fprintf (stderr, "Error, -exitcode can be used only with -u, -rename, -delete and -sort\n");
+		ret = 1;
+		goto exitFunc;
+	}
+	if (config->cacheDirName != NULL && config->updateMode != modeExport && config->updateMode != modeCheck) {
+		fprintf (stderr, "Error, -cache can be used only with -e and -check\n");
+		ret = 1;
+		goto exitFunc;
+	}
+
+	if (md380_IsStdioName (config->rdtFileName) && md380_StdioTables (&config->csvFileNames) && config->updateMode != modeExport) {
+		fprintf (stderr, "Error, the standard input can be used either for the .rdt file or for the .csv files\n");
+		ret = 1;
+		goto exitFunc;
 	}
 
 	/*--------------------------------------------------------------
-		Alloc the container and set it to zero
+		Single field access works on the file only: no container
+		is decoded and nothing is validated
 	--------------------------------------------------------------*/
-	container = (TRDTFile*)binAlloc (sizeof (TRDTFile));
-	if (container == NULL) {
-		fprintf (stderr, "Error allocating %u octets for internal container (out of memory?)\n", (unsigned)sizeof (TRDTFile));
-		ret = 2;
-		goto exitMain;
+	if (config->updateMode == modeGet || config->updateMode == modeSet) {
+		MD380_FieldLocation location;
+		char text [MD380_FIELD_TEXT_SIZE];
+		int fieldRet;
+		if (md380_IsStdioName (config->rdtFileName)) {
+			fprintf (stderr, "Error, -get and -set need a file name, not the standard input\n");
+			ret = 1;
+			goto exitFunc;
+		}
+		fieldRet = md380_LocateField (config->fieldRecordName, config->fieldRecordNo, config->fieldName, &location, &errorMessage);
+		if (fieldRet == CSVRET_OK) {
+			if (config->updateMode == modeGet) {
+				fieldRet = md380_GetFileField (config->rdtFileName, &location, text, sizeof (text), &errorMessage);
+				if (fieldRet == CSVRET_OK) printf ("%s\n", text);
+			}
+			else {
+				fieldRet = md380_SetFileField (config->rdtFileName, &location, config->fieldValue, &errorMessage);
+				if (fieldRet == CSVRET_OK) fprintf (stderr, "File '%s' updated\n", config->rdtFileName);
+			}
+		}
+		if (errorMessage) {
+			fprintf (stderr, "ERROR: %s\n", errorMessage);
+			binFree (errorMessage);
+			errorMessage = NULL;
+		}
+		if (fieldRet != CSVRET_OK) ret = 1;
+		goto exitFunc;
+	}
+
+	/*--------------------------------------------------------------
+		Select the record types to be decoded. Exporting only some
+		CSV files needs just their tables, plus the tables they
+		refer to for binding the names. Anything else needs the
+		whole image.
+	--------------------------------------------------------------*/
+	decodeMask = bindMask = TABLES_ALL_TRDTFile;
+	if (config->updateMode == modeExport && config->bundleFileName == NULL && config->columnarFileName == NULL && config->cacheDirName == NULL) {
+		unsigned i;
+		bindMask = TABLES_CSVFileNames (&config->csvFileNames);
+		if (bindMask == 0) bindMask = TABLES_ALL_TRDTFile;
+		decodeMask = bindMask;
+		for (i=0; i<NO_OF_RECORDS_TRDTFile; i++) {
+			if (bindMask & (1u << i)) decodeMask |= RECORDS_TRDTFile[i].referencedTables;
+		}
 	}
-	memset (container, 0, sizeof (TRDTFile));
 
 	/*--------------------------------------------------------------
 		Load the RDT file
 	--------------------------------------------------------------*/
-	rdtBinFile = loadRdtFile (config.rdtFileName, &offset, &length);
-	if (rdtBinFile == NULL) {ret = 1; goto exitMain;}
+	rdtBinFile = (t_buffer*)md380_ArenaAlloc (arena, FILE_SIZE_TRDTFile);
+	if (rdtBinFile == NULL) {
+		fprintf (stderr, "Error allocating %u octets for .RDT file (out of memory?)\n", FILE_SIZE_TRDTFile);
+		ret = 2;
+		goto exitFunc;
+	}
+	MD380_STATS_START (&timer);
+	ret = loadRdtFile (config->rdtFileName, aio, rdtBinFile, decodeMask, &offset, &length);
+	MD380_STATS_STOP (&timer, MD380_PHASE_LOAD);
+	if (ret) goto exitFunc;
+
+	/*--------------------------------------------------------------
+		An image found in the snapshot cache is neither decoded
+		nor validated: its container is mapped from the snapshot
+	--------------------------------------------------------------*/
+	if (config->cacheDirName) {
+		if (md380_LoadSnapshot (config->cacheDirName, rdtBinFile, offset, length, &snapshot) != CSVRET_OK) {
+			fprintf (stderr, "Error allocating the snapshot name (out of memory?)\n");
+			ret = 2;
+			goto exitFunc;
+		}
+	}
+	
+	if (snapshot.container == NULL) {
+		/* Alloc the container and set it to zero */
+		container = (TRDTFile*)md380_ArenaAlloc (arena, sizeof (TRDTFile));
+		if (container == NULL) {
+			fprintf (stderr, "Error allocating %u octets for internal container (out of memory?)\n", (unsigned)sizeof (TRDTFile));
+			ret = 2;
+			goto exitFunc;
+		}
+		memset (container, 0, sizeof (TRDTFile));
 
-	decodeBinary_TRDTFile (rdtBinFile, container);
+		MD380_STATS_START (&timer);
+		decodeBinaryTables_TRDTFile (rdtBinFile, container, decodeMask);
+		MD380_STATS_LAP (&timer, MD380_PHASE_DECODE);
+
+		/*--------------------------------------------------------------
+			Validate the RDT file
+		--------------------------------------------------------------*/
+		noOfViolations = validateContainerTables (container, decodeMask, ReportViolationFunc, stderr);
+		MD380_STATS_LAP (&timer, MD380_PHASE_VALIDATE);
+		noOfViolations += registerContainerNamesTables (&md380tables, container, decodeMask, ReportViolationFunc, stderr);
+		MD380_STATS_LAP (&timer, MD380_PHASE_REGISTER);
+		noOfViolations += bindReferencesTables (container, bindMask, ReportViolationFunc, stderr);
+		MD380_STATS_STOP (&timer, MD380_PHASE_BIND);
+		if (noOfViolations) {
+			fprintf (stderr, "Found %d rules violation(s) in input file '%s'\n", noOfViolations, config->rdtFileName);
+			goto exitFunc;
+		}
+		
+		/* Only valid images get a snapshot; failing to save it is not fatal */
+		if (config->cacheDirName && md380_SaveSnapshot (config->cacheDirName, rdtBinFile, offset, length, container, &errorMessage) != CSVRET_OK) {
+			fprintf (stderr, "WARNING: %s\n", (errorMessage ? errorMessage : "out of memory"));
+			if (errorMessage) binFree (errorMessage);
+			errorMessage = NULL;
+		}
+		sourceContainer = container;
+	}
+	else {
+		sourceContainer = snapshot.container;
+	}
 
 	/*--------------------------------------------------------------
-		Validate the RDT file
+		If specified on command line, generate the files from the
+		overlay; the template is not modified
 	--------------------------------------------------------------*/
-	noOfViolations = validateContainer (container, ReportViolationFunc, stderr);
-	noOfViolations += registerContainerNames (&md380tables, container, ReportViolationFunc, stderr);
-	noOfViolations += bindReferences (container, ReportViolationFunc, stderr);
-	if (noOfViolations) {
-		fprintf (stderr, "Found %d rules violation(s) in input file '%s'\n", noOfViolations, config.rdtFileName);
-		goto exitMain;
+	if (config->updateMode == modeGenerate) {
+		unsigned noOfImages;
+		int genRet = md380_GenerateFromOverlay (rdtBinFile, offset, length, container, config->overlayFileName, config->separator, ReportViolationFunc, stderr, &noOfImages, &noOfViolations, &errorMessage);
+		if (errorMessage) {
+			fprintf (stderr, "ERROR: %s\n", errorMessage);
+			binFree (errorMessage);
+			errorMessage = NULL;
+		}
+		if (noOfViolations) {
+			fprintf (stderr, "%d rules violation(s) in overlay file '%s'; offending lines skipped\n", noOfViolations, config->overlayFileName);
+		}
+		fprintf (stderr, "%u file(s) generated from '%s'\n", noOfImages, config->overlayFileName);
+		if (genRet != CSVRET_OK || noOfViolations) {
+			ret = 1;
+			goto exitFunc;
+		}
 	}
 
 	/*--------------------------------------------------------------
 		If specified on command line, save the CSV files
 	--------------------------------------------------------------*/
-	if (config.updateMode == modeExport) {
-		int saveRet = saveCSVFileAll (&config.csvFileNames, container, config.separator, &errorMessage);
+	if (config->updateMode == modeExport) {
+		int saveRet = CSVRET_OK;
+		if (config->bundleFileName) {
+			saveRet = md380_SaveCSVBundle (config->bundleFileName, sourceContainer, config->separator, &errorMessage);
+		}
+		if (saveRet == CSVRET_OK && config->columnarFileName) {
+			saveRet = md380_SaveColumnar (config->columnarFileName, sourceContainer, &errorMessage);
+		}
+		if (saveRet == CSVRET_OK && md380_StdioTables (&config->csvFileNames)) {
+			saveRet = md380_SaveCSVStream (stdout, sourceContainer, md380_StdioTables (&config->csvFileNames), config->separator, &errorMessage);
+			md380_RemoveStdioTables (&config->csvFileNames);
+		}
+		if (saveRet == CSVRET_OK) {
+			if (aio) saveRet = md380_AioSaveCSVFiles (aio, &config->csvFileNames, sourceContainer, config->separator, &errorMessage);
+			else saveRet = saveCSVFileAll (&config->csvFileNames, sourceContainer, config->separator, &errorMessage);
+		}
 		if (errorMessage) {
 			fprintf (stderr, "ERROR: %s\n", errorMessage);
 			binFree (errorMessage);
@@ -324,19 +897,31 @@ int main (int argc, char* argv[])
 		}
 		if (saveRet != CSVRET_OK) {
 			ret = 1;
-			goto exitMain;
+			goto exitFunc;
 		}
 	}
 
 	/*--------------------------------------------------------------
 		If specified on command line, save the RDT file
 	--------------------------------------------------------------*/
-	if (config.updateMode == modeUpdate) {
-		FILE* f;
+	if (config->updateMode == modeUpdate) {
 		int loadRet;
+		unsigned loadedMask = 0;
 		
-		/* Load the CSV files */
-		loadRet = loadCSVFileAll (&config.csvFileNames, container, config.separator, &errorMessage);
+		/* Load the bundle, then the CSV files */
+		md380_SetOriginalCounts (&changes, container);
+		loadRet = CSVRET_OK;
+		if (config->bundleFileName) {
+			loadRet = md380_LoadCSVBundle (config->bundleFileName, container, config->separator, &loadedMask, &errorMessage);
+		}
+		loadedMask |= TABLES_CSVFileNames (&config->csvFileNames);
+		if (loadRet == CSVRET_OK && md380_StdioTables (&config->csvFileNames)) {
+			loadRet = md380_LoadCSVStream (stdin, container, md380_StdioTables (&config->csvFileNames), config->separator, &errorMessage);
+			md380_RemoveStdioTables (&config->csvFileNames);
+		}
+		if (loadRet == CSVRET_OK) {
+			loadRet = loadCSVFileAll (&config->csvFileNames, container, config->separator, &errorMessage);
+		}
 		if (errorMessage) {
 			fprintf (stderr, "ERROR: %s\n", errorMessage);
 			binFree (errorMessage);
@@ -344,39 +929,538 @@ int main (int argc, char* argv[])
 		}
 		if (loadRet != CSVRET_OK) {
 			ret = 1;
-			goto exitMain;
+			goto exitFunc;
 		}
 
 		/* Validate the file */
+		MD380_STATS_START (&timer);
 		noOfViolations = validateContainer (container, ReportViolationFunc, stderr);
+		MD380_STATS_LAP (&timer, MD380_PHASE_VALIDATE);
 		noOfViolations += registerContainerNames (&md380tables, container, ReportViolationFunc, stderr);
+		MD380_STATS_LAP (&timer, MD380_PHASE_REGISTER);
 		noOfViolations += resolveReferences (&md380tables, container, ReportViolationFunc, stderr);
+		MD380_STATS_STOP (&timer, MD380_PHASE_BIND);
 		if (noOfViolations) {
 			fprintf (stderr, "File not saved due to %d rules violation(s)\n", noOfViolations);
-			goto exitMain;
+			goto exitFunc;
 		}
 		
-		/* Transfer the container to the binary file */
-		encodeBinary_TRDTFile (rdtBinFile, container);
+		/* Transfer the changed records to the binary file. Only the */
+		/* loaded tables and the tables referring to them, whose */
+		/* references may have been renumbered, are compared */
+		ret = saveChangedRecords (config->rdtFileName, rdtBinFile, offset, container, loadedMask, &changes, (config->exitIfNotChanged ? MAIN_NOT_CHANGED : 0));
+	}
+
+	/*--------------------------------------------------------------
+		If specified on command line, rename or delete a record
+		together with the references to it
+	--------------------------------------------------------------*/
+	if (config->updateMode == modeRename || config->updateMode == modeDelete) {
+		MD380_RefIndex refIndex;
+		unsigned table = md380_FindRecordType (config->fieldRecordName);
+		unsigned noOfReferences = 0;
+		int opRet;
+		
+		if (table >= NO_OF_RECORDS_TRDTFile) {
+			fprintf (stderr, "ERROR: Unknown record type '%s'\n", config->fieldRecordName);
+			ret = 1;
+			goto exitFunc;
+		}
+		md380_SetOriginalCounts (&changes, container);
+		INIT_MD380_RefIndex (&refIndex);
+		opRet = md380_BuildRefIndex (&refIndex, container, REFERENCE_EDGES_TRDTFile, NO_OF_REFERENCE_EDGES_TRDTFile);
+		if (opRet == CSVRET_OK && config->updateMode == modeRename) {
+			opRet = md380_RenameRecord (&refIndex, container, table, config->fieldRecordNo, config->fieldValue, &noOfReferences, &errorMessage);
+		}
+		else if (opRet == CSVRET_OK) {
+			opRet = md380_DeleteRecord (&refIndex, container, table, config->fieldRecordNo, &noOfReferences, &errorMessage);
+		}
+		FREE_MD380_RefIndex (&refIndex);
+		if (opRet == CSVRET_OUT_OF_MEMORY) {
+			fprintf (stderr, "Error allocating the reference index (out of memory?)\n");
+			ret = 2;
+			goto exitFunc;
+		}
+		if (errorMessage) {
+			fprintf (stderr, "ERROR: %s\n", errorMessage);
+			binFree (errorMessage);
+			errorMessage = NULL;
+		}
+		if (opRet != CSVRET_OK) {
+			ret = 1;
+			goto exitFunc;
+		}
+		fprintf (stderr, "%u reference(s) %s\n", noOfReferences, (config->updateMode == modeRename ? "updated" : "cleared"));
+		
+		/* Validate the file: a new name may be a dupe */
+		MD380_STATS_START (&timer);
+		noOfViolations = validateContainer (container, ReportViolationFunc, stderr);
+		MD380_STATS_LAP (&timer, MD380_PHASE_VALIDATE);
+		noOfViolations += registerContainerNames (&md380tables, container, ReportViolationFunc, stderr);
+		MD380_STATS_LAP (&timer, MD380_PHASE_REGISTER);
+		noOfViolations += resolveReferences (&md380tables, container, ReportViolationFunc, stderr);
+		MD380_STATS_STOP (&timer, MD380_PHASE_BIND);
+		if (noOfViolations) {
+			fprintf (stderr, "File not saved due to %d rules violation(s)\n", noOfViolations);
+			goto exitFunc;
+		}
+		ret = saveChangedRecords (config->rdtFileName, rdtBinFile, offset, container, 1u << table, &changes, (config->exitIfNotChanged ? MAIN_NOT_CHANGED : 0));
+	}
+
+	/*--------------------------------------------------------------
+		If specified on command line, run the cross-record rules
+	--------------------------------------------------------------*/
+	if (config->updateMode == modeCheck) {
+		MD380_RuleLimits limits;
+		INIT_MD380_RuleLimits (&limits);
+		limits.maxZoneChannels = config->maxZoneChannels;
+		limits.maxScanChannels = config->maxScanChannels;
+		limits.maxGroupContacts = config->maxGroupContacts;
+		noOfViolations = md380_CheckRules (sourceContainer, REFERENCE_EDGES_TRDTFile, NO_OF_REFERENCE_EDGES_TRDTFile, &limits, ReportViolationFunc, stderr);
+		if (noOfViolations < 0) {
+			fprintf (stderr, "Error allocating the rule indexes (out of memory?)\n");
+			ret = 2;
+			goto exitFunc;
+		}
+		fprintf (stderr, "Found %d cross-record warning(s) in file '%s'\n", noOfViolations, config->rdtFileName);
+		if (noOfViolations) ret = 1;
+	}
+
+	/*--------------------------------------------------------------
+		If specified on command line, sort a table and renumber
+		the references to its records
+	--------------------------------------------------------------*/
+	if (config->updateMode == modeSort) {
+		unsigned table = md380_FindRecordType (config->fieldRecordName);
+		unsigned* order = NULL;
+		unsigned noOfMoved = 0;
+		int sortRet;
+		
+		if (table >= NO_OF_RECORDS_TRDTFile) {
+			fprintf (stderr, "ERROR: Unknown record type '%s'\n", config->fieldRecordName);
+			ret = 1;
+			goto exitFunc;
+		}
+		md380_SetOriginalCounts (&changes, container);
+		order = (unsigned*)binAlloc (RECORDS_TRDTFile[table].maxCount*sizeof (unsigned));
+		sortRet = (order ? md380_SortPermutation (container, table, config->fieldName, order, &errorMessage) : CSVRET_OUT_OF_MEMORY);
+		if (sortRet == CSVRET_OK) {
+			sortRet = md380_ApplyPermutation (container, REFERENCE_EDGES_TRDTFile, NO_OF_REFERENCE_EDGES_TRDTFile, table, order, &noOfMoved);
+		}
+		if (order) binFree (order);
+		if (sortRet == CSVRET_OUT_OF_MEMORY) {
+			fprintf (stderr, "Error allocating the sort tables (out of memory?)\n");
+			ret = 2;
+			goto exitFunc;
+		}
+		if (errorMessage) {
+			fprintf (stderr, "ERROR: %s\n", errorMessage);
+			binFree (errorMessage);
+			errorMessage = NULL;
+		}
+		if (sortRet != CSVRET_OK) {
+			ret = 1;
+			goto exitFunc;
+		}
+		fprintf (stderr, "%u record(s) moved\n", noOfMoved);
+		ret = saveChangedRecords (config->rdtFileName, rdtBinFile, offset, container, 1u << table, &changes, (config->exitIfNotChanged ? MAIN_NOT_CHANGED : 0));
+	}
+
+exitFunc:
+	FREE_MD380Tables (&md380tables);
+	FREE_MD380_Changes (&changes);
+	FREE_MD380_Snapshot (&snapshot);
+	(*violations) = noOfViolations;
+	return ret;
+}
+
+/* Jobs run, skipped as up to date and failed */
+typedef struct {
+	unsigned executed;
+	unsigned skipped;
+	unsigned failed;
+} JobCounters;
+
+/* Line of the jobs file, read ahead of its job */
+typedef struct {
+	int readRet;
+	char** argv;
+	int argc;
+	unsigned lineNo;
+	char* errorMessage;
+} JobLine;
+
+/* The job running and the ones whose images can be read ahead */
+#define JOBS_WINDOW (MD380_AIO_READ_AHEAD+1)
+
+/*============================================================================
+	FLUSH THE JOBS
+	Waits for the .csv files queued by the jobs to 'aio' (NULL if none).
+	Returns 0=ok, else prints the first write failed and returns 1
+============================================================================*/
+int flushJobs (MD380_Aio* aio)
+{
+	char* errorMessage = NULL;
+	
+	if (aio == NULL || md380_AioFlush (aio, &errorMessage) == CSVRET_OK) return 0;
+	fprintf (stderr, "ERROR: %s\n", (errorMessage ? errorMessage : "out of memory"));
+	if (errorMessage) binFree (errorMessage);
+	return 1;
+}
+
+/*============================================================================
+	RUN A JOB
+	Runs a configuration unless 'db' (NULL if not used) has its stamp and
+	its files still match it; then records the new stamp. The blocks of
+	the previous job are released from 'arena', keeping its memory. The
+	I/O goes through 'aio' if not NULL.
+	Returns 0=ok  non-zero=error (as main)
+============================================================================*/
+int runJob (MD380_Configuration* config, MD380_Arena* arena, MD380_Aio* aio, MD380_StampDB* db, int force, JobCounters* counters)
+{
+	MD380_Stamp stamp;
+	const MD380_Stamp* recorded;
+	int stampable = 0;
+	int noOfViolations = 0;
+	int ret;
+	
+	/* The stamps hash the files, also the ones still queued */
+	if (db && flushJobs (aio)) {
+		counters->failed++;
+	}
+	if (db && md380_JobStamp (config, &stamp, &stampable) != CSVRET_OK) {
+		fprintf (stderr, "Error computing the stamp of the job (out of memory?)\n");
+		counters->failed++;
+		return 2;
+	}
+	if (stampable && !force) {
+		recorded = md380_FindStamp (db, stamp.job);
+		if (recorded && recorded->inputs == stamp.inputs && recorded->outputs == stamp.outputs) {
+			fprintf (stderr, "File '%s' up to date, job skipped\n", config->rdtFileName);
+			counters->skipped++;
+			return 0;
+		}
+	}
+	
+	md380_ResetArena (arena);
+	ret = runConfiguration (config, arena, aio, &noOfViolations);
+	if (ret == 0 && stampable && flushJobs (aio)) ret = 1;
+	if (ret || noOfViolations) {
+		if (stampable) md380_RemoveStamp (db, stamp.job);
+		counters->failed++;
+		return ret;
+	}
+	counters->executed++;
+	
+	/* The outputs as written by the job */
+	if (stampable) {
+		if (md380_OutputsStamp (config, &stamp.outputs) != CSVRET_OK || md380_RecordStamp (db, &stamp) != CSVRET_OK) {
+			fprintf (stderr, "Error recording the stamp of the job (out of memory?)\n");
+			return 2;
+		}
+	}
+	return 0;
+}
+
+/*============================================================================
+	IMAGE OF A JOB
+	Returns the image named by the command line of a job, found without
+	analyzing it, or NULL if none. 'loads' is set if the job loads it
+	whole, 'writes' if the job changes it; with NULL, 'writes' is set if
+	the job writes files not known in advance (-g).
+============================================================================*/
+const char* jobImage (char** argv, int argc, int* loads, int* writes)
+{
+	int i;
+	
+	(*loads) = (*writes) = 0;
+	for (i=0; i+1<argc; i++) {
+		switch (crc32_AddAsciizLowerCase (0, argv[i])) {
+			case CLI_G:
+				(*writes) = 1;
+				return NULL;
+			case CLI_U:
+			case CLI_RENAME:
+			case CLI_DELETE:
+			case CLI_SORT:
+				(*writes) = 1;
+				(*loads) = 1;
+				return argv[i+1];
+			case CLI_E:
+			case CLI_CHECK:
+				(*loads) = 1;
+				return argv[i+1];
+			case CLI_SET:
+				(*writes) = 1;
+				return argv[i+1];
+			case CLI_GET:
+				return argv[i+1];
+		}
+	}
+	return NULL;
+}
 
-		/* Save the RDT file */
-		f = fopen (config.rdtFileName, "wb");
+/*============================================================================
+	READ THE JOBS AHEAD
+	Starts reading the images of the jobs following the first of the
+	'noOfLines' lines from 'first'. An image is not read ahead of a job
+	changing it, nor anything past a job writing unknown files.
+============================================================================*/
+void prefetchJobs (MD380_Aio* aio, const JobLine* lines, unsigned first, unsigned noOfLines)
+{
+	const char* written [JOBS_WINDOW];
+	unsigned noOfWritten = 0;
+	unsigned k, w;
+	
+	for (k=0; k<noOfLines; k++) {
+		const JobLine* line = lines + (first+k) % JOBS_WINDOW;
+		const char* image;
+		int loads, writes;
+		if (line->readRet != CSVRET_OK) break;
+		image = jobImage (line->argv, line->argc, &loads, &writes);
+		if (image == NULL) {
+			if (writes) break;
+			continue;
+		}
+		for (w=0; w<noOfWritten; w++) {
+			if (strcmp (written[w], image) == 0) break;
+		}
+		if (k > 0 && loads && w == noOfWritten && !md380_IsStdioName (image)) {
+			md380_AioPrefetch (aio, image);
+		}
+		if (writes) written[noOfWritten++] = image;
+	}
+}
+
+/*============================================================================
+	RUN THE JOBS
+	Runs the jobs of the jobs file, or the command line itself if there
+	is none, keeping the stamps in the stamp file if given. The jobs are
+	read ahead, to read their images while the previous jobs run.
+	Returns 0=ok  non-zero=error (as main)
+============================================================================*/
+int runJobs (MD380_Configuration* config)
+{
+	MD380_StampDB stamps;
+	MD380_StampDB* db = (config->stampFileName ? &stamps : NULL);
+	MD380_Arena arena;
+	MD380_Aio aio;
+	JobLine lines [JOBS_WINDOW];
+	unsigned first = 0;
+	unsigned noOfLines = 0;
+	JobCounters counters;
+	char* errorMessage = NULL;
+	FILE* f = NULL;
+	int ret = 0;
+	unsigned k;
+	
+	INIT_MD380_StampDB (&stamps);
+	INIT_MD380_Arena (&arena);
+	INIT_MD380_Aio (&aio);
+	memset (&counters, 0, sizeof (counters));
+	if (db && md380_LoadStamps (db, config->stampFileName, &errorMessage) != CSVRET_OK) {
+		fprintf (stderr, "ERROR: %s\n", (errorMessage ? errorMessage : "out of memory"));
+		ret = 1;
+		goto exitFunc;
+	}
+	
+	if (config->jobsFileName == NULL) {
+		ret = runJob (config, &arena, NULL, db, config->forceJobs, &counters);
+	}
+	else {
+		unsigned lineNo = 0;
+		int eof = 0;
+		f = fopen (config->jobsFileName, "rb");
 		if (f == NULL) {
-			fprintf (stderr, "Error opening '%s' for writing (%s)\n", config.rdtFileName, strerror(errno));
-			ret = 4;
+			fprintf (stderr, "Error opening file '%s': %s\n", config->jobsFileName, strerror(errno));
+			ret = 1;
+			goto exitFunc;
+		}
+		if (md380_StartAio (&aio, config->aioBackend, &errorMessage) != CSVRET_OK) {
+			fprintf (stderr, "ERROR: %s\n", (errorMessage ? errorMessage : "out of memory"));
+			ret = 1;
+			goto exitFunc;
+		}
+		for (;;) {
+			MD380_Configuration jobConfig;
+			JobLine* line;
+			const char* image;
+			int loads, writes;
+			
+			/* Read the lines ahead, up to the first error */
+			while (!eof && noOfLines < JOBS_WINDOW) {
+				line = lines + (first+noOfLines) % JOBS_WINDOW;
+				memset (line, 0, sizeof (*line));
+				line->readRet = md380_ReadJob (f, config->jobsFileName, config->separator, &lineNo, &line->argv, &line->argc, &line->errorMessage);
+				line->lineNo = lineNo;
+				if (line->readRet == CSVRET_EOF) {eof = 1; break;}
+				if (line->readRet != CSVRET_OK) eof = 1;
+				noOfLines++;
+			}
+			if (noOfLines == 0) break;
+			line = lines+first;
+			if (line->readRet != CSVRET_OK) {
+				fprintf (stderr, "ERROR: %s\n", (line->errorMessage ? line->errorMessage : "out of memory"));
+				ret = 1;
+				break;
+			}
+			prefetchJobs (&aio, lines, first, noOfLines);
+			
+			fprintf (stderr, "Job at line %u of '%s'\n", line->lineNo, config->jobsFileName);
+			INIT_MD380_Configuration (&jobConfig);
+			if (analyzeCommandLine (line->argc, line->argv, &jobConfig)) {
+				counters.failed++;
+			}
+			else if (jobConfig.stampFileName || jobConfig.jobsFileName || jobConfig.forceJobs || jobConfig.showStats || jobConfig.aioBackend || jobConfig.exitIfNotChanged || jobConfig.updateMode == modeServer) {
+				fprintf (stderr, "Error, -stamp, -jobs, -force, -stats, -aio, -exitcode and -server cannot be used in a jobs file\n");
+				counters.failed++;
+			}
+			else {
+				/* The files queued by the previous jobs can be its inputs */
+				if ((jobConfig.updateMode == modeUpdate || jobConfig.updateMode == modeGenerate) && flushJobs (&aio)) {
+					counters.failed++;
+				}
+				runJob (&jobConfig, &arena, &aio, db, config->forceJobs, &counters);
+			}
+			FREE_MD380_Configuration (&jobConfig);
+			
+			/* An image read ahead and not taken would be stale for the next jobs */
+			image = jobImage (line->argv, line->argc, &loads, &writes);
+			if (image) md380_AioDrop (&aio, image);
+			binFree (line->argv);
+			first = (first+1) % JOBS_WINDOW;
+			noOfLines--;
+		}
+		if (flushJobs (&aio)) counters.failed++;
+		if (counters.failed) ret = 1;
+	}
+	
+	/* The stamps of the jobs run so far are kept even if a job failed */
+	if (db && db->changed) {
+		if (errorMessage) binFree (errorMessage);
+		errorMessage = NULL;
+		if (md380_SaveStamps (db, config->stampFileName, &errorMessage) != CSVRET_OK) {
+			fprintf (stderr, "ERROR: %s\n", (errorMessage ? errorMessage : "out of memory"));
+			ret = 1;
+		}
+	}
+	fprintf (stderr, "%u job(s) executed, %u skipped, %u failed\n", counters.executed, counters.skipped, counters.failed);
+
+exitFunc:
+	for (k=0; k<noOfLines; k++) {
+		JobLine* line = lines + (first+k) % JOBS_WINDOW;
+		if (line->argv) binFree (line->argv);
+		if (line->errorMessage) binFree (line->errorMessage);
+	}
+	if (f) fclose (f);
+	if (errorMessage) binFree (errorMessage);
+	FREE_MD380_Aio (&aio);
+	FREE_MD380_StampDB (&stamps);
+	FREE_MD380_Arena (&arena);
+	return ret;
+}
+
+/*============================================================================
+	MAIN
+============================================================================*/
+int main (int argc, char* argv[])
+{
+	int ret = 0;
+	MD380_Configuration config;
+	MD380_Arena arena;
+	char* errorMessage = NULL;
+	int noOfViolations=0;
+	
+	/* Print copyright information */	
+	fprintf (stderr, "rdt2csv r.%u - (c)%s by Davide Achilli IZ2UUF - iz2uuf@iz2uuf.net\n", SUBVERSION_RELEASE_N, LATEST_COMPILATION_YEAR);
+
+	INIT_MD380_Configuration (&config);
+	INIT_MD380_Arena (&arena);
+
+#ifndef NDEBUG
+	TEST_LOOKUP ();
+	runBinlibTest ();
+#endif
+
+	ret = analyzeCommandLine (argc-1, argv+1, &config);
+	if (ret) goto exitMain;
+
+	/* The counters are not thread safe */
+	if (config.showStats) {
+		if (config.updateMode == modeServer) {
+			fprintf (stderr, "Error, -stats cannot be used with -server\n");
+			ret = 1;
 			goto exitMain;
 		}
-		encodeBinary_TRDTFile (rdtBinFile, container);
-		fwrite (rdtBinFile+offset, 1, length, f);
-		fclose (f);
-		fprintf (stderr, "File '%s' updated\n", config.rdtFileName);
+		md380_StatsEnable ();
+	}
+
+	/*--------------------------------------------------------------
+		The server takes its files from the clients
+	--------------------------------------------------------------*/
+	if (config.updateMode == modeServer) {
+		#if defined(ED_DEBUG_ALLOC) || defined(ED_PROFILE_ALLOC)
+		/* The debug allocator and the profiler are not thread safe */
+		config.serverWorkers = 1;
+		#endif
+		if (md380_RunServer (config.serverSocketName, config.serverWorkers, stderr, &errorMessage) != CSVRET_OK) {
+			if (errorMessage) {
+				fprintf (stderr, "ERROR: %s\n", errorMessage);
+				binFree (errorMessage);
+				errorMessage = NULL;
+			}
+			ret = 1;
+		}
+		goto exitMain;
+	}
+	if (config.serverWorkers != 0) {
+		fprintf (stderr, "Error, -workers can be used only with -server\n");
+		ret = 1;
+		goto exitMain;
+	}
+
+	/*--------------------------------------------------------------
+		Jobs and stamps
+	--------------------------------------------------------------*/
+	if (config.forceJobs && config.stampFileName == NULL) {
+		fprintf (stderr, "Error, -force can be used only with -stamp\n");
+		ret = 1;
+		goto exitMain;
+	}
+	if (config.jobsFileName != NULL && (config.updateMode != modeUnset || TABLES_CSVFileNames (&config.csvFileNames) || config.bundleFileName || config.columnarFileName || config.cacheDirName)) {
+		fprintf (stderr, "Error, -jobs takes the actions from its file\n");
+		ret = 1;
+		goto exitMain;
+	}
+	if (config.aioBackend != MD380_AIO_AUTO && config.jobsFileName == NULL) {
+		fprintf (stderr, "Error, -aio can be used only with -jobs\n");
+		ret = 1;
+		goto exitMain;
+	}
+	if (config.exitIfNotChanged && (config.stampFileName || config.jobsFileName)) {
+		fprintf (stderr, "Error, -exitcode cannot be used with -stamp and -jobs\n");
+		ret = 1;
+		goto exitMain;
+	}
+	if (config.stampFileName != NULL && config.jobsFileName == NULL && config.updateMode != modeExport && config.updateMode != modeUpdate) {
+		fprintf (stderr, "Error, -stamp can be used only with -e, -u and -jobs\n");
+		ret = 1;
+		goto exitMain;
+	}
+	if (config.jobsFileName || config.stampFileName) {
+		ret = runJobs (&config);
+	}
+	else {
+		ret = runConfiguration (&config, &arena, NULL, &noOfViolations);
+		
+		/* Not saved due to rules violations: not to be taken as changed */
+		if (ret == 0 && noOfViolations && config.exitIfNotChanged) ret = 1;
 	}
 
 exitMain:
-	FREE_MD380Tables (&md380tables);
 	FREE_MD380_Configuration (&config);
-	if (rdtBinFile) binFree (rdtBinFile);
-	if (container) binFree (container);
+	FREE_MD380_Arena (&arena);
+	if (md380_stats.enabled) md380_PrintStats (stderr);
 
 	#ifdef ED_DEBUG_ALLOC
 	EDDebugPrintSummary ();
@@ -5,6 +5,7 @@
 #include "md380_tools.h"
 #include <assert.h>
 #include <stdio.h>
+#include <stddef.h>
 
 /* Function that decodes a binary record into the structure */
 void decodeBinary_ChannelInformation (const t_buffer* buffer, unsigned offsetInOctets, T_ChannelInformation* record)
@@ -830,6 +831,47 @@ FieldDescriptor DESC_ChannelInformation [FIELDS_ChannelInformation] = {
 	{0x5E237E06, BL_unicode, "Name", 0, NULL}
 };
 
+/* Field layout table for record ChannelInformation */
+const FieldLayout LAYOUT_ChannelInformation [FIELDS_ChannelInformation] = {
+	{offsetof (T_ChannelInformation, LoneWorker), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 0, 1},
+	{offsetof (T_ChannelInformation, Squelch), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 2, 1},
+	{offsetof (T_ChannelInformation, Autoscan), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 3, 1},
+	{offsetof (T_ChannelInformation, Bandwidth), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 4, 1},
+	{offsetof (T_ChannelInformation, ChannelMode), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 6, 2},
+	{offsetof (T_ChannelInformation, Colorcode), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 8, 4},
+	{offsetof (T_ChannelInformation, RepeaterSlot), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 12, 2},
+	{offsetof (T_ChannelInformation, RxOnly), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 14, 1},
+	{offsetof (T_ChannelInformation, AllowTalkaround), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 15, 1},
+	{offsetof (T_ChannelInformation, DataCallConf), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 16, 1},
+	{offsetof (T_ChannelInformation, PrivateCallConf), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 17, 1},
+	{offsetof (T_ChannelInformation, Privacy), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 18, 2},
+	{offsetof (T_ChannelInformation, PrivacyNo), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 20, 4},
+	{offsetof (T_ChannelInformation, DisplayPttId), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 24, 1},
+	{offsetof (T_ChannelInformation, CompressedUdpHdr), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 25, 1},
+	{offsetof (T_ChannelInformation, EmergencyAlarmAck), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 28, 1},
+	{offsetof (T_ChannelInformation, RxRefFrequency), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 30, 2},
+	{offsetof (T_ChannelInformation, AdmintCriteria), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 32, 2},
+	{offsetof (T_ChannelInformation, Power), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 34, 1},
+	{offsetof (T_ChannelInformation, Vox), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 35, 1},
+	{offsetof (T_ChannelInformation, QtReverse), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 36, 1},
+	{offsetof (T_ChannelInformation, ReverseBurst), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 37, 1},
+	{offsetof (T_ChannelInformation, TxRefFrequency), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 38, 2},
+	{offsetof (T_ChannelInformation, ContactName), FL_reference, 0, 0, FC_binary, 48, 16},
+	{offsetof (T_ChannelInformation, Tot), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 66, 6},
+	{offsetof (T_ChannelInformation, TotRekeyDelay), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 72, 8},
+	{offsetof (T_ChannelInformation, EmergencySystem), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 82, 6},
+	{offsetof (T_ChannelInformation, ScanList), FL_reference, 0, 0, FC_bits, 88, 8},
+	{offsetof (T_ChannelInformation, GroupList), FL_reference, 0, 0, FC_bits, 96, 8},
+	{offsetof (T_ChannelInformation, Decode18), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 112, 8},
+	{offsetof (T_ChannelInformation, RxFrequency), FL_numeric, 0, sizeof (t_numeric32), FC_bcd, 128, 32},
+	{offsetof (T_ChannelInformation, TxFrequency), FL_numeric, 0, sizeof (t_numeric32), FC_bcd, 160, 32},
+	{offsetof (T_ChannelInformation, CtcssDcsDecode), FL_numeric, 0, sizeof (t_numeric32), FC_bcdTones, 192, 16},
+	{offsetof (T_ChannelInformation, CtcssDcsEncode), FL_numeric, 0, sizeof (t_numeric32), FC_bcdTones, 208, 16},
+	{offsetof (T_ChannelInformation, TxSignalingSyst), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 237, 3},
+	{offsetof (T_ChannelInformation, RxSignalingSyst), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 229, 3},
+	{offsetof (T_ChannelInformation, Name), FL_unicode, 16, 0, FC_unicode, 256, 256}
+};
+
 /* Function that decodes a binary record into the structure */
 void decodeBinary_DigitalContact (const t_buffer* buffer, unsigned offsetInOctets, T_DigitalContact* record)
 {
@@ -884,6 +926,14 @@ FieldDescriptor DESC_DigitalContact [FIELDS_DigitalContact] = {
 	{0x5E237E06, BL_unicode, "Name", 0, NULL}
 };
 
+/* Field layout table for record DigitalContact */
+const FieldLayout LAYOUT_DigitalContact [FIELDS_DigitalContact] = {
+	{offsetof (T_DigitalContact, CallId), FL_numeric, 0, sizeof (t_numeric32), FC_binary, 0, 24},
+	{offsetof (T_DigitalContact, CallReceiveTone), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 26, 1},
+	{offsetof (T_DigitalContact, CallType), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 30, 2},
+	{offsetof (T_DigitalContact, Name), FL_unicode, 16, 0, FC_unicode, 32, 256}
+};
+
 /* Function that decodes a binary record into the structure */
 void decodeBinary_DigitalRxGroupList (const t_buffer* buffer, unsigned offsetInOctets, T_DigitalRxGroupList* record)
 {
@@ -963,6 +1013,43 @@ FieldDescriptor DESC_DigitalRxGroupList [FIELDS_DigitalRxGroupList] = {
 	{0x298C7EAB, BL_integer, "ContactMember32", 0, NULL}
 };
 
+/* Field layout table for record DigitalRxGroupList */
+const FieldLayout LAYOUT_DigitalRxGroupList [FIELDS_DigitalRxGroupList] = {
+	{offsetof (T_DigitalRxGroupList, Name), FL_unicode, 16, 0, FC_unicode, 0, 256},
+	{offsetof (T_DigitalRxGroupList, ContactMember[0]), FL_reference, 0, 0, FC_binary, 256, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[1]), FL_reference, 0, 0, FC_binary, 272, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[2]), FL_reference, 0, 0, FC_binary, 288, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[3]), FL_reference, 0, 0, FC_binary, 304, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[4]), FL_reference, 0, 0, FC_binary, 320, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[5]), FL_reference, 0, 0, FC_binary, 336, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[6]), FL_reference, 0, 0, FC_binary, 352, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[7]), FL_reference, 0, 0, FC_binary, 368, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[8]), FL_reference, 0, 0, FC_binary, 384, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[9]), FL_reference, 0, 0, FC_binary, 400, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[10]), FL_reference, 0, 0, FC_binary, 416, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[11]), FL_reference, 0, 0, FC_binary, 432, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[12]), FL_reference, 0, 0, FC_binary, 448, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[13]), FL_reference, 0, 0, FC_binary, 464, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[14]), FL_reference, 0, 0, FC_binary, 480, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[15]), FL_reference, 0, 0, FC_binary, 496, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[16]), FL_reference, 0, 0, FC_binary, 512, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[17]), FL_reference, 0, 0, FC_binary, 528, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[18]), FL_reference, 0, 0, FC_binary, 544, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[19]), FL_reference, 0, 0, FC_binary, 560, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[20]), FL_reference, 0, 0, FC_binary, 576, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[21]), FL_reference, 0, 0, FC_binary, 592, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[22]), FL_reference, 0, 0, FC_binary, 608, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[23]), FL_reference, 0, 0, FC_binary, 624, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[24]), FL_reference, 0, 0, FC_binary, 640, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[25]), FL_reference, 0, 0, FC_binary, 656, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[26]), FL_reference, 0, 0, FC_binary, 672, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[27]), FL_reference, 0, 0, FC_binary, 688, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[28]), FL_reference, 0, 0, FC_binary, 704, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[29]), FL_reference, 0, 0, FC_binary, 720, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[30]), FL_reference, 0, 0, FC_binary, 736, 16},
+	{offsetof (T_DigitalRxGroupList, ContactMember[31]), FL_reference, 0, 0, FC_binary, 752, 16}
+};
+
 /* Function that decodes a binary record into the structure */
 void decodeBinary_GeneralSettings (const t_buffer* buffer, unsigned offsetInOctets, T_GeneralSettings* record)
 {
@@ -1154,6 +1241,39 @@ FieldDescriptor DESC_GeneralSettings [FIELDS_GeneralSettings] = {
 	{0x101A283A, BL_unicode, "RadioName", 0, NULL}
 };
 
+/* Field layout table for record GeneralSettings */
+const FieldLayout LAYOUT_GeneralSettings [FIELDS_GeneralSettings] = {
+	{offsetof (T_GeneralSettings, InfoScreenLine1), FL_unicode, 10, 0, FC_unicode, 0, 160},
+	{offsetof (T_GeneralSettings, InfoScreenLine2), FL_unicode, 10, 0, FC_unicode, 160, 160},
+	{offsetof (T_GeneralSettings, MonitorType), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 515, 1},
+	{offsetof (T_GeneralSettings, DisableAllLeds), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 517, 1},
+	{offsetof (T_GeneralSettings, TalkPermitTone), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 520, 2},
+	{offsetof (T_GeneralSettings, PasswordAndLockEnable), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 522, 1},
+	{offsetof (T_GeneralSettings, CHFreeIndicationTone), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 523, 1},
+	{offsetof (T_GeneralSettings, DisableAllTone), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 525, 1},
+	{offsetof (T_GeneralSettings, SaveModeReceive), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 526, 1},
+	{offsetof (T_GeneralSettings, SavePreamble), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 527, 1},
+	{offsetof (T_GeneralSettings, IntroScreen), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 531, 1},
+	{offsetof (T_GeneralSettings, RadioId), FL_numeric, 0, sizeof (t_numeric32), FC_binary, 544, 24},
+	{offsetof (T_GeneralSettings, TxPreamble), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 576, 8},
+	{offsetof (T_GeneralSettings, GroupCallHangTime), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 584, 8},
+	{offsetof (T_GeneralSettings, PrivateCallHangTime), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 592, 8},
+	{offsetof (T_GeneralSettings, VoxSensitivity), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 600, 8},
+	{offsetof (T_GeneralSettings, RxLowBatteryInterval), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 624, 8},
+	{offsetof (T_GeneralSettings, CallAlertTone), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 632, 8},
+	{offsetof (T_GeneralSettings, LoneWorkerRespTime), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 640, 8},
+	{offsetof (T_GeneralSettings, LoneWorkerReminderTime), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 648, 8},
+	{offsetof (T_GeneralSettings, ScanDigitalHangTime), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 664, 8},
+	{offsetof (T_GeneralSettings, ScanAnalogHangTime), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 672, 8},
+	{offsetof (T_GeneralSettings, Unknown1), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 680, 8},
+	{offsetof (T_GeneralSettings, KeypadLockTime), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 688, 8},
+	{offsetof (T_GeneralSettings, Mode), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 696, 8},
+	{offsetof (T_GeneralSettings, PowerOnPassword), FL_numeric, 0, sizeof (t_numeric32), FC_revBcd, 704, 32},
+	{offsetof (T_GeneralSettings, RadioProgPassowrd), FL_numeric, 0, sizeof (t_numeric32), FC_revBcd, 736, 32},
+	{offsetof (T_GeneralSettings, PcProgPassword), FL_unicode, 8, 0, FC_ascii, 768, 64},
+	{offsetof (T_GeneralSettings, RadioName), FL_unicode, 16, 0, FC_unicode, 896, 256}
+};
+
 /* Function that decodes a binary record into the structure */
 void decodeBinary_ScanList (const t_buffer* buffer, unsigned offsetInOctets, T_ScanList* record)
 {
@@ -1265,6 +1385,47 @@ FieldDescriptor DESC_ScanList [FIELDS_ScanList] = {
 	{0x9DE93191, BL_integer, "ChannelMember31", 0, NULL}
 };
 
+/* Field layout table for record ScanList */
+const FieldLayout LAYOUT_ScanList [FIELDS_ScanList] = {
+	{offsetof (T_ScanList, Name), FL_unicode, 16, 0, FC_unicode, 0, 256},
+	{offsetof (T_ScanList, PriorityCh1), FL_reference, 0, 0, FC_binary, 256, 16},
+	{offsetof (T_ScanList, PriorityCh2), FL_reference, 0, 0, FC_binary, 272, 16},
+	{offsetof (T_ScanList, TXDesignatedCh), FL_reference, 0, 0, FC_binary, 288, 16},
+	{offsetof (T_ScanList, SignHoldTime), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 312, 8},
+	{offsetof (T_ScanList, PrioSamplTime), FL_numeric, 0, sizeof (t_numeric8), FC_bits, 320, 8},
+	{offsetof (T_ScanList, ChannelMember[0]), FL_reference, 0, 0, FC_binary, 336, 16},
+	{offsetof (T_ScanList, ChannelMember[1]), FL_reference, 0, 0, FC_binary, 352, 16},
+	{offsetof (T_ScanList, ChannelMember[2]), FL_reference, 0, 0, FC_binary, 368, 16},
+	{offsetof (T_ScanList, ChannelMember[3]), FL_reference, 0, 0, FC_binary, 384, 16},
+	{offsetof (T_ScanList, ChannelMember[4]), FL_reference, 0, 0, FC_binary, 400, 16},
+	{offsetof (T_ScanList, ChannelMember[5]), FL_reference, 0, 0, FC_binary, 416, 16},
+	{offsetof (T_ScanList, ChannelMember[6]), FL_reference, 0, 0, FC_binary, 432, 16},
+	{offsetof (T_ScanList, ChannelMember[7]), FL_reference, 0, 0, FC_binary, 448, 16},
+	{offsetof (T_ScanList, ChannelMember[8]), FL_reference, 0, 0, FC_binary, 464, 16},
+	{offsetof (T_ScanList, ChannelMember[9]), FL_reference, 0, 0, FC_binary, 480, 16},
+	{offsetof (T_ScanList, ChannelMember[10]), FL_reference, 0, 0, FC_binary, 496, 16},
+	{offsetof (T_ScanList, ChannelMember[11]), FL_reference, 0, 0, FC_binary, 512, 16},
+	{offsetof (T_ScanList, ChannelMember[12]), FL_reference, 0, 0, FC_binary, 528, 16},
+	{offsetof (T_ScanList, ChannelMember[13]), FL_reference, 0, 0, FC_binary, 544, 16},
+	{offsetof (T_ScanList, ChannelMember[14]), FL_reference, 0, 0, FC_binary, 560, 16},
+	{offsetof (T_ScanList, ChannelMember[15]), FL_reference, 0, 0, FC_binary, 576, 16},
+	{offsetof (T_ScanList, ChannelMember[16]), FL_reference, 0, 0, FC_binary, 592, 16},
+	{offsetof (T_ScanList, ChannelMember[17]), FL_reference, 0, 0, FC_binary, 608, 16},
+	{offsetof (T_ScanList, ChannelMember[18]), FL_reference, 0, 0, FC_binary, 624, 16},
+	{offsetof (T_ScanList, ChannelMember[19]), FL_reference, 0, 0, FC_binary, 640, 16},
+	{offsetof (T_ScanList, ChannelMember[20]), FL_reference, 0, 0, FC_binary, 656, 16},
+	{offsetof (T_ScanList, ChannelMember[21]), FL_reference, 0, 0, FC_binary, 672, 16},
+	{offsetof (T_ScanList, ChannelMember[22]), FL_reference, 0, 0, FC_binary, 688, 16},
+	{offsetof (T_ScanList, ChannelMember[23]), FL_reference, 0, 0, FC_binary, 704, 16},
+	{offsetof (T_ScanList, ChannelMember[24]), FL_reference, 0, 0, FC_binary, 720, 16},
+	{offsetof (T_ScanList, ChannelMember[25]), FL_reference, 0, 0, FC_binary, 736, 16},
+	{offsetof (T_ScanList, ChannelMember[26]), FL_reference, 0, 0, FC_binary, 752, 16},
+	{offsetof (T_ScanList, ChannelMember[27]), FL_reference, 0, 0, FC_binary, 768, 16},
+	{offsetof (T_ScanList, ChannelMember[28]), FL_reference, 0, 0, FC_binary, 784, 16},
+	{offsetof (T_ScanList, ChannelMember[29]), FL_reference, 0, 0, FC_binary, 800, 16},
+	{offsetof (T_ScanList, ChannelMember[30]), FL_reference, 0, 0, FC_binary, 816, 16}
+};
+
 /* Function that decodes a binary record into the structure */
 void decodeBinary_TextMessage (const t_buffer* buffer, unsigned offsetInOctets, T_TextMessage* record)
 {
@@ -1296,6 +1457,11 @@ FieldDescriptor DESC_TextMessage [FIELDS_TextMessage] = {
 	{0x3B8BA7C7, BL_unicode, "Text", 0, NULL}
 };
 
+/* Field layout table for record TextMessage */
+const FieldLayout LAYOUT_TextMessage [FIELDS_TextMessage] = {
+	{offsetof (T_TextMessage, Text), FL_unicode, 144, 0, FC_unicode, 0, 2304}
+};
+
 /* Function that decodes a binary record into the structure */
 void decodeBinary_ZoneInformation (const t_buffer* buffer, unsigned offsetInOctets, T_ZoneInformation* record)
 {
@@ -1359,127 +1525,226 @@ FieldDescriptor DESC_ZoneInformation [FIELDS_ZoneInformation] = {
 	{0x31BBC6B0, BL_integer, "ChannelMember16", 0, NULL}
 };
 
+/* Field layout table for record ZoneInformation */
+const FieldLayout LAYOUT_ZoneInformation [FIELDS_ZoneInformation] = {
+	{offsetof (T_ZoneInformation, Name), FL_unicode, 16, 0, FC_unicode, 0, 256},
+	{offsetof (T_ZoneInformation, ChannelMember[0]), FL_reference, 0, 0, FC_binary, 256, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[1]), FL_reference, 0, 0, FC_binary, 272, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[2]), FL_reference, 0, 0, FC_binary, 288, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[3]), FL_reference, 0, 0, FC_binary, 304, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[4]), FL_reference, 0, 0, FC_binary, 320, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[5]), FL_reference, 0, 0, FC_binary, 336, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[6]), FL_reference, 0, 0, FC_binary, 352, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[7]), FL_reference, 0, 0, FC_binary, 368, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[8]), FL_reference, 0, 0, FC_binary, 384, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[9]), FL_reference, 0, 0, FC_binary, 400, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[10]), FL_reference, 0, 0, FC_binary, 416, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[11]), FL_reference, 0, 0, FC_binary, 432, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[12]), FL_reference, 0, 0, FC_binary, 448, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[13]), FL_reference, 0, 0, FC_binary, 464, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[14]), FL_reference, 0, 0, FC_binary, 480, 16},
+	{offsetof (T_ZoneInformation, ChannelMember[15]), FL_reference, 0, 0, FC_binary, 496, 16}
+};
+
 /* Decode a binary file; its size must be FILE_SIZE_TRDTFile */
 void decodeBinary_TRDTFile (const t_buffer* buffer, TRDTFile* container)
+{
+	decodeBinaryTables_TRDTFile (buffer, container, TABLES_ALL_TRDTFile);
+}
+
+/* Decode only the record types selected by tableMask (TABLE_xxx bits) */
+void decodeBinaryTables_TRDTFile (const t_buffer* buffer, TRDTFile* container, unsigned tableMask)
 {
 	unsigned i;
 	
-	container->ChannelInformation_COUNT = 0;
-	
-	for (i=0; i<1000; i++) {
-		if ((bitsToNumeric (buffer, (OFFSET_ChannelInformation+i*LENGTH_ChannelInformation) * 8 + 128, 8) == 255)) {
-			break;
+	if (tableMask & TABLE_ChannelInformation) {
+		container->ChannelInformation_COUNT = 0;
+		
+		for (i=0; i<1000; i++) {
+			if ((bitsToNumeric (buffer, (OFFSET_ChannelInformation+i*LENGTH_ChannelInformation) * 8 + 128, 8) == 255)) {
+				break;
+			}
+			decodeBinary_ChannelInformation (buffer, OFFSET_ChannelInformation+i*LENGTH_ChannelInformation, container->ChannelInformation+i);
+			container->ChannelInformation_COUNT++;
 		}
-		decodeBinary_ChannelInformation (buffer, OFFSET_ChannelInformation+i*LENGTH_ChannelInformation, container->ChannelInformation+i);
-		container->ChannelInformation_COUNT++;
 	}
 	
-	container->DigitalContact_COUNT = 0;
-	
-	for (i=0; i<1000; i++) {
-		if ((bitsToNumeric (buffer, (OFFSET_DigitalContact+i*LENGTH_DigitalContact) * 8 + 32, 8) == 0) && (bitsToNumeric (buffer, (OFFSET_DigitalContact+i*LENGTH_DigitalContact) * 8 + 40, 8) == 0)) {
-			break;
+	if (tableMask & TABLE_DigitalContact) {
+		container->DigitalContact_COUNT = 0;
+		
+		for (i=0; i<1000; i++) {
+			if ((bitsToNumeric (buffer, (OFFSET_DigitalContact+i*LENGTH_DigitalContact) * 8 + 32, 8) == 0) && (bitsToNumeric (buffer, (OFFSET_DigitalContact+i*LENGTH_DigitalContact) * 8 + 40, 8) == 0)) {
+				break;
+			}
+			decodeBinary_DigitalContact (buffer, OFFSET_DigitalContact+i*LENGTH_DigitalContact, container->DigitalContact+i);
+			container->DigitalContact_COUNT++;
 		}
-		decodeBinary_DigitalContact (buffer, OFFSET_DigitalContact+i*LENGTH_DigitalContact, container->DigitalContact+i);
-		container->DigitalContact_COUNT++;
 	}
 	
-	container->DigitalRxGroupList_COUNT = 0;
-	
-	for (i=0; i<250; i++) {
-		if ((bitsToNumeric (buffer, (OFFSET_DigitalRxGroupList+i*LENGTH_DigitalRxGroupList) * 8 + 0, 8) == 0)) {
-			break;
+	if (tableMask & TABLE_DigitalRxGroupList) {
+		container->DigitalRxGroupList_COUNT = 0;
+		
+		for (i=0; i<250; i++) {
+			if ((bitsToNumeric (buffer, (OFFSET_DigitalRxGroupList+i*LENGTH_DigitalRxGroupList) * 8 + 0, 8) == 0)) {
+				break;
+			}
+			decodeBinary_DigitalRxGroupList (buffer, OFFSET_DigitalRxGroupList+i*LENGTH_DigitalRxGroupList, container->DigitalRxGroupList+i);
+			container->DigitalRxGroupList_COUNT++;
 		}
-		decodeBinary_DigitalRxGroupList (buffer, OFFSET_DigitalRxGroupList+i*LENGTH_DigitalRxGroupList, container->DigitalRxGroupList+i);
-		container->DigitalRxGroupList_COUNT++;
 	}
 	
-	decodeBinary_GeneralSettings (buffer, OFFSET_GeneralSettings, &container->GeneralSettings);
-	
-	container->ScanList_COUNT = 0;
+	if (tableMask & TABLE_GeneralSettings) {
+		decodeBinary_GeneralSettings (buffer, OFFSET_GeneralSettings, &container->GeneralSettings);
+	}
 	
-	for (i=0; i<250; i++) {
-		if ((bitsToNumeric (buffer, (OFFSET_ScanList+i*LENGTH_ScanList) * 8 + 0, 8) == 0)) {
-			break;
+	if (tableMask & TABLE_ScanList) {
+		container->ScanList_COUNT = 0;
+		
+		for (i=0; i<250; i++) {
+			if ((bitsToNumeric (buffer, (OFFSET_ScanList+i*LENGTH_ScanList) * 8 + 0, 8) == 0)) {
+				break;
+			}
+			decodeBinary_ScanList (buffer, OFFSET_ScanList+i*LENGTH_ScanList, container->ScanList+i);
+			container->ScanList_COUNT++;
 		}
-		decodeBinary_ScanList (buffer, OFFSET_ScanList+i*LENGTH_ScanList, container->ScanList+i);
-		container->ScanList_COUNT++;
 	}
 	
-	container->TextMessage_COUNT = 0;
-	
-	for (i=0; i<50; i++) {
-		if ((bitsToNumeric (buffer, (OFFSET_TextMessage+i*LENGTH_TextMessage) * 8 + 0, 8) == 0)) {
-			break;
+	if (tableMask & TABLE_TextMessage) {
+		container->TextMessage_COUNT = 0;
+		
+		for (i=0; i<50; i++) {
+			if ((bitsToNumeric (buffer, (OFFSET_TextMessage+i*LENGTH_TextMessage) * 8 + 0, 8) == 0)) {
+				break;
+			}
+			decodeBinary_TextMessage (buffer, OFFSET_TextMessage+i*LENGTH_TextMessage, container->TextMessage+i);
+			container->TextMessage_COUNT++;
 		}
-		decodeBinary_TextMessage (buffer, OFFSET_TextMessage+i*LENGTH_TextMessage, container->TextMessage+i);
-		container->TextMessage_COUNT++;
 	}
 	
-	container->ZoneInformation_COUNT = 0;
-	
-	for (i=0; i<250; i++) {
-		if ((bitsToNumeric (buffer, (OFFSET_ZoneInformation+i*LENGTH_ZoneInformation) * 8 + 0, 8) == 0)) {
-			break;
+	if (tableMask & TABLE_ZoneInformation) {
+		container->ZoneInformation_COUNT = 0;
+		
+		for (i=0; i<250; i++) {
+			if ((bitsToNumeric (buffer, (OFFSET_ZoneInformation+i*LENGTH_ZoneInformation) * 8 + 0, 8) == 0)) {
+				break;
+			}
+			decodeBinary_ZoneInformation (buffer, OFFSET_ZoneInformation+i*LENGTH_ZoneInformation, container->ZoneInformation+i);
+			container->ZoneInformation_COUNT++;
 		}
-		decodeBinary_ZoneInformation (buffer, OFFSET_ZoneInformation+i*LENGTH_ZoneInformation, container->ZoneInformation+i);
-		container->ZoneInformation_COUNT++;
 	}
-
 }
 
 /* Encode a binary file; its size must be FILE_SIZE_TRDTFile */
 extern void encodeBinary_TRDTFile (t_buffer* buffer, const TRDTFile* container)
+{
+	encodeBinaryTables_TRDTFile (buffer, container, TABLES_ALL_TRDTFile);
+}
+
+/* Encode only the record types selected by tableMask (TABLE_xxx bits) */
+void encodeBinaryTables_TRDTFile (t_buffer* buffer, const TRDTFile* container, unsigned tableMask)
 {
 	unsigned i;
-	for (i=0; i<1000; i++) {
-		if (i < container->ChannelInformation_COUNT) {
+	
+	if (tableMask & TABLE_ChannelInformation) {
+		for (i=0; i<container->ChannelInformation_COUNT && i<1000; i++) {
 			encodeBinary_ChannelInformation (buffer, OFFSET_ChannelInformation+i*LENGTH_ChannelInformation, container->ChannelInformation+i);
 		}
-		else {
+		if (i < 1000) {
 			encodeBinaryEmpty_ChannelInformation (buffer, OFFSET_ChannelInformation+i*LENGTH_ChannelInformation);
+			binReplicate (buffer+OFFSET_ChannelInformation+i*LENGTH_ChannelInformation, LENGTH_ChannelInformation, 1000-i);
 		}
 	}
-	for (i=0; i<1000; i++) {
-		if (i < container->DigitalContact_COUNT) {
+	
+	if (tableMask & TABLE_DigitalContact) {
+		for (i=0; i<container->DigitalContact_COUNT && i<1000; i++) {
 			encodeBinary_DigitalContact (buffer, OFFSET_DigitalContact+i*LENGTH_DigitalContact, container->DigitalContact+i);
 		}
-		else {
+		if (i < 1000) {
 			encodeBinaryEmpty_DigitalContact (buffer, OFFSET_DigitalContact+i*LENGTH_DigitalContact);
+			binReplicate (buffer+OFFSET_DigitalContact+i*LENGTH_DigitalContact, LENGTH_DigitalContact, 1000-i);
 		}
 	}
-	for (i=0; i<250; i++) {
-		if (i < container->DigitalRxGroupList_COUNT) {
+	
+	if (tableMask & TABLE_DigitalRxGroupList) {
+		for (i=0; i<container->DigitalRxGroupList_COUNT && i<250; i++) {
 			encodeBinary_DigitalRxGroupList (buffer, OFFSET_DigitalRxGroupList+i*LENGTH_DigitalRxGroupList, container->DigitalRxGroupList+i);
 		}
-		else {
+		if (i < 250) {
 			encodeBinaryEmpty_DigitalRxGroupList (buffer, OFFSET_DigitalRxGroupList+i*LENGTH_DigitalRxGroupList);
+			binReplicate (buffer+OFFSET_DigitalRxGroupList+i*LENGTH_DigitalRxGroupList, LENGTH_DigitalRxGroupList, 250-i);
 		}
 	}
-	encodeBinary_GeneralSettings (buffer, OFFSET_GeneralSettings, &container->GeneralSettings);
-	for (i=0; i<250; i++) {
-		if (i < container->ScanList_COUNT) {
+	
+	if (tableMask & TABLE_GeneralSettings) {
+		encodeBinary_GeneralSettings (buffer, OFFSET_GeneralSettings, &container->GeneralSettings);
+	}
+	
+	if (tableMask & TABLE_ScanList) {
+		for (i=0; i<container->ScanList_COUNT && i<250; i++) {
 			encodeBinary_ScanList (buffer, OFFSET_ScanList+i*LENGTH_ScanList, container->ScanList+i);
 		}
-		else {
+		if (i < 250) {
 			encodeBinaryEmpty_ScanList (buffer, OFFSET_ScanList+i*LENGTH_ScanList);
+			binReplicate (buffer+OFFSET_ScanList+i*LENGTH_ScanList, LENGTH_ScanList, 250-i);
 		}
 	}
-	for (i=0; i<50; i++) {
-		if (i < container->TextMessage_COUNT) {
+	
+	if (tableMask & TABLE_TextMessage) {
+		for (i=0; i<container->TextMessage_COUNT && i<50; i++) {
 			encodeBinary_TextMessage (buffer, OFFSET_TextMessage+i*LENGTH_TextMessage, container->TextMessage+i);
 		}
-		else {
+		if (i < 50) {
 			encodeBinaryEmpty_TextMessage (buffer, OFFSET_TextMessage+i*LENGTH_TextMessage);
+			binReplicate (buffer+OFFSET_TextMessage+i*LENGTH_TextMessage, LENGTH_TextMessage, 50-i);
 		}
 	}
-	for (i=0; i<250; i++) {
-		if (i < container->ZoneInformation_COUNT) {
+	
+	if (tableMask & TABLE_ZoneInformation) {
+		for (i=0; i<container->ZoneInformation_COUNT && i<250; i++) {
 			encodeBinary_ZoneInformation (buffer, OFFSET_ZoneInformation+i*LENGTH_ZoneInformation, container->ZoneInformation+i);
 		}
-		else {
+		if (i < 250) {
 			encodeBinaryEmpty_ZoneInformation (buffer, OFFSET_ZoneInformation+i*LENGTH_ZoneInformation);
+			binReplicate (buffer+OFFSET_ZoneInformation+i*LENGTH_ZoneInformation, LENGTH_ZoneInformation, 250-i);
 		}
 	}
+}
 
+/* Encode the record number 'index' of the record type number 'table' (index in RECORDS_TRDTFile) */
+void encodeBinaryRecord_TRDTFile (t_buffer* buffer, unsigned offsetInOctets, const TRDTFile* container, unsigned table, unsigned index)
+{
+	switch (table) {
+		case 0: encodeBinary_ChannelInformation (buffer, offsetInOctets, container->ChannelInformation+index); break;
+		case 1: encodeBinary_DigitalContact (buffer, offsetInOctets, container->DigitalContact+index); break;
+		case 2: encodeBinary_DigitalRxGroupList (buffer, offsetInOctets, container->DigitalRxGroupList+index); break;
+		case 3: encodeBinary_GeneralSettings (buffer, offsetInOctets, &container->GeneralSettings); break;
+		case 4: encodeBinary_ScanList (buffer, offsetInOctets, container->ScanList+index); break;
+		case 5: encodeBinary_TextMessage (buffer, offsetInOctets, container->TextMessage+index); break;
+		case 6: encodeBinary_ZoneInformation (buffer, offsetInOctets, container->ZoneInformation+index); break;
+	}
 }
+
+/* Encode an empty record of the record type number 'table' (index in RECORDS_TRDTFile) */
+void encodeBinaryEmptyRecord_TRDTFile (t_buffer* buffer, unsigned offsetInOctets, unsigned table)
+{
+	switch (table) {
+		case 0: encodeBinaryEmpty_ChannelInformation (buffer, offsetInOctets); break;
+		case 1: encodeBinaryEmpty_DigitalContact (buffer, offsetInOctets); break;
+		case 2: encodeBinaryEmpty_DigitalRxGroupList (buffer, offsetInOctets); break;
+		case 3: encodeBinaryEmpty_GeneralSettings (buffer, offsetInOctets); break;
+		case 4: encodeBinaryEmpty_ScanList (buffer, offsetInOctets); break;
+		case 5: encodeBinaryEmpty_TextMessage (buffer, offsetInOctets); break;
+		case 6: encodeBinaryEmpty_ZoneInformation (buffer, offsetInOctets); break;
+	}
+}
+
+/* Record types held by TRDTFile */
+const RecordDescriptor RECORDS_TRDTFile [NO_OF_RECORDS_TRDTFile] = {
+	{"ChannelInformation", DESC_ChannelInformation, LAYOUT_ChannelInformation, FIELDS_ChannelInformation, sizeof (T_ChannelInformation), COUNT_ChannelInformation, offsetof (TRDTFile, ChannelInformation), offsetof (TRDTFile, ChannelInformation_COUNT), OFFSET_ChannelInformation, COUNT_ChannelInformation*LENGTH_ChannelInformation, TABLE_DigitalContact|TABLE_DigitalRxGroupList|TABLE_ScanList},
+	{"DigitalContact", DESC_DigitalContact, LAYOUT_DigitalContact, FIELDS_DigitalContact, sizeof (T_DigitalContact), COUNT_DigitalContact, offsetof (TRDTFile, DigitalContact), offsetof (TRDTFile, DigitalContact_COUNT), OFFSET_DigitalContact, COUNT_DigitalContact*LENGTH_DigitalContact, 0},
+	{"DigitalRxGroupList", DESC_DigitalRxGroupList, LAYOUT_DigitalRxGroupList, FIELDS_DigitalRxGroupList, sizeof (T_DigitalRxGroupList), COUNT_DigitalRxGroupList, offsetof (TRDTFile, DigitalRxGroupList), offsetof (TRDTFile, DigitalRxGroupList_COUNT), OFFSET_DigitalRxGroupList, COUNT_DigitalRxGroupList*LENGTH_DigitalRxGroupList, TABLE_DigitalContact},
+	{"GeneralSettings", DESC_GeneralSettings, LAYOUT_GeneralSettings, FIELDS_GeneralSettings, sizeof (T_GeneralSettings), COUNT_GeneralSettings, offsetof (TRDTFile, GeneralSettings), RD_NO_COUNT, OFFSET_GeneralSettings, COUNT_GeneralSettings*LENGTH_GeneralSettings, 0},
+	{"ScanList", DESC_ScanList, LAYOUT_ScanList, FIELDS_ScanList, sizeof (T_ScanList), COUNT_ScanList, offsetof (TRDTFile, ScanList), offsetof (TRDTFile, ScanList_COUNT), OFFSET_ScanList, COUNT_ScanList*LENGTH_ScanList, TABLE_ChannelInformation},
+	{"TextMessage", DESC_TextMessage, LAYOUT_TextMessage, FIELDS_TextMessage, sizeof (T_TextMessage), COUNT_TextMessage, offsetof (TRDTFile, TextMessage), offsetof (TRDTFile, TextMessage_COUNT), OFFSET_TextMessage, COUNT_TextMessage*LENGTH_TextMessage, 0},
+	{"ZoneInformation", DESC_ZoneInformation, LAYOUT_ZoneInformation, FIELDS_ZoneInformation, sizeof (T_ZoneInformation), COUNT_ZoneInformation, offsetof (TRDTFile, ZoneInformation), offsetof (TRDTFile, ZoneInformation_COUNT), OFFSET_ZoneInformation, COUNT_ZoneInformation*LENGTH_ZoneInformation, TABLE_ChannelInformation}
+};
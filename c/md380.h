@@ -40,6 +40,46 @@ typedef struct {
 	
 } FieldDescriptor;
 
+/*============================================================================
+	Structure used to locate each field in the T_xxx structure of its record
+	and in the binary record.
+============================================================================*/
+typedef enum {
+	FL_numeric,       /* t_numeric8, t_numeric16 or t_numeric32, see numericSize */
+	FL_reference,     /* t_reference */
+	FL_unicode        /* t_unicode array, zero terminated */
+} FieldLayoutType;
+
+typedef enum {
+	FC_bits,          /* bitsToNumeric, numericToBits */
+	FC_binary,        /* binaryToNumeric, numericToBinary */
+	FC_bcd,           /* BCDToNumeric, numericToBCD */
+	FC_revBcd,        /* RevBCDToNumeric, numericToRevBCD */
+	FC_bcdTones,      /* BCDToNumericForTones, numericToBCDForTones */
+	FC_unicode,       /* binaryToUnicode, unicodeToBinary */
+	FC_ascii          /* asciiBinaryToUnicode, unicodeToAsciiBinary */
+} FieldCodec;
+
+typedef struct {
+	/* Offset of the field within the T_xxx structure */
+	unsigned structOffset;
+	
+	/* Type of the field in the T_xxx structure */
+	FieldLayoutType layoutType;
+	
+	/* Maximum number of characters for FL_unicode fields, 0 otherwise */
+	unsigned unicodeChars;
+	
+	/* Size in octets of FL_numeric fields, 0 otherwise */
+	unsigned numericSize;
+	
+	/* Codec and position in bits of the field within the binary record */
+	FieldCodec codec;
+	unsigned binaryOffsetBits;
+	unsigned binaryLengthBits;
+	
+} FieldLayout;
+
 
 #define FILE_SIZE_TRDTFile 262709
 
@@ -51,46 +91,47 @@ typedef struct {
 
 /* Structure for record ChannelInformation */
 typedef struct {
-	t_numeric LoneWorker;
-	t_numeric Squelch;
-	t_numeric Autoscan;
-	t_numeric Bandwidth;
-	t_numeric ChannelMode;
-	t_numeric Colorcode;
-	t_numeric RepeaterSlot;
-	t_numeric RxOnly;
-	t_numeric AllowTalkaround;
-	t_numeric DataCallConf;
-	t_numeric PrivateCallConf;
-	t_numeric Privacy;
-	t_numeric PrivacyNo;
-	t_numeric DisplayPttId;
-	t_numeric CompressedUdpHdr;
-	t_numeric EmergencyAlarmAck;
-	t_numeric RxRefFrequency;
-	t_numeric AdmintCriteria;
-	t_numeric Power;
-	t_numeric Vox;
-	t_numeric QtReverse;
-	t_numeric ReverseBurst;
-	t_numeric TxRefFrequency;
+	t_numeric8 LoneWorker;
+	t_numeric8 Squelch;
+	t_numeric8 Autoscan;
+	t_numeric8 Bandwidth;
+	t_numeric8 ChannelMode;
+	t_numeric8 Colorcode;
+	t_numeric8 RepeaterSlot;
+	t_numeric8 RxOnly;
+	t_numeric8 AllowTalkaround;
+	t_numeric8 DataCallConf;
+	t_numeric8 PrivateCallConf;
+	t_numeric8 Privacy;
+	t_numeric8 PrivacyNo;
+	t_numeric8 DisplayPttId;
+	t_numeric8 CompressedUdpHdr;
+	t_numeric8 EmergencyAlarmAck;
+	t_numeric8 RxRefFrequency;
+	t_numeric8 AdmintCriteria;
+	t_numeric8 Power;
+	t_numeric8 Vox;
+	t_numeric8 QtReverse;
+	t_numeric8 ReverseBurst;
+	t_numeric8 TxRefFrequency;
 	t_reference ContactName;
-	t_numeric Tot;
-	t_numeric TotRekeyDelay;
-	t_numeric EmergencySystem;
+	t_numeric8 Tot;
+	t_numeric8 TotRekeyDelay;
+	t_numeric8 EmergencySystem;
 	t_reference ScanList;
 	t_reference GroupList;
-	t_numeric Decode18;
-	t_numeric RxFrequency;
-	t_numeric TxFrequency;
-	t_numeric CtcssDcsDecode;
-	t_numeric CtcssDcsEncode;
-	t_numeric TxSignalingSyst;
-	t_numeric RxSignalingSyst;
+	t_numeric8 Decode18;
+	t_numeric32 RxFrequency;
+	t_numeric32 TxFrequency;
+	t_numeric32 CtcssDcsDecode;
+	t_numeric32 CtcssDcsEncode;
+	t_numeric8 TxSignalingSyst;
+	t_numeric8 RxSignalingSyst;
 	t_unicode Name [17];
 } T_ChannelInformation;
 
 extern FieldDescriptor DESC_ChannelInformation [FIELDS_ChannelInformation];
+extern const FieldLayout LAYOUT_ChannelInformation [FIELDS_ChannelInformation];
 
 /* Function that decodes a binary record into the structure */
 extern void decodeBinary_ChannelInformation (const t_buffer* buffer, unsigned offsetInOctets, T_ChannelInformation* record);
@@ -109,13 +150,14 @@ extern void encodeBinaryEmpty_ChannelInformation (t_buffer* buffer, unsigned off
 
 /* Structure for record DigitalContact */
 typedef struct {
-	t_numeric CallId;
-	t_numeric CallReceiveTone;
-	t_numeric CallType;
+	t_numeric32 CallId;
+	t_numeric8 CallReceiveTone;
+	t_numeric8 CallType;
 	t_unicode Name [17];
 } T_DigitalContact;
 
 extern FieldDescriptor DESC_DigitalContact [FIELDS_DigitalContact];
+extern const FieldLayout LAYOUT_DigitalContact [FIELDS_DigitalContact];
 
 /* Function that decodes a binary record into the structure */
 extern void decodeBinary_DigitalContact (const t_buffer* buffer, unsigned offsetInOctets, T_DigitalContact* record);
@@ -139,6 +181,7 @@ typedef struct {
 } T_DigitalRxGroupList;
 
 extern FieldDescriptor DESC_DigitalRxGroupList [FIELDS_DigitalRxGroupList];
+extern const FieldLayout LAYOUT_DigitalRxGroupList [FIELDS_DigitalRxGroupList];
 
 /* Function that decodes a binary record into the structure */
 extern void decodeBinary_DigitalRxGroupList (const t_buffer* buffer, unsigned offsetInOctets, T_DigitalRxGroupList* record);
@@ -159,36 +202,37 @@ extern void encodeBinaryEmpty_DigitalRxGroupList (t_buffer* buffer, unsigned off
 typedef struct {
 	t_unicode InfoScreenLine1 [11];
 	t_unicode InfoScreenLine2 [11];
-	t_numeric MonitorType;
-	t_numeric DisableAllLeds;
-	t_numeric TalkPermitTone;
-	t_numeric PasswordAndLockEnable;
-	t_numeric CHFreeIndicationTone;
-	t_numeric DisableAllTone;
-	t_numeric SaveModeReceive;
-	t_numeric SavePreamble;
-	t_numeric IntroScreen;
-	t_numeric RadioId;
-	t_numeric TxPreamble;
-	t_numeric GroupCallHangTime;
-	t_numeric PrivateCallHangTime;
-	t_numeric VoxSensitivity;
-	t_numeric RxLowBatteryInterval;
-	t_numeric CallAlertTone;
-	t_numeric LoneWorkerRespTime;
-	t_numeric LoneWorkerReminderTime;
-	t_numeric ScanDigitalHangTime;
-	t_numeric ScanAnalogHangTime;
-	t_numeric Unknown1;
-	t_numeric KeypadLockTime;
-	t_numeric Mode;
-	t_numeric PowerOnPassword;
-	t_numeric RadioProgPassowrd;
+	t_numeric8 MonitorType;
+	t_numeric8 DisableAllLeds;
+	t_numeric8 TalkPermitTone;
+	t_numeric8 PasswordAndLockEnable;
+	t_numeric8 CHFreeIndicationTone;
+	t_numeric8 DisableAllTone;
+	t_numeric8 SaveModeReceive;
+	t_numeric8 SavePreamble;
+	t_numeric8 IntroScreen;
+	t_numeric32 RadioId;
+	t_numeric8 TxPreamble;
+	t_numeric8 GroupCallHangTime;
+	t_numeric8 PrivateCallHangTime;
+	t_numeric8 VoxSensitivity;
+	t_numeric8 RxLowBatteryInterval;
+	t_numeric8 CallAlertTone;
+	t_numeric8 LoneWorkerRespTime;
+	t_numeric8 LoneWorkerReminderTime;
+	t_numeric8 ScanDigitalHangTime;
+	t_numeric8 ScanAnalogHangTime;
+	t_numeric8 Unknown1;
+	t_numeric8 KeypadLockTime;
+	t_numeric8 Mode;
+	t_numeric32 PowerOnPassword;
+	t_numeric32 RadioProgPassowrd;
 	t_unicode PcProgPassword [9];
 	t_unicode RadioName [17];
 } T_GeneralSettings;
 
 extern FieldDescriptor DESC_GeneralSettings [FIELDS_GeneralSettings];
+extern const FieldLayout LAYOUT_GeneralSettings [FIELDS_GeneralSettings];
 
 /* Function that decodes a binary record into the structure */
 extern void decodeBinary_GeneralSettings (const t_buffer* buffer, unsigned offsetInOctets, T_GeneralSettings* record);
@@ -211,12 +255,13 @@ typedef struct {
 	t_reference PriorityCh1;
 	t_reference PriorityCh2;
 	t_reference TXDesignatedCh;
-	t_numeric SignHoldTime;
-	t_numeric PrioSamplTime;
+	t_numeric8 SignHoldTime;
+	t_numeric8 PrioSamplTime;
 	t_reference ChannelMember[31];
 } T_ScanList;
 
 extern FieldDescriptor DESC_ScanList [FIELDS_ScanList];
+extern const FieldLayout LAYOUT_ScanList [FIELDS_ScanList];
 
 /* Function that decodes a binary record into the structure */
 extern void decodeBinary_ScanList (const t_buffer* buffer, unsigned offsetInOctets, T_ScanList* record);
@@ -239,6 +284,7 @@ typedef struct {
 } T_TextMessage;
 
 extern FieldDescriptor DESC_TextMessage [FIELDS_TextMessage];
+extern const FieldLayout LAYOUT_TextMessage [FIELDS_TextMessage];
 
 /* Function that decodes a binary record into the structure */
 extern void decodeBinary_TextMessage (const t_buffer* buffer, unsigned offsetInOctets, T_TextMessage* record);
@@ -262,6 +308,7 @@ typedef struct {
 } T_ZoneInformation;
 
 extern FieldDescriptor DESC_ZoneInformation [FIELDS_ZoneInformation];
+extern const FieldLayout LAYOUT_ZoneInformation [FIELDS_ZoneInformation];
 
 /* Function that decodes a binary record into the structure */
 extern void decodeBinary_ZoneInformation (const t_buffer* buffer, unsigned offsetInOctets, T_ZoneInformation* record);
@@ -299,7 +346,69 @@ typedef struct {
 /* Decode a binary file; its size must be FILE_SIZE_TRDTFile */
 extern void decodeBinary_TRDTFile (const t_buffer* buffer, TRDTFile* container);
 
+/* Decode only the record types selected by tableMask (TABLE_xxx bits); */
+/* the other record types in the container are left untouched */
+extern void decodeBinaryTables_TRDTFile (const t_buffer* buffer, TRDTFile* container, unsigned tableMask);
+
 /* Encode a binary file; its size must be FILE_SIZE_TRDTFile */
 extern void encodeBinary_TRDTFile (t_buffer* buffer, const TRDTFile* container);
 
+/* Encode only the record types selected by tableMask (TABLE_xxx bits); */
+/* the other regions of the buffer are left untouched */
+extern void encodeBinaryTables_TRDTFile (t_buffer* buffer, const TRDTFile* container, unsigned tableMask);
+
+/* Encode the record number 'index' of the record type number 'table' (index in RECORDS_TRDTFile) */
+extern void encodeBinaryRecord_TRDTFile (t_buffer* buffer, unsigned offsetInOctets, const TRDTFile* container, unsigned table, unsigned index);
+
+/* Encode an empty record of the record type number 'table' (index in RECORDS_TRDTFile) */
+extern void encodeBinaryEmptyRecord_TRDTFile (t_buffer* buffer, unsigned offsetInOctets, unsigned table);
+
+/*============================================================================
+	Structure used to describe each record type in the container.
+============================================================================*/
+typedef struct {
+	/* Name of the record */
+	const char* recordName;
+	
+	/* Field tables of the record */
+	const FieldDescriptor* fieldDescriptors;
+	const FieldLayout* fieldLayouts;
+	unsigned noOfFields;
+	
+	/* Size of the T_xxx structure */
+	unsigned recordSize;
+	
+	/* Maximum number of records (COUNT_xxx) */
+	unsigned maxCount;
+	
+	/* Offset in TRDTFile of the first record and of its xxx_COUNT */
+	/* field; countOffset is RD_NO_COUNT for single records */
+	unsigned containerOffset;
+	unsigned countOffset;
+	
+	/* Region of the binary file holding all the records */
+	unsigned binaryOffset;
+	unsigned binaryLength;
+	
+	/* TABLE_xxx bits of the record types referenced by this record */
+	unsigned referencedTables;
+	
+} RecordDescriptor;
+
+#define RD_NO_COUNT 0xFFFFFFFF
+
+/* Record types held by TRDTFile */
+#define NO_OF_RECORDS_TRDTFile 7
+extern const RecordDescriptor RECORDS_TRDTFile [NO_OF_RECORDS_TRDTFile];
+
+/* Bit masks selecting record types; bit n refers to RECORDS_TRDTFile[n] */
+#define TABLE_ChannelInformation (1u << 0)
+#define TABLE_DigitalContact (1u << 1)
+#define TABLE_DigitalRxGroupList (1u << 2)
+#define TABLE_GeneralSettings (1u << 3)
+#define TABLE_ScanList (1u << 4)
+#define TABLE_TextMessage (1u << 5)
+#define TABLE_ZoneInformation (1u << 6)
+#define TABLES_ALL_TRDTFile ((1u << NO_OF_RECORDS_TRDTFile) - 1)
+
 #endif
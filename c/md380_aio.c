@@ -0,0 +1,759 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_aio.h"
+#include "md380_stats.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <assert.h>
+
+#ifndef _WIN32
+#define AIO_HAVE_THREADS
+#include <pthread.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define AIO_HAVE_URING
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#endif
+#endif
+
+/* The first MD380_AIO_READ_AHEAD slots read, the others write */
+#define AIO_NO_OF_SLOTS (MD380_AIO_READ_AHEAD+MD380_AIO_MAX_WRITES)
+
+/* States of a slot */
+#define AIO_FREE     0
+#define AIO_QUEUED   1  /* waiting for a thread */
+#define AIO_RUNNING  2  /* taken by a thread or submitted to io_uring */
+#define AIO_DONE     3  /* completed, result not yet taken */
+
+#define AIO_READ     0
+#define AIO_WRITE    1
+
+typedef struct {
+	int state;
+	int kind;
+	unsigned sequence;
+	char* fileName;
+	
+	/* Image read, or content to be written */
+	MD380_MemBuffer data;
+	
+	/* Octets to be transferred and transferred so far */
+	unsigned total;
+	unsigned done;
+	
+	/* errno of the failed operation, 0 if none */
+	int error;
+	
+#ifdef AIO_HAVE_URING
+	int fd;
+	struct iovec iov;
+#endif
+} AioSlot;
+
+#ifdef AIO_HAVE_URING
+/* The rings shared with the kernel */
+typedef struct {
+	int fd;
+	unsigned* sqTail;
+	unsigned sqMask;
+	unsigned* sqArray;
+	unsigned* cqHead;
+	unsigned* cqTail;
+	unsigned cqMask;
+	struct io_uring_sqe* sqes;
+	struct io_uring_cqe* cqes;
+	void* sqRing;
+	void* cqRing;
+	size_t sqRingSize;
+	size_t cqRingSize;
+	size_t sqesSize;
+	
+	/* Entries written and not yet taken by the kernel */
+	unsigned noOfUnsubmitted;
+} AioRing;
+#endif
+
+struct MD380_AioState {
+	int backend;
+	AioSlot slots [AIO_NO_OF_SLOTS];
+	unsigned sequence;
+	
+	/* First write failed since the last flush, NULL if none */
+	char* errorMessage;
+	
+	/* Buffer of md380_AioSaveCSVFiles, swapped with the slots */
+	MD380_MemBuffer spare;
+	
+#ifdef AIO_HAVE_THREADS
+	pthread_mutex_t mutex;
+	pthread_cond_t queued;
+	pthread_cond_t done;
+	pthread_t threads [MD380_AIO_NO_OF_THREADS];
+	unsigned noOfThreads;
+	int stopping;
+#endif
+#ifdef AIO_HAVE_URING
+	AioRing ring;
+#endif
+};
+
+/*=========================================================================
+	Allocates the error message of a file
+=========================================================================*/
+static int md380_AioError (char** errorMessage, const char* text, const char* fileName, int error, int ret)
+{
+	const char* reason = strerror (error);
+	(*errorMessage) = (char*)binAlloc (strlen (text)+strlen (fileName)+strlen (reason)+16);
+	if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
+	sprintf ((*errorMessage), "%s '%s': %s", text, fileName, reason);
+	return ret;
+}
+
+/*=========================================================================
+	Runs the operation of a slot with blocking calls
+=========================================================================*/
+static void md380_AioRun (AioSlot* s)
+{
+	FILE* f;
+	
+	s->error = 0;
+	if (s->kind == AIO_READ) {
+		f = fopen (s->fileName, "rb");
+		if (f == NULL) {s->error = errno; return;}
+		/* One octet more than the largest image, to catch longer files */
+		s->data.length = (unsigned)fread (s->data.data, 1, s->data.allocated, f);
+		if (ferror (f)) s->error = EIO;
+		fclose (f);
+	}
+	else {
+		f = fopen (s->fileName, "wb");
+		if (f == NULL) {s->error = errno; return;}
+		if (fwrite (s->data.data, 1, s->data.length, f) != s->data.length || fflush (f)) s->error = (errno ? errno : EIO);
+		if (fclose (f) && s->error == 0) s->error = (errno ? errno : EIO);
+	}
+}
+
+#ifdef AIO_HAVE_THREADS
+/*=========================================================================
+	Thread of the pool: runs the queued slots in order
+=========================================================================*/
+static void* md380_AioThread (void* param)
+{
+	MD380_AioState* st = (MD380_AioState*)param;
+	
+	pthread_mutex_lock (&st->mutex);
+	for (;;) {
+		AioSlot* s = NULL;
+		unsigned i;
+		for (i=0; i<AIO_NO_OF_SLOTS; i++) {
+			AioSlot* q = st->slots+i;
+			if (q->state == AIO_QUEUED && (s == NULL || (int)(q->sequence - s->sequence) < 0)) s = q;
+		}
+		if (s == NULL) {
+			if (st->stopping) break;
+			pthread_cond_wait (&st->queued, &st->mutex);
+			continue;
+		}
+		s->state = AIO_RUNNING;
+		pthread_mutex_unlock (&st->mutex);
+		md380_AioRun (s);
+		pthread_mutex_lock (&st->mutex);
+		s->state = AIO_DONE;
+		pthread_cond_broadcast (&st->done);
+	}
+	pthread_mutex_unlock (&st->mutex);
+	return NULL;
+}
+#endif
+
+#ifdef AIO_HAVE_URING
+/*=========================================================================
+	io_uring, without liburing: the rings are mapped as documented in
+	io_uring_setup(2). Only IORING_OP_READV and IORING_OP_WRITEV are
+	used, available since the first kernel having io_uring (5.1); the
+	files are opened by the calling thread.
+=========================================================================*/
+static void md380_AioRingClose (AioRing* r)
+{
+	if (r->sqes) munmap (r->sqes, r->sqesSize);
+	if (r->cqRing && r->cqRing != r->sqRing) munmap (r->cqRing, r->cqRingSize);
+	if (r->sqRing) munmap (r->sqRing, r->sqRingSize);
+	if (r->fd >= 0) close (r->fd);
+	memset (r, 0, sizeof (*r));
+	r->fd = -1;
+}
+
+/* Returns 0=ok, else the errno */
+static int md380_AioRingSetup (AioRing* r, unsigned entries)
+{
+	struct io_uring_params p;
+	void* m;
+	int error;
+	
+	memset (r, 0, sizeof (*r));
+	memset (&p, 0, sizeof (p));
+	r->fd = (int)syscall (__NR_io_uring_setup, entries, &p);
+	if (r->fd < 0) return errno;
+	
+	r->sqRingSize = p.sq_off.array + p.sq_entries*sizeof (unsigned);
+	r->cqRingSize = p.cq_off.cqes + p.cq_entries*sizeof (struct io_uring_cqe);
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		if (r->cqRingSize > r->sqRingSize) r->sqRingSize = r->cqRingSize;
+		r->cqRingSize = r->sqRingSize;
+	}
+	m = mmap (NULL, r->sqRingSize, PROT_READ|PROT_WRITE, MAP_SHARED, r->fd, IORING_OFF_SQ_RING);
+	if (m == MAP_FAILED) goto errorExit;
+	r->sqRing = m;
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		r->cqRing = r->sqRing;
+	}
+	else {
+		m = mmap (NULL, r->cqRingSize, PROT_READ|PROT_WRITE, MAP_SHARED, r->fd, IORING_OFF_CQ_RING);
+		if (m == MAP_FAILED) goto errorExit;
+		r->cqRing = m;
+	}
+	r->sqesSize = p.sq_entries*sizeof (struct io_uring_sqe);
+	m = mmap (NULL, r->sqesSize, PROT_READ|PROT_WRITE, MAP_SHARED, r->fd, IORING_OFF_SQES);
+	if (m == MAP_FAILED) goto errorExit;
+	r->sqes = (struct io_uring_sqe*)m;
+	
+	r->sqTail = (unsigned*)((char*)r->sqRing + p.sq_off.tail);
+	r->sqMask = *(unsigned*)((char*)r->sqRing + p.sq_off.ring_mask);
+	r->sqArray = (unsigned*)((char*)r->sqRing + p.sq_off.array);
+	r->cqHead = (unsigned*)((char*)r->cqRing + p.cq_off.head);
+	r->cqTail = (unsigned*)((char*)r->cqRing + p.cq_off.tail);
+	r->cqMask = *(unsigned*)((char*)r->cqRing + p.cq_off.ring_mask);
+	r->cqes = (struct io_uring_cqe*)((char*)r->cqRing + p.cq_off.cqes);
+	return 0;
+
+errorExit:
+	error = errno;
+	md380_AioRingClose (r);
+	return error;
+}
+
+/* Hands the entries written to the kernel and, if 'wait', waits for a completion */
+static void md380_AioRingEnter (AioRing* r, int wait)
+{
+	for (;;) {
+		int n = (int)syscall (__NR_io_uring_enter, r->fd, r->noOfUnsubmitted, (wait ? 1 : 0), (wait ? IORING_ENTER_GETEVENTS : 0), NULL, 0);
+		if (n >= 0) {
+			r->noOfUnsubmitted -= (unsigned)n;
+			return;
+		}
+		/* Else out of resources: submitted with the next call */
+		if (errno != EINTR) return;
+	}
+}
+
+/* Writes the entry of the next part of the operation of slot 's' */
+static void md380_AioRingQueue (MD380_AioState* st, AioSlot* s)
+{
+	AioRing* r = &st->ring;
+	unsigned tail = *r->sqTail;
+	unsigned index = tail & r->sqMask;
+	struct io_uring_sqe* sqe = r->sqes+index;
+	
+	s->iov.iov_base = s->data.data + s->done;
+	s->iov.iov_len = s->total - s->done;
+	memset (sqe, 0, sizeof (*sqe));
+	sqe->opcode = (s->kind == AIO_READ ? IORING_OP_READV : IORING_OP_WRITEV);
+	sqe->fd = s->fd;
+	sqe->addr = (uint64_t)(uintptr_t)&s->iov;
+	sqe->len = 1;
+	sqe->off = s->done;
+	sqe->user_data = (uint64_t)(s - st->slots);
+	r->sqArray[index] = index;
+	__atomic_store_n (r->sqTail, tail+1, __ATOMIC_RELEASE);
+	r->noOfUnsubmitted++;
+}
+
+/* Ends the operation of slot 's' */
+static void md380_AioRingDone (AioSlot* s, int error)
+{
+	if (s->fd >= 0) {
+		if (close (s->fd) && error == 0 && s->kind == AIO_WRITE) error = errno;
+		s->fd = -1;
+	}
+	if (s->kind == AIO_READ) s->data.length = s->done;
+	s->error = error;
+	s->state = AIO_DONE;
+}
+
+/* Opens the file of slot 's' and submits its first part */
+static void md380_AioRingStart (MD380_AioState* st, AioSlot* s)
+{
+	struct stat sb;
+	
+	s->done = 0;
+	s->error = 0;
+	s->state = AIO_RUNNING;
+	if (s->kind == AIO_READ) {
+		s->fd = open (s->fileName, O_RDONLY);
+		if (s->fd < 0) {md380_AioRingDone (s, errno); return;}
+		if (fstat (s->fd, &sb)) {md380_AioRingDone (s, errno); return;}
+		/* Longer than the largest image: taken as a failed read */
+		if ((unsigned long long)sb.st_size >= s->data.allocated) {md380_AioRingDone (s, EFBIG); return;}
+		s->total = (unsigned)sb.st_size;
+	}
+	else {
+		s->fd = open (s->fileName, O_WRONLY|O_CREAT|O_TRUNC, 0666);
+		if (s->fd < 0) {md380_AioRingDone (s, errno); return;}
+		s->total = s->data.length;
+	}
+	if (s->total == 0) {md380_AioRingDone (s, 0); return;}
+	md380_AioRingQueue (st, s);
+	md380_AioRingEnter (&st->ring, 0);
+}
+
+/* Takes the completions, continuing the partial transfers */
+static void md380_AioRingReap (MD380_AioState* st)
+{
+	AioRing* r = &st->ring;
+	unsigned head = *r->cqHead;
+	unsigned tail = __atomic_load_n (r->cqTail, __ATOMIC_ACQUIRE);
+	
+	while (head != tail) {
+		const struct io_uring_cqe* cqe = r->cqes + (head & r->cqMask);
+		AioSlot* s = st->slots + cqe->user_data;
+		int res = cqe->res;
+		head++;
+		if (res < 0) {
+			md380_AioRingDone (s, -res);
+		}
+		else if (res == 0) {
+			/* Short file: the image is found invalid when taken */
+			md380_AioRingDone (s, (s->kind == AIO_WRITE ? EIO : 0));
+		}
+		else {
+			s->done += (unsigned)res;
+			if (s->done < s->total) md380_AioRingQueue (st, s);
+			else md380_AioRingDone (s, 0);
+		}
+	}
+	__atomic_store_n (r->cqHead, head, __ATOMIC_RELEASE);
+	if (r->noOfUnsubmitted) md380_AioRingEnter (r, 0);
+}
+#endif
+
+/*=========================================================================
+	Locking, needed only by the threads
+=========================================================================*/
+static void md380_AioLock (MD380_AioState* st)
+{
+#ifdef AIO_HAVE_THREADS
+	if (st->backend == MD380_AIO_THREADS) pthread_mutex_lock (&st->mutex);
+#endif
+}
+
+static void md380_AioUnlock (MD380_AioState* st)
+{
+#ifdef AIO_HAVE_THREADS
+	if (st->backend == MD380_AIO_THREADS) pthread_mutex_unlock (&st->mutex);
+#endif
+}
+
+/*=========================================================================
+	Starts the operation of slot 's' (locked)
+=========================================================================*/
+static void md380_AioStart (MD380_AioState* st, AioSlot* s)
+{
+	s->sequence = st->sequence++;
+	switch (st->backend) {
+#ifdef AIO_HAVE_THREADS
+		case MD380_AIO_THREADS:
+			s->state = AIO_QUEUED;
+			pthread_cond_signal (&st->queued);
+			break;
+#endif
+#ifdef AIO_HAVE_URING
+		case MD380_AIO_URING:
+			md380_AioRingStart (st, s);
+			break;
+#endif
+		default:
+			md380_AioRun (s);
+			s->state = AIO_DONE;
+			break;
+	}
+}
+
+/*=========================================================================
+	Waits for the completion of any operation (locked)
+=========================================================================*/
+static void md380_AioWait (MD380_AioState* st)
+{
+	switch (st->backend) {
+#ifdef AIO_HAVE_THREADS
+		case MD380_AIO_THREADS:
+			pthread_cond_wait (&st->done, &st->mutex);
+			break;
+#endif
+#ifdef AIO_HAVE_URING
+		case MD380_AIO_URING:
+			md380_AioRingEnter (&st->ring, 1);
+			md380_AioRingReap (st);
+			break;
+#endif
+		default:
+			/* The synchronous operations are always done */
+			assert (0);
+			break;
+	}
+}
+
+/*=========================================================================
+	Frees a completed slot (locked); the first write error is kept
+=========================================================================*/
+static void md380_AioRelease (MD380_AioState* st, AioSlot* s)
+{
+	assert (s->state == AIO_DONE);
+	if (s->kind == AIO_WRITE && s->error && st->errorMessage == NULL) {
+		md380_AioError (&st->errorMessage, "Error writing file", s->fileName, s->error, MD380ERR_FILE_ERROR);
+	}
+	binFree (s->fileName);
+	s->fileName = NULL;
+	s->data.length = 0;
+	s->state = AIO_FREE;
+}
+
+/* Returns the slot with an operation on 'fileName', NULL if none */
+static AioSlot* md380_AioFind (MD380_AioState* st, const char* fileName)
+{
+	unsigned i;
+	for (i=0; i<AIO_NO_OF_SLOTS; i++) {
+		AioSlot* s = st->slots+i;
+		if (s->state != AIO_FREE && strcmp (s->fileName, fileName) == 0) return s;
+	}
+	return NULL;
+}
+
+/* Waits for slot 's' to complete and frees it (locked) */
+static void md380_AioComplete (MD380_AioState* st, AioSlot* s)
+{
+	while (s->state != AIO_DONE) md380_AioWait (st);
+	md380_AioRelease (st, s);
+}
+
+/*=========================================================================
+	Init and free
+=========================================================================*/
+void INIT_MD380_Aio (MD380_Aio* aio)
+{
+	aio->state = NULL;
+}
+
+void FREE_MD380_Aio (MD380_Aio* aio)
+{
+	MD380_AioState* st = aio->state;
+	unsigned i;
+	
+	if (st == NULL) return;
+	md380_AioLock (st);
+	for (i=0; i<AIO_NO_OF_SLOTS; i++) {
+		if (st->slots[i].state != AIO_FREE) md380_AioComplete (st, st->slots+i);
+	}
+#ifdef AIO_HAVE_THREADS
+	st->stopping = 1;
+	if (st->backend == MD380_AIO_THREADS) pthread_cond_broadcast (&st->queued);
+#endif
+	md380_AioUnlock (st);
+	
+#ifdef AIO_HAVE_THREADS
+	for (i=0; i<st->noOfThreads; i++) pthread_join (st->threads[i], NULL);
+	pthread_cond_destroy (&st->done);
+	pthread_cond_destroy (&st->queued);
+	pthread_mutex_destroy (&st->mutex);
+#endif
+#ifdef AIO_HAVE_URING
+	if (st->backend == MD380_AIO_URING) md380_AioRingClose (&st->ring);
+#endif
+	for (i=0; i<AIO_NO_OF_SLOTS; i++) FREE_MD380_MemBuffer (&st->slots[i].data);
+	FREE_MD380_MemBuffer (&st->spare);
+	if (st->errorMessage) binFree (st->errorMessage);
+	binFree (st);
+	aio->state = NULL;
+}
+
+/*=========================================================================
+	Starts the backend
+=========================================================================*/
+int md380_StartAio (MD380_Aio* aio, int backend, char** errorMessage)
+{
+	MD380_AioState* st;
+	int ret = CSVRET_OK;
+	unsigned i;
+	
+	assert (aio->state == NULL);
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	st = (MD380_AioState*)binAlloc (sizeof (MD380_AioState));
+	if (st == NULL) return CSVRET_OUT_OF_MEMORY;
+	memset (st, 0, sizeof (*st));
+	st->backend = MD380_AIO_SYNC;
+	for (i=0; i<AIO_NO_OF_SLOTS; i++) {
+		INIT_MD380_MemBuffer (&st->slots[i].data);
+		#ifdef AIO_HAVE_URING
+		st->slots[i].fd = -1;
+		#endif
+	}
+	INIT_MD380_MemBuffer (&st->spare);
+	#ifdef AIO_HAVE_THREADS
+	pthread_mutex_init (&st->mutex, NULL);
+	pthread_cond_init (&st->queued, NULL);
+	pthread_cond_init (&st->done, NULL);
+	#endif
+	#ifdef AIO_HAVE_URING
+	st->ring.fd = -1;
+	#endif
+	aio->state = st;
+	
+	/* The images are read whole, with one octet more to catch longer files */
+	for (i=0; i<MD380_AIO_READ_AHEAD; i++) {
+		if (md380_ReserveMemBuffer (&st->slots[i].data, FILE_SIZE_TRDTFile+1)) {
+			ret = CSVRET_OUT_OF_MEMORY;
+			goto errorExit;
+		}
+	}
+	
+	if (backend == MD380_AIO_AUTO || backend == MD380_AIO_URING) {
+		#ifdef AIO_HAVE_URING
+		int error = md380_AioRingSetup (&st->ring, AIO_NO_OF_SLOTS);
+		if (error == 0) {
+			st->backend = MD380_AIO_URING;
+		}
+		else if (backend == MD380_AIO_URING) {
+			ret = md380_AioError (errorMessage, "Asynchronous I/O", "io_uring", error, MD380ERR_FILE_ERROR);
+			goto errorExit;
+		}
+		#else
+		if (backend == MD380_AIO_URING) {
+			ret = md380_AioError (errorMessage, "Asynchronous I/O", "io_uring", ENOSYS, MD380ERR_FILE_ERROR);
+			goto errorExit;
+		}
+		#endif
+	}
+	
+	if ((backend == MD380_AIO_AUTO && st->backend != MD380_AIO_URING) || backend == MD380_AIO_THREADS) {
+		#ifdef AIO_HAVE_THREADS
+		for (st->noOfThreads=0; st->noOfThreads<MD380_AIO_NO_OF_THREADS; st->noOfThreads++) {
+			if (pthread_create (st->threads+st->noOfThreads, NULL, md380_AioThread, st)) break;
+		}
+		/* With some threads it works anyway */
+		if (st->noOfThreads) st->backend = MD380_AIO_THREADS;
+		#endif
+		if (st->backend != MD380_AIO_THREADS && backend == MD380_AIO_THREADS) {
+			ret = md380_AioError (errorMessage, "Asynchronous I/O", "threads", ENOSYS, MD380ERR_FILE_ERROR);
+			goto errorExit;
+		}
+	}
+	return CSVRET_OK;
+
+errorExit:
+	FREE_MD380_Aio (aio);
+	return ret;
+}
+
+const char* md380_AioBackendName (const MD380_Aio* aio)
+{
+	switch (aio->state ? aio->state->backend : MD380_AIO_SYNC) {
+		case MD380_AIO_URING: return "io_uring";
+		case MD380_AIO_THREADS: return "threads";
+		default: return "sync";
+	}
+}
+
+/*=========================================================================
+	Read ahead
+=========================================================================*/
+int md380_AioPrefetch (MD380_Aio* aio, const char* fileName)
+{
+	MD380_AioState* st = aio->state;
+	AioSlot* s = NULL;
+	unsigned i;
+	
+	if (st == NULL || st->backend == MD380_AIO_SYNC) return 0;
+	md380_AioLock (st);
+	if (md380_AioFind (st, fileName) == NULL) {
+		for (i=0; i<MD380_AIO_READ_AHEAD; i++) {
+			if (st->slots[i].state == AIO_FREE) {s = st->slots+i; break;}
+		}
+	}
+	if (s) {
+		s->fileName = (char*)binAlloc (strlen (fileName)+1);
+		if (s->fileName) {
+			strcpy (s->fileName, fileName);
+			s->kind = AIO_READ;
+			md380_AioStart (st, s);
+		}
+		else {
+			s = NULL;
+		}
+	}
+	md380_AioUnlock (st);
+	return (s != NULL);
+}
+
+int md380_AioTakeImage (MD380_Aio* aio, const char* fileName, t_buffer* rdtBinFile, unsigned* offset, unsigned* length)
+{
+	MD380_AioState* st = aio->state;
+	AioSlot* s;
+	int ret = CSVRET_EOF;
+	
+	if (st == NULL) return CSVRET_EOF;
+	md380_AioLock (st);
+	s = md380_AioFind (st, fileName);
+	if (s && s->kind == AIO_READ) {
+		while (s->state != AIO_DONE) md380_AioWait (st);
+		if (s->error == 0 && md380_ImageLayout (s->data.length, offset, length) == CSVRET_OK) {
+			memset (rdtBinFile, 0, FILE_SIZE_TRDTFile);
+			memcpy (rdtBinFile+(*offset), s->data.data, (*length));
+			MD380_STATS_ADD (bytesRead, (*length));
+			ret = CSVRET_OK;
+		}
+		md380_AioRelease (st, s);
+	}
+	md380_AioUnlock (st);
+	return ret;
+}
+
+void md380_AioDrop (MD380_Aio* aio, const char* fileName)
+{
+	MD380_AioState* st = aio->state;
+	AioSlot* s;
+	
+	if (st == NULL) return;
+	md380_AioLock (st);
+	s = md380_AioFind (st, fileName);
+	if (s && s->kind == AIO_READ) md380_AioComplete (st, s);
+	md380_AioUnlock (st);
+}
+
+/*=========================================================================
+	Write behind
+=========================================================================*/
+int md380_AioWrite (MD380_Aio* aio, const char* fileName, MD380_MemBuffer* data, char** errorMessage)
+{
+	MD380_AioState* st = aio->state;
+	MD380_MemBuffer b;
+	AioSlot* s;
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	MD380_STATS_ADD (bytesWritten, data->length);
+	if (st == NULL) {
+		AioSlot w;
+		memset (&w, 0, sizeof (w));
+		w.kind = AIO_WRITE;
+		w.fileName = (char*)fileName;
+		w.data = (*data);
+		md380_AioRun (&w);
+		if (w.error) return md380_AioError (errorMessage, "Error writing file", fileName, w.error, MD380ERR_FILE_ERROR);
+		return CSVRET_OK;
+	}
+	
+	md380_AioLock (st);
+	
+	/* The previous operation on the same file completes first */
+	s = md380_AioFind (st, fileName);
+	if (s) md380_AioComplete (st, s);
+	
+	/* A free slot, freeing the completed ones */
+	for (;;) {
+		AioSlot* done = NULL;
+		s = NULL;
+		for (i=MD380_AIO_READ_AHEAD; i<AIO_NO_OF_SLOTS && s == NULL; i++) {
+			if (st->slots[i].state == AIO_FREE) s = st->slots+i;
+			else if (st->slots[i].state == AIO_DONE && done == NULL) done = st->slots+i;
+		}
+		if (s) break;
+		if (done) md380_AioRelease (st, done);
+		else md380_AioWait (st);
+	}
+	
+	s->fileName = (char*)binAlloc (strlen (fileName)+1);
+	if (s->fileName == NULL) {
+		md380_AioUnlock (st);
+		return CSVRET_OUT_OF_MEMORY;
+	}
+	strcpy (s->fileName, fileName);
+	b = s->data;
+	s->data = (*data);
+	(*data) = b;
+	s->kind = AIO_WRITE;
+	md380_AioStart (st, s);
+	md380_AioUnlock (st);
+	return CSVRET_OK;
+}
+
+int md380_AioFlush (MD380_Aio* aio, char** errorMessage)
+{
+	MD380_AioState* st = aio->state;
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	if (st == NULL) return CSVRET_OK;
+	md380_AioLock (st);
+	for (i=MD380_AIO_READ_AHEAD; i<AIO_NO_OF_SLOTS; i++) {
+		if (st->slots[i].state != AIO_FREE) md380_AioComplete (st, st->slots+i);
+	}
+	md380_AioUnlock (st);
+	if (st->errorMessage) {
+		(*errorMessage) = st->errorMessage;
+		st->errorMessage = NULL;
+		return MD380ERR_FILE_ERROR;
+	}
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	CSV files
+=========================================================================*/
+int md380_AioSaveCSVFiles (MD380_Aio* aio, CSVFileNames* csvFileNames, const TRDTFile* container, char separator, char** errorMessage)
+{
+	MD380_AioState* st = aio->state;
+	int ret = CSVRET_OK;
+	unsigned i;
+	
+	if (st == NULL) return saveCSVFileAll (csvFileNames, container, separator, errorMessage);
+	for (i=0; i<NO_OF_CSV_STREAMS && ret == CSVRET_OK; i++) {
+		const char* fileName = *PATH_CSVFileNames (csvFileNames, i);
+		if (fileName == NULL) continue;
+		st->spare.length = 0;
+		ret = csvStreamFuncs[i].saveCSVStream (fileName, container, separator, md380_MemWriteBinaryFunc, &st->spare, errorMessage);
+		if (ret == CSVRET_OK) ret = md380_AioWrite (aio, fileName, &st->spare, errorMessage);
+	}
+	return ret;
+}
@@ -0,0 +1,130 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_AIO_H
+#define __MD380_AIO_H
+#include "md380_lib.h"
+#include "md380_file.h"
+#include "md380_cli.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Asynchronous file I/O for the jobs file.
+	
+	While a job is decoding its image, the images of the following jobs
+	are read ahead, and the CSV files written by the jobs are queued
+	instead of being waited for, so that the conversions do not stop on
+	the storage. The operations are run by one of the backends:
+	
+	    MD380_AIO_URING    io_uring of Linux, through its system calls;
+	                       the operations are submitted and completed by
+	                       the calling thread
+	    MD380_AIO_THREADS  a pool of MD380_AIO_NO_OF_THREADS threads
+	                       doing the blocking reads and writes
+	    MD380_AIO_SYNC     no asynchronous I/O: nothing is read ahead
+	                       and the files are written at once
+	
+	MD380_AIO_AUTO takes io_uring if the kernel allows it, else the
+	threads; on Windows only MD380_AIO_SYNC is available.
+	
+	At most MD380_AIO_READ_AHEAD images and MD380_AIO_MAX_WRITES files
+	are in flight; a write waits for a free slot, whose buffer is
+	swapped with the caller's and so recycled. The operations on the
+	same file are run in the order they are given. The functions must
+	be called by a single thread.
+	
+	Use INIT_MD380_Aio and FREE_MD380_Aio.
+=========================================================================*/
+#define MD380_AIO_AUTO     0
+#define MD380_AIO_URING    1
+#define MD380_AIO_THREADS  2
+#define MD380_AIO_SYNC     3
+
+#define MD380_AIO_READ_AHEAD     4
+#define MD380_AIO_MAX_WRITES     8
+#define MD380_AIO_NO_OF_THREADS  4
+
+typedef struct MD380_AioState MD380_AioState;
+
+typedef struct {
+	/* NULL if not started: every operation is synchronous */
+	MD380_AioState* state;
+} MD380_Aio;
+
+/* Initialize */
+extern void INIT_MD380_Aio (MD380_Aio* aio);
+
+/* Free; waits for the operations in flight, discarding their errors */
+extern void FREE_MD380_Aio (MD380_Aio* aio);
+
+/*=========================================================================
+	Starts the given MD380_AIO_xxx backend; MD380_AIO_AUTO falls back
+	to the threads if io_uring is not available.
+	Returns CSVRET_OK, CSVRET_OUT_OF_MEMORY or MD380ERR_FILE_ERROR if
+	the backend could not be started. The 'errorMessage' is allocated
+	with binAlloc.
+=========================================================================*/
+extern int md380_StartAio (MD380_Aio* aio, int backend, char** errorMessage);
+
+/* Returns the name of the backend running */
+extern const char* md380_AioBackendName (const MD380_Aio* aio);
+
+/*=========================================================================
+	Starts reading the image 'fileName', if a slot is free and it is
+	not already in flight; never waits. Returns 1 if the read started.
+=========================================================================*/
+extern int md380_AioPrefetch (MD380_Aio* aio, const char* fileName);
+
+/*=========================================================================
+	Takes the image 'fileName' read ahead, waiting for its read to
+	complete, and lays it out as md380_ReadImageStream. Returns CSVRET_OK,
+	or CSVRET_EOF if it was not read ahead or its read failed: the
+	caller reads it by itself, reporting the errors.
+=========================================================================*/
+extern int md380_AioTakeImage (MD380_Aio* aio, const char* fileName, t_buffer* rdtBinFile, unsigned* offset, unsigned* length);
+
+/* Discards the image 'fileName' if read ahead and not taken */
+extern void md380_AioDrop (MD380_Aio* aio, const char* fileName);
+
+/*=========================================================================
+	Queues the writing of the content of 'data' to 'fileName', which is
+	created or truncated; 'data' is given in exchange the empty buffer
+	of the slot. The errors of the write are returned by md380_AioFlush.
+	Returns CSVRET_OK or CSVRET_OUT_OF_MEMORY
+=========================================================================*/
+extern int md380_AioWrite (MD380_Aio* aio, const char* fileName, MD380_MemBuffer* data, char** errorMessage);
+
+/*=========================================================================
+	Waits for all the writes queued. Returns CSVRET_OK or
+	MD380ERR_FILE_ERROR with the error of the first write failed
+	since the previous flush.
+=========================================================================*/
+extern int md380_AioFlush (MD380_Aio* aio, char** errorMessage);
+
+/*=========================================================================
+	As saveCSVFileAll, but queuing the files with md380_AioWrite
+=========================================================================*/
+extern int md380_AioSaveCSVFiles (MD380_Aio* aio, CSVFileNames* csvFileNames, const TRDTFile* container, char separator, char** errorMessage);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif
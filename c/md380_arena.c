@@ -0,0 +1,88 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_arena.h"
+#include "binlib.h"
+#include <string.h>
+#include <assert.h>
+
+/* The blocks of a chunk start after its header */
+#define ARENA_HEADER_SIZE ((sizeof (MD380_ArenaChunk)+MD380_ARENA_ALIGN-1) & ~(size_t)(MD380_ARENA_ALIGN-1))
+#define ARENA_DATA(chunk) (((unsigned char*)(chunk))+ARENA_HEADER_SIZE)
+
+/* Initialize */
+void INIT_MD380_Arena (MD380_Arena* arena)
+{
+	memset (arena, 0, sizeof (*arena));
+	arena->chunkSize = MD380_ARENA_CHUNK_SIZE;
+}
+
+/* Free */
+void FREE_MD380_Arena (MD380_Arena* arena)
+{
+	while (arena->chunks) {
+		MD380_ArenaChunk* next = arena->chunks->next;
+		binFree (arena->chunks);
+		arena->chunks = next;
+	}
+	INIT_MD380_Arena (arena);
+}
+
+/*=========================================================================
+	Takes the block from the newest chunk, chaining a new one if full
+=========================================================================*/
+void* md380_ArenaAlloc (MD380_Arena* arena, size_t size)
+{
+	MD380_ArenaChunk* chunk = arena->chunks;
+	void* ret;
+	
+	size = (size+MD380_ARENA_ALIGN-1) & ~(size_t)(MD380_ARENA_ALIGN-1);
+	if (chunk == NULL || chunk->size-chunk->used < size) {
+		size_t chunkSize = (size > arena->chunkSize ? size : arena->chunkSize);
+		chunk = (MD380_ArenaChunk*)binAlloc (ARENA_HEADER_SIZE+chunkSize);
+		if (chunk == NULL) return NULL;
+		chunk->next = arena->chunks;
+		chunk->size = chunkSize;
+		chunk->used = 0;
+		arena->chunks = chunk;
+	}
+	ret = ARENA_DATA (chunk)+chunk->used;
+	chunk->used += size;
+	return ret;
+}
+
+/*=========================================================================
+	Several chunks are merged into a single one, allocated by the
+	next md380_ArenaAlloc
+=========================================================================*/
+void md380_ResetArena (MD380_Arena* arena)
+{
+	if (arena->chunks && arena->chunks->next) {
+		size_t total = 0;
+		while (arena->chunks) {
+			MD380_ArenaChunk* next = arena->chunks->next;
+			total += arena->chunks->size;
+			binFree (arena->chunks);
+			arena->chunks = next;
+		}
+		if (total > arena->chunkSize) arena->chunkSize = total;
+	}
+	else if (arena->chunks) {
+		arena->chunks->used = 0;
+	}
+}
@@ -0,0 +1,80 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_ARENA_H
+#define __MD380_ARENA_H
+#include <stddef.h>
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Arena of the allocations of a job.
+	
+	Blocks are taken in sequence from chunks allocated with binAlloc
+	and are never freed one by one: md380_ResetArena releases all of
+	them at once between two jobs. A job not fitting the first chunk
+	chains more; the reset then replaces them with a single chunk of
+	their total size, so that the following jobs allocate nothing and
+	the large buffers (the image, the container) are recycled.
+	
+	Use INIT_MD380_Arena and FREE_MD380_Arena.
+=========================================================================*/
+
+/* Minimum size of a chunk */
+#define MD380_ARENA_CHUNK_SIZE   16384
+
+/* Alignment of the blocks */
+#define MD380_ARENA_ALIGN        16
+
+typedef struct MD380_ArenaChunk {
+	struct MD380_ArenaChunk* next;
+	size_t size;
+	size_t used;
+} MD380_ArenaChunk;
+
+typedef struct {
+	/* Newest chunk first */
+	MD380_ArenaChunk* chunks;
+	
+	/* Size of the next chunk, at least MD380_ARENA_CHUNK_SIZE */
+	size_t chunkSize;
+} MD380_Arena;
+
+/* Initialize */
+extern void INIT_MD380_Arena (MD380_Arena* arena);
+
+/* Free */
+extern void FREE_MD380_Arena (MD380_Arena* arena);
+
+/*=========================================================================
+	Returns a block of 'size' octets, not cleared, or NULL if out of
+	memory. The block is valid up to the next reset.
+=========================================================================*/
+extern void* md380_ArenaAlloc (MD380_Arena* arena, size_t size);
+
+/*=========================================================================
+	Releases all the blocks, keeping the memory for reuse
+=========================================================================*/
+extern void md380_ResetArena (MD380_Arena* arena);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif
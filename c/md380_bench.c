@@ -0,0 +1,309 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "version.h"
+#include "md380_tools.h"
+#include "md380_file.h"
+#include "md380_valid.h"
+#include "md380_tables.h"
+#include "md380_resolve.h"
+#include "md380_lib.h"
+#include "md380_synth.h"
+#include "md380_stats.h"
+
+/*============================================================================
+	Benchmark of the conversion stages on the synthetic worst case
+	codeplug of md380_synth.h.
+	
+	Each iteration decodes the image, validates, registers the names and
+	binds the references; then it exports every table to CSV, imports
+	it back into a second container, resolves its references and
+	encodes it. Each stage is timed on its own; the warm-up iterations
+	are not counted. The first iteration checks that the image encoded
+	is the one decoded.
+	
+	The result is written as JSON, in nanoseconds:
+	
+	    {"release": ..., "iterations": ..., "warmup": ...,
+	     "stages": {"decode": {"min": ..., "p50": ..., "p90": ...,
+	                           "p99": ..., "max": ..., "mean": ...}, ...}}
+============================================================================*/
+#define BENCH_DEFAULT_ITERATIONS  200
+#define BENCH_DEFAULT_WARMUP      20
+
+/* Stages: the CSV export and import ones are per table */
+enum {
+	STAGE_DECODE,
+	STAGE_VALIDATE,
+	STAGE_REGISTER,
+	STAGE_BIND,
+	STAGE_EXPORT,
+	STAGE_IMPORT = STAGE_EXPORT+NO_OF_CSV_STREAMS,
+	STAGE_RESOLVE = STAGE_IMPORT+NO_OF_CSV_STREAMS,
+	STAGE_ENCODE,
+	NO_OF_STAGES
+};
+
+typedef struct {
+	char name [64];
+	uint64_t* samples;
+} BenchStage;
+
+/*============================================================================
+	Violations are counted, and the first one reported
+============================================================================*/
+static void benchReportFunc (void* param, const char* recordType, int recordNumber, const char* fieldName, const char* text)
+{
+	if ((*(int*)param)++ == 0) {
+		fprintf (stderr, "Record %s, line %d, field %s, violation: %s\n", recordType, recordNumber+1, fieldName, text);
+	}
+}
+
+static int benchCompare (const void* a, const void* b)
+{
+	uint64_t x = *(const uint64_t*)a;
+	uint64_t y = *(const uint64_t*)b;
+	return (x > y) - (x < y);
+}
+
+/*============================================================================
+	Writes the statistics of a stage; the samples get sorted
+============================================================================*/
+static void benchWriteStage (FILE* f, const BenchStage* stage, unsigned iterations, int last)
+{
+	uint64_t* s = stage->samples;
+	uint64_t sum = 0;
+	unsigned i;
+	
+	qsort (s, iterations, sizeof (uint64_t), benchCompare);
+	for (i=0; i<iterations; i++) sum += s[i];
+	fprintf (f, "    \"%s\": {\"min\": %lu, \"p50\": %lu, \"p90\": %lu, \"p99\": %lu, \"max\": %lu, \"mean\": %lu}%s\n", stage->name,
+		(unsigned long)s[0],
+		(unsigned long)s[(iterations-1)*50/100],
+		(unsigned long)s[(iterations-1)*90/100],
+		(unsigned long)s[(iterations-1)*99/100],
+		(unsigned long)s[iterations-1],
+		(unsigned long)(sum/iterations),
+		(last ? "" : ","));
+}
+
+/*============================================================================
+	Runs one iteration; the times are stored at 'sample' if not NULL.
+	Returns 0=ok  non-zero=error
+============================================================================*/
+static int benchIteration (const t_buffer* image, t_buffer* encoded, TRDTFile* container, TRDTFile* loaded, MD380_MemBuffer csv [NO_OF_CSV_STREAMS], BenchStage* stages, unsigned sample)
+{
+	MD380Tables tables;
+	MD380_MemReader reader;
+	char* errorMessage = NULL;
+	uint64_t times [NO_OF_STAGES+1];
+	int violations = 0;
+	int ret = 0;
+	unsigned i;
+	
+	INIT_MD380Tables (&tables);
+	/* The container is bound by the previous iteration */
+	memset (container, 0, sizeof (TRDTFile));
+	times[STAGE_DECODE] = md380_StatsNow ();
+	decodeBinary_TRDTFile (image, container);
+	times[STAGE_VALIDATE] = md380_StatsNow ();
+	validateContainer (container, benchReportFunc, &violations);
+	times[STAGE_REGISTER] = md380_StatsNow ();
+	registerContainerNames (&tables, container, benchReportFunc, &violations);
+	times[STAGE_BIND] = md380_StatsNow ();
+	bindReferences (container, benchReportFunc, &violations);
+	for (i=0; i<NO_OF_CSV_STREAMS && ret == CSVRET_OK; i++) {
+		times[STAGE_EXPORT+i] = md380_StatsNow ();
+		csv[i].length = 0;
+		ret = csvStreamFuncs[i].saveCSVStream (csvStreamFuncs[i].recordName, container, ',', md380_MemWriteBinaryFunc, csv+i, &errorMessage);
+	}
+	memset (loaded, 0, sizeof (TRDTFile));
+	for (i=0; i<NO_OF_CSV_STREAMS && ret == CSVRET_OK; i++) {
+		times[STAGE_IMPORT+i] = md380_StatsNow ();
+		md380_OpenMemReader (&reader, csv[i].data, csv[i].length);
+		ret = csvStreamFuncs[i].loadCSVStream (csvStreamFuncs[i].recordName, loaded, ',', md380_MemReadCharFunc, &reader, &errorMessage);
+	}
+	times[STAGE_RESOLVE] = md380_StatsNow ();
+	if (ret == CSVRET_OK) resolveReferences (&tables, loaded, benchReportFunc, &violations);
+	times[STAGE_ENCODE] = md380_StatsNow ();
+	if (ret == CSVRET_OK) encodeBinary_TRDTFile (encoded, loaded);
+	times[NO_OF_STAGES] = md380_StatsNow ();
+	FREE_MD380Tables (&tables);
+	
+	if (ret != CSVRET_OK) {
+		fprintf (stderr, "ERROR: %s\n", (errorMessage ? errorMessage : md380_CsvRetToString (ret)));
+		if (errorMessage) binFree (errorMessage);
+		return 1;
+	}
+	if (violations) {
+		fprintf (stderr, "ERROR: %d rules violation(s) in the synthetic codeplug\n", violations);
+		return 1;
+	}
+	if (stages) {
+		for (i=0; i<NO_OF_STAGES; i++) stages[i].samples[sample] = times[i+1]-times[i];
+	}
+	return 0;
+}
+
+/*============================================================================
+	MAIN
+============================================================================*/
+int main (int argc, char* argv[])
+{
+	BenchStage stages [NO_OF_STAGES];
+	MD380_MemBuffer csv [NO_OF_CSV_STREAMS];
+	TRDTFile* container = NULL;
+	TRDTFile* loaded = NULL;
+	t_buffer* image = NULL;
+	t_buffer* encoded = NULL;
+	unsigned iterations = BENCH_DEFAULT_ITERATIONS;
+	unsigned warmup = BENCH_DEFAULT_WARMUP;
+	const char* outputName = NULL;
+	const char* genDirName = NULL;
+	FILE* out = stdout;
+	int ret = 0;
+	int i;
+	unsigned k;
+	
+	memset (stages, 0, sizeof (stages));
+	for (k=0; k<NO_OF_CSV_STREAMS; k++) INIT_MD380_MemBuffer (csv+k);
+	
+	for (i=1; i<argc; i++) {
+		if (i+1 < argc && strcmp (argv[i], "-n") == 0) iterations = (unsigned)atoi (argv[++i]);
+		else if (i+1 < argc && strcmp (argv[i], "-w") == 0) warmup = (unsigned)atoi (argv[++i]);
+		else if (i+1 < argc && strcmp (argv[i], "-o") == 0) outputName = argv[++i];
+		else if (i+1 < argc && strcmp (argv[i], "-gen") == 0) genDirName = argv[++i];
+		else {
+			fprintf (stderr, "USAGE: rdt2csv_bench [-n <iterations>] [-w <warm-up iterations>] [-o <file.json>]\n");
+			fprintf (stderr, "       rdt2csv_bench -gen <dir>\n");
+			fprintf (stderr, "\n");
+			fprintf (stderr, "    -n      timed iterations (default %d)\n", BENCH_DEFAULT_ITERATIONS);
+			fprintf (stderr, "    -w      iterations run before timing (default %d)\n", BENCH_DEFAULT_WARMUP);
+			fprintf (stderr, "    -o      write the JSON result to a file instead of the standard output\n");
+			fprintf (stderr, "    -gen    write the synthetic image (%s) and its .csv files to <dir>\n", MD380_SYNTH_IMAGE_NAME);
+			return 1;
+		}
+	}
+	
+	/* Only write the synthetic files */
+	if (genDirName) {
+		char* errorMessage = NULL;
+		if (md380_SynthesizeFiles (genDirName, MD380_DEFAULT_SEPARATOR, &errorMessage) != CSVRET_OK) {
+			fprintf (stderr, "ERROR: %s\n", (errorMessage ? errorMessage : "out of memory"));
+			if (errorMessage) binFree (errorMessage);
+			return 1;
+		}
+		fprintf (stderr, "Synthetic codeplug written to '%s'\n", genDirName);
+		return 0;
+	}
+	if (iterations == 0) iterations = 1;
+	
+	container = (TRDTFile*)binAlloc (sizeof (TRDTFile));
+	loaded = (TRDTFile*)binAlloc (sizeof (TRDTFile));
+	image = (t_buffer*)binAlloc (FILE_SIZE_TRDTFile);
+	encoded = (t_buffer*)binAlloc (FILE_SIZE_TRDTFile);
+	for (k=0; k<NO_OF_STAGES; k++) {
+		stages[k].samples = (uint64_t*)binAlloc (iterations*sizeof (uint64_t));
+		if (stages[k].samples == NULL) break;
+	}
+	if (container == NULL || loaded == NULL || image == NULL || encoded == NULL || k < NO_OF_STAGES) {
+		fprintf (stderr, "Error allocating the benchmark buffers (out of memory?)\n");
+		ret = 2;
+		goto exitMain;
+	}
+	strcpy (stages[STAGE_DECODE].name, "decode");
+	strcpy (stages[STAGE_VALIDATE].name, "validate");
+	strcpy (stages[STAGE_REGISTER].name, "register");
+	strcpy (stages[STAGE_BIND].name, "bind");
+	for (k=0; k<NO_OF_CSV_STREAMS; k++) {
+		sprintf (stages[STAGE_EXPORT+k].name, "export.%s", csvStreamFuncs[k].recordName);
+		sprintf (stages[STAGE_IMPORT+k].name, "import.%s", csvStreamFuncs[k].recordName);
+	}
+	strcpy (stages[STAGE_RESOLVE].name, "resolve");
+	strcpy (stages[STAGE_ENCODE].name, "encode");
+	
+	/* The image to be decoded */
+	if (md380_SynthesizeContainer (container) != 0) {
+		fprintf (stderr, "ERROR: the synthetic container violates the rules\n");
+		ret = 1;
+		goto exitMain;
+	}
+	memset (image, 0, FILE_SIZE_TRDTFile);
+	encodeBinary_TRDTFile (image, container);
+	
+	/* Warm-up, checking the round trip once */
+	memcpy (encoded, image, FILE_SIZE_TRDTFile);
+	for (k=0; k<warmup || k == 0; k++) {
+		if (benchIteration (image, encoded, container, loaded, csv, NULL, 0)) {ret = 1; goto exitMain;}
+		if (k == 0 && memcmp (image, encoded, FILE_SIZE_TRDTFile) != 0) {
+			fprintf (stderr, "ERROR: the image encoded from the CSV files differs from the one decoded\n");
+			ret = 1;
+			goto exitMain;
+		}
+	}
+	fprintf (stderr, "Running %u iteration(s)\n", iterations);
+	for (k=0; k<iterations; k++) {
+		if (benchIteration (image, encoded, container, loaded, csv, stages, k)) {ret = 1; goto exitMain;}
+	}
+	
+	/* Result */
+	if (outputName) {
+		out = fopen (outputName, "w");
+		if (out == NULL) {
+			fprintf (stderr, "Error opening file '%s'\n", outputName);
+			ret = 1;
+			goto exitMain;
+		}
+	}
+	fprintf (out, "{\n");
+	fprintf (out, "  \"release\": %u,\n", SUBVERSION_RELEASE_N);
+	fprintf (out, "  \"iterations\": %u,\n", iterations);
+	fprintf (out, "  \"warmup\": %u,\n", warmup);
+	fprintf (out, "  \"unit\": \"ns\",\n");
+	fprintf (out, "  \"csvBytes\": {");
+	for (k=0; k<NO_OF_CSV_STREAMS; k++) {
+		fprintf (out, "%s\"%s\": %u", (k ? ", " : ""), csvStreamFuncs[k].recordName, csv[k].length);
+	}
+	fprintf (out, "},\n");
+	fprintf (out, "  \"stages\": {\n");
+	for (k=0; k<NO_OF_STAGES; k++) {
+		benchWriteStage (out, stages+k, iterations, (k+1 == NO_OF_STAGES));
+	}
+	fprintf (out, "  }\n");
+	fprintf (out, "}\n");
+	if (outputName) {
+		if (fclose (out) != 0) ret = 1;
+		fprintf (stderr, "Result written to '%s'\n", outputName);
+	}
+
+exitMain:
+	for (k=0; k<NO_OF_STAGES; k++) {
+		if (stages[k].samples) binFree (stages[k].samples);
+	}
+	for (k=0; k<NO_OF_CSV_STREAMS; k++) FREE_MD380_MemBuffer (csv+k);
+	if (container) binFree (container);
+	if (loaded) binFree (loaded);
+	if (image) binFree (image);
+	if (encoded) binFree (encoded);
+	return ret;
+}
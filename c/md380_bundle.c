@@ -0,0 +1,261 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_bundle.h"
+#include "crc.h"
+#include "md380_stats.h"
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <assert.h>
+
+/* The index is always comma separated, whatever the tables separator */
+#define BUNDLE_INDEX_SEPARATOR ','
+#define BUNDLE_TOKEN_SIZE 64
+
+/* Writer counting the octets written, used to build the index */
+typedef struct {
+	FILE* f;
+	unsigned long written;
+} BundleWriter;
+
+/* Reader stopping at the end of a section */
+typedef struct {
+	FILE* f;
+	unsigned long remaining;
+} BundleReader;
+
+/*=========================================================================
+	CSV Lib callback function compatibile with "WriteBinaryFunc"
+=========================================================================*/
+static int md380_BundleWriteBinaryFunc (void* param, const char* buffer, unsigned length)
+{
+	BundleWriter* w = (BundleWriter*)param;
+	if (fwrite (buffer, 1, length, w->f) != length) return 1;
+	w->written += length;
+	MD380_STATS_ADD (bytesWritten, length);
+	return 0;
+}
+
+/*=========================================================================
+	CSV Lib callback function compatibile with "ReadCharFunc"
+=========================================================================*/
+static int md380_BundleReadCharFunc (void* param)
+{
+	BundleReader* r = (BundleReader*)param;
+	int ch;
+	if (r->remaining == 0) return csvEOF;
+	r->remaining--;
+	ch = fgetc (r->f);
+	if (ch == EOF) return csvEOF;
+	MD380_STATS_ADD (bytesRead, 1);
+	return ch;
+}
+
+/*=========================================================================
+	Allocates an error message about the bundle
+=========================================================================*/
+static int md380_BundleError (char** errorMessage, const char* fileName, const char* text, int ret)
+{
+	(*errorMessage) = (char*)binAlloc (strlen (fileName)+strlen (text)+64);
+	if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
+	sprintf ((*errorMessage), "Bundle '%s': %s", fileName, text);
+	return ret;
+}
+
+/*=========================================================================
+	Saves all the tables of the container into the bundle 'fileName'.
+=========================================================================*/
+int md380_SaveCSVBundle (const char* fileName, const TRDTFile* container, char separator, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	MD380_BundleIndex index;
+	BundleWriter w;
+	unsigned long indexOffset;
+	char trailer[MD380_BUNDLE_TRAILER_SIZE+1];
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	w.written = 0;
+	w.f = fopen (fileName, "wb");
+	if (w.f == NULL) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+128);
+		if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
+		sprintf ((*errorMessage), "Error opening '%s' for writing (%s)", fileName, strerror (errno));
+		return MD380ERR_FILE_ERROR;
+	}
+	
+	/* Write the sections */
+	for (i=0; i<NO_OF_CSV_STREAMS; i++) {
+		index.sections[i].offset = w.written;
+		ret = csvStreamFuncs[i].saveCSVStream (fileName, container, separator, md380_BundleWriteBinaryFunc, &w, errorMessage);
+		if (ret != CSVRET_OK) goto exitFunc;
+		index.sections[i].length = w.written - index.sections[i].offset;
+	}
+	
+	/* Write the index */
+	indexOffset = w.written;
+	for (i=0; i<NO_OF_CSV_STREAMS && ret == CSVRET_OK; i++) {
+		ret = csvWriteToken (csvStreamFuncs[i].recordName, (int)strlen (csvStreamFuncs[i].recordName), md380_BundleWriteBinaryFunc, &w);
+		if (ret == CSVRET_OK) ret = csvWriteSeparator (BUNDLE_INDEX_SEPARATOR, md380_BundleWriteBinaryFunc, &w);
+		if (ret == CSVRET_OK) ret = csvWriteTokenUnsigned ((unsigned)index.sections[i].offset, md380_BundleWriteBinaryFunc, &w);
+		if (ret == CSVRET_OK) ret = csvWriteSeparator (BUNDLE_INDEX_SEPARATOR, md380_BundleWriteBinaryFunc, &w);
+		if (ret == CSVRET_OK) ret = csvWriteTokenUnsigned ((unsigned)index.sections[i].length, md380_BundleWriteBinaryFunc, &w);
+		if (ret == CSVRET_OK) ret = csvWriteEndOfLine (md380_BundleWriteBinaryFunc, &w);
+	}
+	
+	/* Write the trailer */
+	if (ret == CSVRET_OK) {
+		sprintf (trailer, "%s%010lu\r\n", MD380_BUNDLE_SIGNATURE, indexOffset);
+		assert (strlen (trailer) == MD380_BUNDLE_TRAILER_SIZE);
+		ret = md380_BundleWriteBinaryFunc (&w, trailer, MD380_BUNDLE_TRAILER_SIZE) ? CSVRET_WRITE_ERROR : CSVRET_OK;
+	}
+	if (ret != CSVRET_OK) {
+		ret = md380_BundleError (errorMessage, fileName, md380_CsvRetToString (ret), ret);
+	}
+	
+exitFunc:
+	if (fclose (w.f) != 0 && ret == CSVRET_OK) {
+		ret = md380_BundleError (errorMessage, fileName, strerror (errno), MD380ERR_FILE_ERROR);
+	}
+	return ret;
+}
+
+/*=========================================================================
+	Reads the index of the bundle opened as 'f'
+=========================================================================*/
+int md380_ReadBundleIndex (FILE* f, const char* fileName, MD380_BundleIndex* index, char** errorMessage)
+{
+	int ret;
+	char trailer[MD380_BUNDLE_TRAILER_SIZE+1];
+	char token[BUNDLE_TOKEN_SIZE];
+	unsigned long indexOffset, fileSize;
+	BundleReader r;
+	char* endPtr;
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	memset (index, 0, sizeof (*index));
+	
+	/* Read the trailer */
+	if (fseek (f, 0, SEEK_END) != 0) return md380_BundleError (errorMessage, fileName, strerror (errno), MD380ERR_FILE_ERROR);
+	fileSize = (unsigned long)ftell (f);
+	if (fileSize < MD380_BUNDLE_TRAILER_SIZE || fseek (f, fileSize-MD380_BUNDLE_TRAILER_SIZE, SEEK_SET) != 0 ||
+		fread (trailer, 1, MD380_BUNDLE_TRAILER_SIZE, f) != MD380_BUNDLE_TRAILER_SIZE ||
+		memcmp (trailer, MD380_BUNDLE_SIGNATURE, strlen (MD380_BUNDLE_SIGNATURE)) != 0) {
+		return md380_BundleError (errorMessage, fileName, "not a bundle (trailer not found)", MD380ERR_INVALID_CSV_FORMAT);
+	}
+	trailer[MD380_BUNDLE_TRAILER_SIZE-2] = '\0';
+	indexOffset = strtoul (trailer+strlen (MD380_BUNDLE_SIGNATURE), &endPtr, 10);
+	if ((*endPtr) != '\0' || indexOffset > fileSize-MD380_BUNDLE_TRAILER_SIZE) {
+		return md380_BundleError (errorMessage, fileName, "invalid index offset in trailer", MD380ERR_INVALID_CSV_FORMAT);
+	}
+	
+	/* Read the index lines */
+	if (fseek (f, indexOffset, SEEK_SET) != 0) return md380_BundleError (errorMessage, fileName, strerror (errno), MD380ERR_FILE_ERROR);
+	r.f = f;
+	r.remaining = fileSize-MD380_BUNDLE_TRAILER_SIZE-indexOffset;
+	for (;;) {
+		int len;
+		unsigned long offset, length;
+		unsigned nameCrc;
+		
+		ret = csvReadToken (token, BUNDLE_TOKEN_SIZE, &len, BUNDLE_INDEX_SEPARATOR, md380_BundleReadCharFunc, &r);
+		if (ret == CSVRET_EOF && len == 0) break;
+		if (ret != CSVRET_OK) break;
+		nameCrc = crc32_AddAsciizLowerCase (0, token);
+		
+		ret = csvReadToken (token, BUNDLE_TOKEN_SIZE, &len, BUNDLE_INDEX_SEPARATOR, md380_BundleReadCharFunc, &r);
+		if (ret != CSVRET_OK) break;
+		offset = strtoul (token, &endPtr, 10);
+		if ((*endPtr) != '\0') {ret = MD380ERR_INVALID_CSV_FORMAT; break;}
+		
+		ret = csvReadToken (token, BUNDLE_TOKEN_SIZE, &len, BUNDLE_INDEX_SEPARATOR, md380_BundleReadCharFunc, &r);
+		if (ret != CSVRET_EOL && ret != CSVRET_EOF) break;
+		length = strtoul (token, &endPtr, 10);
+		if ((*endPtr) != '\0' || offset > indexOffset || length > indexOffset-offset) {ret = MD380ERR_INVALID_CSV_FORMAT; break;}
+		
+		/* Sections of unknown tables are ignored */
+		for (i=0; i<NO_OF_CSV_STREAMS; i++) {
+			if (crc32_AddAsciizLowerCase (0, csvStreamFuncs[i].recordName) == nameCrc) {
+				index->sections[i].offset = offset;
+				index->sections[i].length = length;
+				break;
+			}
+		}
+		if (ret == CSVRET_EOF) break;
+	}
+	if (ret != CSVRET_EOL && ret != CSVRET_EOF) {
+		return md380_BundleError (errorMessage, fileName, "invalid index", MD380ERR_INVALID_CSV_FORMAT);
+	}
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Loads the table number 'table' from the bundle opened as 'f'
+=========================================================================*/
+int md380_LoadCSVBundleTable (FILE* f, const char* fileName, const MD380_BundleIndex* index, unsigned table, TRDTFile* container, char separator, char** errorMessage)
+{
+	BundleReader r;
+	
+	assert (table < NO_OF_CSV_STREAMS);
+	if (fseek (f, index->sections[table].offset, SEEK_SET) != 0) {
+		return md380_BundleError (errorMessage, fileName, strerror (errno), MD380ERR_FILE_ERROR);
+	}
+	r.f = f;
+	r.remaining = index->sections[table].length;
+	return csvStreamFuncs[table].loadCSVStream (fileName, container, separator, md380_BundleReadCharFunc, &r, errorMessage);
+}
+
+/*=========================================================================
+	Loads all the tables found in the bundle 'fileName'.
+=========================================================================*/
+int md380_LoadCSVBundle (const char* fileName, TRDTFile* container, char separator, unsigned* loadedTables, char** errorMessage)
+{
+	int ret;
+	MD380_BundleIndex index;
+	FILE* f;
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	f = fopen (fileName, "rb");
+	if (f == NULL) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+128);
+		if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
+		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)", fileName, strerror (errno));
+		return MD380ERR_FILE_ERROR;
+	}
+	
+	ret = md380_ReadBundleIndex (f, fileName, &index, errorMessage);
+	for (i=0; i<NO_OF_CSV_STREAMS && ret == CSVRET_OK; i++) {
+		if (index.sections[i].length == 0) continue;
+		ret = md380_LoadCSVBundleTable (f, fileName, &index, i, container, separator, errorMessage);
+		
+		/* csvStreamFuncs and RECORDS_TRDTFile share the same order */
+		assert (strcmp (csvStreamFuncs[i].recordName, RECORDS_TRDTFile[i].recordName) == 0);
+		if (ret == CSVRET_OK) (*loadedTables) |= (1u << i);
+	}
+	
+	fclose (f);
+	return ret;
+}
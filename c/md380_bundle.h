@@ -0,0 +1,89 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_BUNDLE_H
+#define __MD380_BUNDLE_H
+#include <stdio.h>
+#include "md380.h"
+#include "md380_file.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	A bundle is a single file containing the CSV of every table, one
+	after the other, each one with its own header line. The sections
+	are followed by an index, one CSV line per section:
+	
+	    <recordName>,<offset>,<length>
+	
+	and by a fixed size trailer with the offset of the index:
+	
+	    #RDT2CSV-BUNDLE 0000123456<CR><LF>
+	
+	The bundle is written in a single pass and the reader can seek
+	straight to any section by reading the trailer and the index.
+=========================================================================*/
+#define MD380_BUNDLE_SIGNATURE     "#RDT2CSV-BUNDLE "
+#define MD380_BUNDLE_TRAILER_SIZE  28
+
+/* Position of one section inside the bundle; length is 0 if missing */
+typedef struct {
+	unsigned long offset;
+	unsigned long length;
+} MD380_BundleSection;
+
+/* Index of a bundle, in the same order of csvStreamFuncs */
+typedef struct {
+	MD380_BundleSection sections[NO_OF_CSV_STREAMS];
+} MD380_BundleIndex;
+
+/*=========================================================================
+	Saves all the tables of the container into the bundle 'fileName'.
+	Returns CSVRET_xxx and MD380ERR_xxx values. The 'errorMessage'
+	string is allocated with binAlloc in case of error and it is to be
+	freed with binFree.
+=========================================================================*/
+extern int md380_SaveCSVBundle (const char* fileName, const TRDTFile* container, char separator, char** errorMessage);
+
+/*=========================================================================
+	Reads the index of the bundle opened as 'f'; 'fileName' is only
+	used for error messages.
+	Returns CSVRET_xxx and MD380ERR_xxx values.
+=========================================================================*/
+extern int md380_ReadBundleIndex (FILE* f, const char* fileName, MD380_BundleIndex* index, char** errorMessage);
+
+/*=========================================================================
+	Loads the table number 'table' (index in csvStreamFuncs) from the
+	bundle opened as 'f', seeking directly to its section.
+	Returns CSVRET_xxx and MD380ERR_xxx values.
+=========================================================================*/
+extern int md380_LoadCSVBundleTable (FILE* f, const char* fileName, const MD380_BundleIndex* index, unsigned table, TRDTFile* container, char separator, char** errorMessage);
+
+/*=========================================================================
+	Loads all the tables found in the bundle 'fileName'; the TABLE_xxx
+	bits of the loaded tables are added to 'loadedTables'.
+	Returns CSVRET_xxx and MD380ERR_xxx values.
+=========================================================================*/
+extern int md380_LoadCSVBundle (const char* fileName, TRDTFile* container, char separator, unsigned* loadedTables, char** errorMessage);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -0,0 +1,185 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_changes.h"
+#include "md380_stats.h"
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/* Initialize */
+void INIT_MD380_Changes (MD380_Changes* changes)
+{
+	memset (changes, 0, sizeof (*changes));
+}
+
+/* Free */
+void FREE_MD380_Changes (MD380_Changes* changes)
+{
+	if (changes->ranges) binFree (changes->ranges);
+	INIT_MD380_Changes (changes);
+}
+
+/*=========================================================================
+	Takes the original number of records, forgetting the previous changes
+=========================================================================*/
+void md380_SetOriginalCounts (MD380_Changes* changes, const TRDTFile* container)
+{
+	unsigned i;
+	memset (changes->tables, 0, sizeof (changes->tables));
+	changes->noOfRanges = 0;
+	for (i=0; i<NO_OF_RECORDS_TRDTFile; i++) {
+		changes->originalCounts[i] = md380_RecordCount (RECORDS_TRDTFile+i, container);
+	}
+}
+
+/*=========================================================================
+	Adds a region, merging it with the previous one when contiguous
+=========================================================================*/
+static void md380_AddChangedRange (MD380_Changes* changes, unsigned offset, unsigned length)
+{
+	MD380_ChangedRange* last = (changes->noOfRanges ? changes->ranges+changes->noOfRanges-1 : NULL);
+	if (last && last->offset+last->length == offset) {
+		last->length += length;
+	}
+	else {
+		changes->ranges[changes->noOfRanges].offset = offset;
+		changes->ranges[changes->noOfRanges].length = length;
+		changes->noOfRanges++;
+	}
+}
+
+/*=========================================================================
+	Encodes the changed records
+=========================================================================*/
+int md380_EncodeChanges (t_buffer* image, const TRDTFile* container, unsigned tableMask, MD380_Changes* changes)
+{
+	unsigned maxRanges = 0;
+	unsigned maxLength = 0;
+	t_buffer* scratch = NULL;
+	t_buffer* empty = NULL;
+	unsigned t, i;
+
+	/* There can not be more regions than records */
+	for (t=0; t<NO_OF_RECORDS_TRDTFile; t++) {
+		const RecordDescriptor* rd = RECORDS_TRDTFile+t;
+		maxRanges += rd->maxCount;
+		if (rd->binaryLength/rd->maxCount > maxLength) maxLength = rd->binaryLength/rd->maxCount;
+	}
+	if (changes->ranges == NULL) {
+		changes->ranges = (MD380_ChangedRange*)binAlloc (maxRanges*sizeof (MD380_ChangedRange));
+	}
+	scratch = binAlloc (maxLength);
+	empty = binAlloc (maxLength);
+	if (changes->ranges == NULL || scratch == NULL || empty == NULL) {
+		if (scratch) binFree (scratch);
+		if (empty) binFree (empty);
+		return CSVRET_OUT_OF_MEMORY;
+	}
+
+	for (t=0; t<NO_OF_RECORDS_TRDTFile; t++) {
+		const RecordDescriptor* rd = RECORDS_TRDTFile+t;
+		unsigned length = rd->binaryLength/rd->maxCount;
+		unsigned count = md380_RecordCount (rd, container);
+		if ((tableMask & (1u << t)) == 0) continue;
+		
+		/* The empty record is the same for all the slots */
+		encodeBinaryEmptyRecord_TRDTFile (empty, 0, t);
+		
+		for (i=0; i<rd->maxCount; i++) {
+			unsigned offset = rd->binaryOffset+i*length;
+			const t_buffer* encoded = empty;
+			
+			/* Records are encoded over the original, as in place */
+			if (i < count) {
+				memcpy (scratch, image+offset, length);
+				encodeBinaryRecord_TRDTFile (scratch, 0, container, t, i);
+				encoded = scratch;
+			}
+			if (memcmp (image+offset, encoded, length) == 0) continue;
+			
+			memcpy (image+offset, encoded, length);
+			md380_AddChangedRange (changes, offset, length);
+			if (i < count && i < changes->originalCounts[t]) changes->tables[t].modified++;
+			else if (i < count) changes->tables[t].added++;
+			else if (i < changes->originalCounts[t]) changes->tables[t].removed++;
+		}
+	}
+
+	binFree (scratch);
+	binFree (empty);
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Prints the changes
+=========================================================================*/
+void md380_ReportChanges (const MD380_Changes* changes, FILE* f)
+{
+	unsigned t;
+	for (t=0; t<NO_OF_RECORDS_TRDTFile; t++) {
+		const MD380_TableChanges* tc = changes->tables+t;
+		if (tc->added == 0 && tc->removed == 0 && tc->modified == 0) continue;
+		fprintf (f, "%s: %u added, %u removed, %u modified\n", RECORDS_TRDTFile[t].recordName, tc->added, tc->removed, tc->modified);
+	}
+}
+
+/*=========================================================================
+	Writes the changed regions
+=========================================================================*/
+int md380_WriteChanges (const char* fileName, const t_buffer* image, unsigned fileOffset, const MD380_Changes* changes, char** errorMessage)
+{
+	const char* reason = NULL;
+	unsigned i;
+#ifdef _WIN32
+	FILE* f = fopen (fileName, "r+b");
+	if (f == NULL) reason = strerror (errno);
+	for (i=0; i<changes->noOfRanges && reason == NULL; i++) {
+		const MD380_ChangedRange* r = changes->ranges+i;
+		assert (r->offset >= fileOffset);
+		if (fseek (f, (long)(r->offset-fileOffset), SEEK_SET) || fwrite (image+r->offset, 1, r->length, f) != r->length) {
+			reason = strerror (errno);
+		}
+		MD380_STATS_ADD (bytesWritten, r->length);
+	}
+	if (f && fclose (f) && reason == NULL) reason = strerror (errno);
+#else
+	int fd = open (fileName, O_WRONLY);
+	if (fd < 0) reason = strerror (errno);
+	for (i=0; i<changes->noOfRanges && reason == NULL; i++) {
+		const MD380_ChangedRange* r = changes->ranges+i;
+		assert (r->offset >= fileOffset);
+		if (pwrite (fd, image+r->offset, r->length, (off_t)(r->offset-fileOffset)) != (ssize_t)r->length) {
+			reason = strerror (errno);
+		}
+		MD380_STATS_ADD (bytesWritten, r->length);
+	}
+	if (fd >= 0 && close (fd) && reason == NULL) reason = strerror (errno);
+#endif
+	if (reason) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+strlen (reason)+40);
+		if (*errorMessage) sprintf ((*errorMessage), "Error writing '%s' (%s)", fileName, reason);
+		return MD380ERR_FILE_ERROR;
+	}
+	return CSVRET_OK;
+}
@@ -0,0 +1,107 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_CHANGES_H
+#define __MD380_CHANGES_H
+#include "md380.h"
+#include "md380_tools.h"
+#include <stdio.h>
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Record level change tracking.
+	
+	The records loaded from CSV are encoded one by one and compared
+	byte by byte with the ones found in the original image: only the
+	records that differ are copied into the image and their regions
+	are collected, so that only those are written back to the file.
+	
+	The cost is the writing, not the encoding: every slot of the
+	tables selected is still encoded and compared, so that a small
+	edit costs as much CPU as the size of its tables. The CSV files
+	hold whole tables and are parsed whole anyway, so there is no
+	record known to be unchanged before comparing it.
+=========================================================================*/
+
+/* Records of one type added, removed and modified */
+typedef struct {
+	unsigned added;
+	unsigned removed;
+	unsigned modified;
+} MD380_TableChanges;
+
+/* Region of the image, in octets from the beginning of the .rdt image */
+typedef struct {
+	unsigned offset;
+	unsigned length;
+} MD380_ChangedRange;
+
+/* Use INIT_MD380_Changes and FREE_MD380_Changes */
+typedef struct {
+	/* Number of records of each type in the original image */
+	unsigned originalCounts [NO_OF_RECORDS_TRDTFile];
+	
+	/* Changes of each type, in the order of RECORDS_TRDTFile */
+	MD380_TableChanges tables [NO_OF_RECORDS_TRDTFile];
+	
+	/* Regions of the image changed, in ascending order */
+	MD380_ChangedRange* ranges;
+	unsigned noOfRanges;
+} MD380_Changes;
+
+/* Initialize */
+extern void INIT_MD380_Changes (MD380_Changes* changes);
+
+/* Free */
+extern void FREE_MD380_Changes (MD380_Changes* changes);
+
+/*=========================================================================
+	Takes the number of records of the original image from 'container',
+	to be called before loading anything into it; the changes recorded
+	before are cleared
+=========================================================================*/
+extern void md380_SetOriginalCounts (MD380_Changes* changes, const TRDTFile* container);
+
+/*=========================================================================
+	Encodes in 'image' the records of 'container' selected by 'tableMask'
+	(TABLE_xxx bits) that differ from the original and records the
+	changes. Returns CSVRET_OK or CSVRET_OUT_OF_MEMORY.
+=========================================================================*/
+extern int md380_EncodeChanges (t_buffer* image, const TRDTFile* container, unsigned tableMask, MD380_Changes* changes);
+
+/*=========================================================================
+	Prints a line for each record type changed
+=========================================================================*/
+extern void md380_ReportChanges (const MD380_Changes* changes, FILE* f);
+
+/*=========================================================================
+	Writes the changed regions of 'image' in the file 'fileName', which
+	holds the image from 'fileOffset' (see loadRdtFile).
+	Returns CSVRET_OK or MD380ERR_FILE_ERROR. The 'errorMessage' string
+	is allocated with binAlloc in case of error and it is to be freed
+	with binFree.
+=========================================================================*/
+extern int md380_WriteChanges (const char* fileName, const t_buffer* image, unsigned fileOffset, const MD380_Changes* changes, char** errorMessage);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
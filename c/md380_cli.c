@@ -4,6 +4,7 @@
 #include <string.h>
 #include "binlib.h"
 #include "crc.h"
+#include "md380.h"
 #include <assert.h>
 
 /* Initialize a CSVFileNames */
@@ -26,6 +27,37 @@ void FREE_CSVFileNames(CSVFileNames* fs)
 	memset (fs, 0, sizeof(*fs));
 }
 
+/* Returns the TABLE_xxx bits of the record types having a file name set */
+unsigned TABLES_CSVFileNames(const CSVFileNames* fs)
+{
+	unsigned tableMask = 0;
+	
+	if (fs->Path_ChannelInformation != NULL) tableMask |= TABLE_ChannelInformation;
+	if (fs->Path_DigitalContact != NULL) tableMask |= TABLE_DigitalContact;
+	if (fs->Path_DigitalRxGroupList != NULL) tableMask |= TABLE_DigitalRxGroupList;
+	if (fs->Path_GeneralSettings != NULL) tableMask |= TABLE_GeneralSettings;
+	if (fs->Path_ScanList != NULL) tableMask |= TABLE_ScanList;
+	if (fs->Path_TextMessage != NULL) tableMask |= TABLE_TextMessage;
+	if (fs->Path_ZoneInformation != NULL) tableMask |= TABLE_ZoneInformation;
+	
+	return tableMask;
+}
+
+/* Returns the file name of the record type number 'table', in the order of cliCommands */
+char** PATH_CSVFileNames(CSVFileNames* fs, unsigned table)
+{
+	switch (table) {
+		case 0: return &(fs->Path_ChannelInformation);
+		case 1: return &(fs->Path_DigitalContact);
+		case 2: return &(fs->Path_DigitalRxGroupList);
+		case 3: return &(fs->Path_GeneralSettings);
+		case 4: return &(fs->Path_ScanList);
+		case 5: return &(fs->Path_TextMessage);
+		case 6: return &(fs->Path_ZoneInformation);
+	}
+	return NULL;
+}
+
 /* Executes the parsing of the command line. It returns the number */
 /* of parameters consumed from the given position or CLI_xxx in case of error */
 int ParseCommandLine (CSVFileNames* fs, char** argv, int argc)
@@ -29,6 +29,12 @@ extern void INIT_CSVFileNames(CSVFileNames* fs);
 /* Free a CSVFileNames */
 extern void FREE_CSVFileNames(CSVFileNames* fs);
 
+/* Returns the TABLE_xxx bits of the record types having a file name set */
+extern unsigned TABLES_CSVFileNames(const CSVFileNames* fs);
+
+/* Returns the file name of the record type number 'table', in the order of cliCommands */
+extern char** PATH_CSVFileNames(CSVFileNames* fs, unsigned table);
+
 #define CLI_PARAMETER_UNKNOWN   0
 #define CLI_NOT_ENOUGH_PARAMS  -1
 #define CLI_DUPE_PARAMETER     -2
@@ -0,0 +1,255 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_colreader.h"
+#include <string.h>
+#include <ctype.h>
+#include <stdlib.h>
+#ifdef _WIN32
+#include <stdio.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define COL_HEADER_SIZE  16
+#define COL_TABLE_SIZE   16
+#define COL_COLUMN_SIZE  20
+#define COL_ENUM_SIZE    8
+
+/*=========================================================================
+	Checks that 'count' items of 'itemSize' octets starting at 'offset'
+	are aligned and within the file
+=========================================================================*/
+static int md380_ColInRange (const MD380_ColFile* cf, unsigned offset, unsigned count, unsigned itemSize)
+{
+	if ((offset & 3) != 0 || offset > cf->size) return 0;
+	return count <= (cf->size-offset)/itemSize;
+}
+
+/*=========================================================================
+	Checks the structure of the whole file, so that the accessors do
+	not need any further check
+=========================================================================*/
+static int md380_ColCheck (const MD380_ColFile* cf)
+{
+	const MD380_ColHeader* header = (const MD380_ColHeader*)cf->base;
+	unsigned one = 1;
+	unsigned t, c, e, r;
+	
+	/* The structures are mapped directly: only little endian hosts with 32 bits unsigned */
+	if (sizeof (unsigned) != 4 || sizeof (unsigned short) != 2 || *(unsigned char*)&one != 1) return MD380_COL_UNSUPPORTED;
+	
+	if (cf->size < COL_HEADER_SIZE+4 || (cf->size & 3) != 0) return MD380_COL_INVALID_FORMAT;
+	if (memcmp (header->magic, MD380_COL_MAGIC, 4) != 0) return MD380_COL_INVALID_FORMAT;
+	if (header->version != MD380_COL_VERSION || header->fileSize != cf->size) return MD380_COL_INVALID_FORMAT;
+	if (*(const unsigned*)(cf->base+cf->size-4) != 0) return MD380_COL_INVALID_FORMAT;
+	if (!md380_ColInRange (cf, COL_HEADER_SIZE, header->noOfTables, COL_TABLE_SIZE)) return MD380_COL_INVALID_FORMAT;
+	
+	for (t=0; t<header->noOfTables; t++) {
+		const MD380_ColTable* table = md380_ColGetTable (cf, t);
+		if (table->nameOffset >= cf->size) return MD380_COL_INVALID_FORMAT;
+		if (!md380_ColInRange (cf, table->columnsOffset, table->noOfColumns, COL_COLUMN_SIZE)) return MD380_COL_INVALID_FORMAT;
+		
+		for (c=0; c<table->noOfColumns; c++) {
+			const MD380_ColColumn* column = md380_ColGetColumn (cf, table, c);
+			const unsigned* values;
+			
+			if (column->nameOffset >= cf->size || column->columnType > MD380_COL_STRING) return MD380_COL_INVALID_FORMAT;
+			if (!md380_ColInRange (cf, column->dataOffset, table->rowCount, 4)) return MD380_COL_INVALID_FORMAT;
+			if (column->enumCount) {
+				const MD380_ColEnum* enums = (const MD380_ColEnum*)(cf->base+column->enumsOffset);
+				if (!md380_ColInRange (cf, column->enumsOffset, column->enumCount, COL_ENUM_SIZE)) return MD380_COL_INVALID_FORMAT;
+				for (e=0; e<column->enumCount; e++) {
+					if (enums[e].nameOffset >= cf->size) return MD380_COL_INVALID_FORMAT;
+				}
+			}
+			if (column->columnType == MD380_COL_STRING) {
+				values = md380_ColValues (cf, column);
+				for (r=0; r<table->rowCount; r++) {
+					if (values[r] >= cf->size || (values[r] & 1) != 0) return MD380_COL_INVALID_FORMAT;
+				}
+			}
+		}
+	}
+	return MD380_COL_OK;
+}
+
+/*=========================================================================
+	Maps the file 'fileName' in memory and checks its structure.
+=========================================================================*/
+int md380_ColOpen (MD380_ColFile* cf, const char* fileName)
+{
+	int ret;
+#ifdef _WIN32
+	FILE* f;
+	long size = -1;
+	unsigned char* buffer;
+	
+	memset (cf, 0, sizeof (*cf));
+	f = fopen (fileName, "rb");
+	if (f == NULL) return MD380_COL_FILE_ERROR;
+	if (fseek (f, 0, SEEK_END) != 0 || (size = ftell (f)) <= 0 || fseek (f, 0, SEEK_SET) != 0) {
+		fclose (f);
+		return (size == 0 ? MD380_COL_INVALID_FORMAT : MD380_COL_FILE_ERROR);
+	}
+	buffer = (unsigned char*)malloc ((size_t)size);
+	if (buffer == NULL) {
+		fclose (f);
+		return MD380_COL_OUT_OF_MEMORY;
+	}
+	if (fread (buffer, 1, (size_t)size, f) != (size_t)size) {
+		free (buffer);
+		fclose (f);
+		return MD380_COL_FILE_ERROR;
+	}
+	fclose (f);
+	cf->base = buffer;
+	cf->size = (unsigned long)size;
+	cf->mapped = 0;
+#else
+	int fd;
+	struct stat st;
+	void* map;
+	
+	memset (cf, 0, sizeof (*cf));
+	fd = open (fileName, O_RDONLY);
+	if (fd < 0) return MD380_COL_FILE_ERROR;
+	if (fstat (fd, &st) != 0) {
+		close (fd);
+		return MD380_COL_FILE_ERROR;
+	}
+	if (st.st_size < COL_HEADER_SIZE+4) {
+		close (fd);
+		return MD380_COL_INVALID_FORMAT;
+	}
+	map = mmap (NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close (fd);
+	if (map == MAP_FAILED) return MD380_COL_FILE_ERROR;
+	cf->base = (const unsigned char*)map;
+	cf->size = (unsigned long)st.st_size;
+	cf->mapped = 1;
+#endif
+
+	ret = md380_ColCheck (cf);
+	if (ret != MD380_COL_OK) {
+		md380_ColClose (cf);
+	}
+	return ret;
+}
+
+/*=========================================================================
+	Releases the file opened with md380_ColOpen
+=========================================================================*/
+void md380_ColClose (MD380_ColFile* cf)
+{
+	if (cf->base != NULL) {
+#ifdef _WIN32
+		free ((void*)cf->base);
+#else
+		if (cf->mapped) {
+			munmap ((void*)cf->base, (size_t)cf->size);
+		}
+		else {
+			free ((void*)cf->base);
+		}
+#endif
+	}
+	memset (cf, 0, sizeof (*cf));
+}
+
+/*=========================================================================
+	Case insensitive comparison of names
+=========================================================================*/
+static int md380_ColSameName (const char* a, const char* b)
+{
+	while (*a && tolower ((unsigned char)*a) == tolower ((unsigned char)*b)) {
+		a++;
+		b++;
+	}
+	return (*a == 0 && *b == 0);
+}
+
+/*=========================================================================
+	Table and column access
+=========================================================================*/
+const MD380_ColHeader* md380_ColGetHeader (const MD380_ColFile* cf)
+{
+	return (const MD380_ColHeader*)cf->base;
+}
+
+const MD380_ColTable* md380_ColGetTable (const MD380_ColFile* cf, unsigned tableNo)
+{
+	if (tableNo >= md380_ColGetHeader (cf)->noOfTables) return NULL;
+	return (const MD380_ColTable*)(cf->base+COL_HEADER_SIZE)+tableNo;
+}
+
+const MD380_ColTable* md380_ColFindTable (const MD380_ColFile* cf, const char* tableName)
+{
+	unsigned t;
+	for (t=0; t<md380_ColGetHeader (cf)->noOfTables; t++) {
+		const MD380_ColTable* table = md380_ColGetTable (cf, t);
+		if (md380_ColSameName (md380_ColName (cf, table->nameOffset), tableName)) return table;
+	}
+	return NULL;
+}
+
+const MD380_ColColumn* md380_ColGetColumn (const MD380_ColFile* cf, const MD380_ColTable* table, unsigned columnNo)
+{
+	if (columnNo >= table->noOfColumns) return NULL;
+	return (const MD380_ColColumn*)(cf->base+table->columnsOffset)+columnNo;
+}
+
+const MD380_ColColumn* md380_ColFindColumn (const MD380_ColFile* cf, const MD380_ColTable* table, const char* columnName)
+{
+	unsigned c;
+	for (c=0; c<table->noOfColumns; c++) {
+		const MD380_ColColumn* column = md380_ColGetColumn (cf, table, c);
+		if (md380_ColSameName (md380_ColName (cf, column->nameOffset), columnName)) return column;
+	}
+	return NULL;
+}
+
+const char* md380_ColName (const MD380_ColFile* cf, unsigned nameOffset)
+{
+	return (const char*)(cf->base+nameOffset);
+}
+
+const unsigned* md380_ColValues (const MD380_ColFile* cf, const MD380_ColColumn* column)
+{
+	return (const unsigned*)(cf->base+column->dataOffset);
+}
+
+const unsigned short* md380_ColString (const MD380_ColFile* cf, const MD380_ColColumn* column, unsigned rowNo)
+{
+	if (column->columnType != MD380_COL_STRING) return NULL;
+	return (const unsigned short*)(cf->base+md380_ColValues (cf, column)[rowNo]);
+}
+
+const char* md380_ColEnumName (const MD380_ColFile* cf, const MD380_ColColumn* column, unsigned value)
+{
+	const MD380_ColEnum* enums = (const MD380_ColEnum*)(cf->base+column->enumsOffset);
+	unsigned e;
+	for (e=0; e<column->enumCount; e++) {
+		if (enums[e].value == value) return md380_ColName (cf, enums[e].nameOffset);
+	}
+	return NULL;
+}
@@ -0,0 +1,131 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_COLREADER_H
+#define __MD380_COLREADER_H
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Columnar export format. All the values are 32 bits little endian
+	and all the blocks are aligned to 4 octets; offsets are counted
+	from the beginning of the file.
+	
+	    Header       magic "R2CC", version, noOfTables, fileSize
+	    Tables       noOfTables x MD380_ColTable
+	    Columns      MD380_ColColumn, per table starting at columnsOffset
+	    Enums        MD380_ColEnum, per column starting at enumsOffset
+	    Data         rowCount values per column, starting at dataOffset
+	    Heap         names (ASCII) and strings (UTF-16LE, aligned to 2),
+	                 zero terminated
+	
+	Numeric columns hold the value of the field, reference columns the
+	1-based row number of the referenced record (0 if none) and string
+	columns the heap offset of the string. The file always ends with 4
+	zero octets, so that every string in the heap is terminated.
+	
+	This reader is self contained: it does not depend on binlib and it
+	can be copied into other projects.
+=========================================================================*/
+#define MD380_COL_MAGIC            "R2CC"
+#define MD380_COL_VERSION          1
+
+#define MD380_COL_NUMERIC          0
+#define MD380_COL_REFERENCE        1
+#define MD380_COL_STRING           2
+
+/* Return values of md380_ColOpen */
+#define MD380_COL_OK               0
+#define MD380_COL_FILE_ERROR      -1
+#define MD380_COL_INVALID_FORMAT  -2
+#define MD380_COL_OUT_OF_MEMORY   -3
+#define MD380_COL_UNSUPPORTED     -4
+
+typedef struct {
+	char magic[4];
+	unsigned version;
+	unsigned noOfTables;
+	unsigned fileSize;
+} MD380_ColHeader;
+
+typedef struct {
+	unsigned nameOffset;
+	unsigned rowCount;
+	unsigned noOfColumns;
+	unsigned columnsOffset;
+} MD380_ColTable;
+
+typedef struct {
+	unsigned nameOffset;
+	unsigned columnType;
+	unsigned enumCount;
+	unsigned enumsOffset;
+	unsigned dataOffset;
+} MD380_ColColumn;
+
+typedef struct {
+	unsigned value;
+	unsigned nameOffset;
+} MD380_ColEnum;
+
+/* An open columnar file; the structures above point directly into it */
+typedef struct {
+	const unsigned char* base;
+	unsigned long size;
+	int mapped;
+} MD380_ColFile;
+
+/*=========================================================================
+	Maps the file 'fileName' in memory and checks its structure.
+	Returns MD380_COL_xxx; on success, close it with md380_ColClose.
+=========================================================================*/
+extern int md380_ColOpen (MD380_ColFile* cf, const char* fileName);
+
+/*=========================================================================
+	Releases the file opened with md380_ColOpen
+=========================================================================*/
+extern void md380_ColClose (MD380_ColFile* cf);
+
+/*=========================================================================
+	Table and column access. The Find functions return NULL if the
+	name is not found; names are compared case insensitive.
+=========================================================================*/
+extern const MD380_ColHeader* md380_ColGetHeader (const MD380_ColFile* cf);
+extern const MD380_ColTable* md380_ColGetTable (const MD380_ColFile* cf, unsigned tableNo);
+extern const MD380_ColTable* md380_ColFindTable (const MD380_ColFile* cf, const char* tableName);
+extern const MD380_ColColumn* md380_ColGetColumn (const MD380_ColFile* cf, const MD380_ColTable* table, unsigned columnNo);
+extern const MD380_ColColumn* md380_ColFindColumn (const MD380_ColFile* cf, const MD380_ColTable* table, const char* columnName);
+
+/* Name stored in the heap at 'nameOffset' */
+extern const char* md380_ColName (const MD380_ColFile* cf, unsigned nameOffset);
+
+/* Values of the column: rowCount entries of the owning table */
+extern const unsigned* md380_ColValues (const MD380_ColFile* cf, const MD380_ColColumn* column);
+
+/* String of a MD380_COL_STRING column, zero terminated UTF-16 */
+extern const unsigned short* md380_ColString (const MD380_ColFile* cf, const MD380_ColColumn* column, unsigned rowNo);
+
+/* Name of an enumerated value, NULL if the value has no name */
+extern const char* md380_ColEnumName (const MD380_ColFile* cf, const MD380_ColColumn* column, unsigned value);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
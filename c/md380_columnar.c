@@ -0,0 +1,192 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_columnar.h"
+#include "md380_tools.h"
+#include "md380_stats.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#define COLUMNAR_HEADER_SIZE  16
+#define COLUMNAR_TABLE_SIZE   16
+#define COLUMNAR_COLUMN_SIZE  20
+#define COLUMNAR_ENUM_SIZE    8
+
+/* Builder of the columnar image; with a NULL buffer, it only measures it */
+typedef struct {
+	t_buffer* buffer;
+	unsigned heapPos;
+} ColumnarWriter;
+
+/*=========================================================================
+	Stores a little endian value at the given octet position
+=========================================================================*/
+static void md380_ColumnarPut (ColumnarWriter* w, unsigned position, unsigned bits, t_numeric value)
+{
+	if (w->buffer) numericToBinary (w->buffer, position*8, value, bits);
+}
+
+/*=========================================================================
+	Appends a name to the heap, returning its position
+=========================================================================*/
+static unsigned md380_ColumnarPutName (ColumnarWriter* w, const char* name)
+{
+	unsigned position = w->heapPos;
+	unsigned length = (unsigned)strlen (name)+1;
+	if (w->buffer) memcpy (w->buffer+position, name, length);
+	w->heapPos += length;
+	return position;
+}
+
+/*=========================================================================
+	Appends a UTF-16LE string to the heap, returning its position
+=========================================================================*/
+static unsigned md380_ColumnarPutString (ColumnarWriter* w, const t_unicode* text, unsigned maxChars)
+{
+	unsigned position;
+	unsigned i;
+	
+	w->heapPos = (w->heapPos+1) & ~1u;
+	position = w->heapPos;
+	for (i=0; i<maxChars && text[i]; i++) {
+		md380_ColumnarPut (w, w->heapPos, 16, text[i]);
+		w->heapPos += 2;
+	}
+	md380_ColumnarPut (w, w->heapPos, 16, 0);
+	w->heapPos += 2;
+	return position;
+}
+
+/*=========================================================================
+	Builds the columnar image of the container and returns its size
+=========================================================================*/
+static unsigned md380_ColumnarBuild (ColumnarWriter* w, const TRDTFile* container)
+{
+	unsigned tablePos = COLUMNAR_HEADER_SIZE;
+	unsigned columnPos = tablePos + NO_OF_RECORDS_TRDTFile*COLUMNAR_TABLE_SIZE;
+	unsigned enumPos;
+	unsigned dataPos;
+	unsigned noOfColumns = 0;
+	unsigned noOfEnums = 0;
+	unsigned noOfValues = 0;
+	unsigned t, c, e, r;
+	
+	/* Place the fixed size blocks before the heap */
+	for (t=0; t<NO_OF_RECORDS_TRDTFile; t++) {
+		const RecordDescriptor* rd = RECORDS_TRDTFile+t;
+		noOfColumns += rd->noOfFields;
+		noOfValues += rd->noOfFields * md380_RecordCount (rd, container);
+		for (c=0; c<rd->noOfFields; c++) {
+			noOfEnums += rd->fieldDescriptors[c].enumCount;
+		}
+	}
+	enumPos = columnPos + noOfColumns*COLUMNAR_COLUMN_SIZE;
+	dataPos = enumPos + noOfEnums*COLUMNAR_ENUM_SIZE;
+	w->heapPos = dataPos + noOfValues*4;
+	
+	/* Header */
+	if (w->buffer) memcpy (w->buffer, MD380_COL_MAGIC, 4);
+	md380_ColumnarPut (w, 4, 32, MD380_COL_VERSION);
+	md380_ColumnarPut (w, 8, 32, NO_OF_RECORDS_TRDTFile);
+	
+	for (t=0; t<NO_OF_RECORDS_TRDTFile; t++) {
+		const RecordDescriptor* rd = RECORDS_TRDTFile+t;
+		const unsigned char* records = (const unsigned char*)container+rd->containerOffset;
+		unsigned rowCount = md380_RecordCount (rd, container);
+		
+		md380_ColumnarPut (w, tablePos, 32, md380_ColumnarPutName (w, rd->recordName));
+		md380_ColumnarPut (w, tablePos+4, 32, rowCount);
+		md380_ColumnarPut (w, tablePos+8, 32, rd->noOfFields);
+		md380_ColumnarPut (w, tablePos+12, 32, columnPos);
+		tablePos += COLUMNAR_TABLE_SIZE;
+		
+		for (c=0; c<rd->noOfFields; c++) {
+			const FieldDescriptor* fd = rd->fieldDescriptors+c;
+			const FieldLayout* fl = rd->fieldLayouts+c;
+			unsigned columnType = (fl->layoutType == FL_unicode ? MD380_COL_STRING : (fl->layoutType == FL_reference ? MD380_COL_REFERENCE : MD380_COL_NUMERIC));
+			
+			md380_ColumnarPut (w, columnPos, 32, md380_ColumnarPutName (w, fd->fieldName));
+			md380_ColumnarPut (w, columnPos+4, 32, columnType);
+			md380_ColumnarPut (w, columnPos+8, 32, fd->enumCount);
+			md380_ColumnarPut (w, columnPos+12, 32, fd->enumCount ? enumPos : 0);
+			md380_ColumnarPut (w, columnPos+16, 32, dataPos);
+			columnPos += COLUMNAR_COLUMN_SIZE;
+			
+			for (e=0; e<fd->enumCount; e++) {
+				md380_ColumnarPut (w, enumPos, 32, fd->fieldEnumerators[e].enumValue);
+				md380_ColumnarPut (w, enumPos+4, 32, md380_ColumnarPutName (w, fd->fieldEnumerators[e].enumName));
+				enumPos += COLUMNAR_ENUM_SIZE;
+			}
+			
+			for (r=0; r<rowCount; r++) {
+				const unsigned char* field = records + r*rd->recordSize + fl->structOffset;
+				t_numeric value;
+				switch (fl->layoutType) {
+					case FL_numeric: value = md380_GetNumeric (field, fl->numericSize); break;
+					case FL_reference: value = ((const t_reference*)field)->refLineNo; break;
+					default: value = md380_ColumnarPutString (w, (const t_unicode*)field, fl->unicodeChars); break;
+				}
+				md380_ColumnarPut (w, dataPos, 32, value);
+				dataPos += 4;
+			}
+		}
+	}
+	
+	/* Align and terminate with 4 zero octets */
+	w->heapPos = ((w->heapPos+3) & ~3u) + 4;
+	md380_ColumnarPut (w, 12, 32, w->heapPos);
+	return w->heapPos;
+}
+
+/*=========================================================================
+	Saves all the tables of the container into the columnar file
+=========================================================================*/
+int md380_SaveColumnar (const char* fileName, const TRDTFile* container, char** errorMessage)
+{
+	ColumnarWriter w;
+	unsigned size;
+	FILE* f;
+	int ret = CSVRET_OK;
+	
+	/* Measure, then build the image */
+	w.buffer = NULL;
+	size = md380_ColumnarBuild (&w, container);
+	w.buffer = (t_buffer*)binAlloc (size);
+	if (w.buffer == NULL) return CSVRET_OUT_OF_MEMORY;
+	memset (w.buffer, 0, size);
+	md380_ColumnarBuild (&w, container);
+	
+	f = fopen (fileName, "wb");
+	if (f == NULL) {
+		ret = MD380ERR_FILE_ERROR;
+	}
+	else {
+		if (fwrite (w.buffer, 1, size, f) != size) ret = MD380ERR_FILE_ERROR;
+		MD380_STATS_ADD (bytesWritten, size);
+		if (fclose (f) != 0) ret = MD380ERR_FILE_ERROR;
+	}
+	if (ret != CSVRET_OK) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+128);
+		if ((*errorMessage) != NULL) {
+			sprintf ((*errorMessage), "Error writing '%s' (%s)", fileName, strerror (errno));
+		}
+	}
+	binFree (w.buffer);
+	return ret;
+}
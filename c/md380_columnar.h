@@ -0,0 +1,41 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_COLUMNAR_H
+#define __MD380_COLUMNAR_H
+#include "md380.h"
+#include "md380_colreader.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Saves all the tables of the container into the columnar file
+	'fileName' (see md380_colreader.h for the format). The file is
+	built in memory from RECORDS_TRDTFile and written at once.
+	Returns CSVRET_xxx and MD380ERR_xxx values. The 'errorMessage'
+	string is allocated with binAlloc in case of error and it is to be
+	freed with binFree.
+=========================================================================*/
+extern int md380_SaveColumnar (const char* fileName, const TRDTFile* container, char** errorMessage);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -0,0 +1,343 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_field.h"
+#include "md380_cli.h"
+#include "crc.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <assert.h>
+
+/*=========================================================================
+	Allocates the error message for a field
+=========================================================================*/
+static void fieldError (const MD380_FieldLocation* location, const char* text, const char* reason, char** errorMessage)
+{
+	(*errorMessage) = (char*)binAlloc (strlen (location->recordDescriptor->recordName)+strlen (location->fieldDescriptor->fieldName)+strlen (text)+strlen (reason)+60);
+	if (*errorMessage) {
+		sprintf ((*errorMessage), "Error in %s, field %s: %s '%s'", location->recordDescriptor->recordName, location->fieldDescriptor->fieldName, reason, text);
+	}
+}
+
+/*=========================================================================
+	Number of characters of FC_unicode and FC_ascii fields
+=========================================================================*/
+static unsigned fieldChars (const FieldLayout* fl)
+{
+	return (fl->codec == FC_unicode ? fl->binaryLengthBits/16 : fl->binaryLengthBits/8);
+}
+
+/*=========================================================================
+	Finds a record type
+=========================================================================*/
+unsigned md380_FindRecordType (const char* recordName)
+{
+	unsigned nameCrc = crc32_AddAsciizLowerCase (0, recordName);
+	unsigned i, k;
+	for (i=0; i<NO_OF_RECORDS_TRDTFile; i++) {
+		if (crc32_AddAsciizLowerCase (0, RECORDS_TRDTFile[i].recordName) == nameCrc) return i;
+	}
+	for (i=0; i<NO_OF_CLI_COMMANDS; i++) {
+		if (crc32_AddAsciizLowerCase (0, cliCommands[i].parameter+1) == nameCrc) {
+			for (k=0; k<NO_OF_RECORDS_TRDTFile; k++) {
+				if (strcmp (RECORDS_TRDTFile[k].recordName, cliCommands[i].recordName) == 0) return k;
+			}
+		}
+	}
+	return NO_OF_RECORDS_TRDTFile;
+}
+
+/*=========================================================================
+	Locates a field
+=========================================================================*/
+int md380_LocateField (const char* recordName, unsigned recordNo, const char* fieldName, MD380_FieldLocation* location, char** errorMessage)
+{
+	const RecordDescriptor* rd;
+	unsigned nameCrc;
+	unsigned i;
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	memset (location, 0, sizeof (*location));
+
+	/* Find the record type by name or by CSV option */
+	i = md380_FindRecordType (recordName);
+	if (i >= NO_OF_RECORDS_TRDTFile) {
+		(*errorMessage) = (char*)binAlloc (strlen (recordName)+40);
+		if (*errorMessage) sprintf ((*errorMessage), "Unknown record type '%s'", recordName);
+		return MD380ERR_FIELD_NOT_FOUND;
+	}
+	rd = RECORDS_TRDTFile+i;
+	if (recordNo < 1 || recordNo > rd->maxCount) {
+		(*errorMessage) = (char*)binAlloc (strlen (rd->recordName)+60);
+		if (*errorMessage) sprintf ((*errorMessage), "Error in %s: line %u out of range 1..%u", rd->recordName, recordNo, rd->maxCount);
+		return MD380ERR_FIELD_NOT_FOUND;
+	}
+
+	/* Find the field */
+	nameCrc = crc32_AddAsciizLowerCase (0, fieldName);
+	for (i=0; i<rd->noOfFields; i++) {
+		if (rd->fieldDescriptors[i].fieldNameCRC == nameCrc) break;
+	}
+	if (i >= rd->noOfFields) {
+		(*errorMessage) = (char*)binAlloc (strlen (rd->recordName)+strlen (fieldName)+40);
+		if (*errorMessage) sprintf ((*errorMessage), "Error in %s: unknown field '%s'", rd->recordName, fieldName);
+		return MD380ERR_FIELD_NOT_FOUND;
+	}
+
+	location->recordDescriptor = rd;
+	location->fieldDescriptor = rd->fieldDescriptors+i;
+	location->fieldLayout = rd->fieldLayouts+i;
+	location->bitOffset = (rd->binaryOffset + (recordNo-1)*(rd->binaryLength/rd->maxCount))*8 + location->fieldLayout->binaryOffsetBits;
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Reads a field from a buffer
+=========================================================================*/
+int md380_GetField (const t_buffer* buffer, unsigned bitOffset, const MD380_FieldLocation* location, char* text, unsigned textSize, char** errorMessage)
+{
+	const FieldLayout* fl = location->fieldLayout;
+	const FieldDescriptor* fd = location->fieldDescriptor;
+	t_numeric value = 0;
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	assert (textSize >= 24);
+
+	switch (fl->codec) {
+		case FC_unicode:
+		case FC_ascii: {
+			unsigned chars = fieldChars (fl);
+			t_unicode* u = (t_unicode*)binAlloc ((chars+1)*sizeof (t_unicode));
+			if (u == NULL) return CSVRET_OUT_OF_MEMORY;
+			if (fl->codec == FC_unicode) {
+				binaryToUnicode (buffer, bitOffset, u, fl->binaryLengthBits);
+			}
+			else {
+				asciiBinaryToUnicode (buffer, bitOffset, u, fl->binaryLengthBits);
+			}
+			u[chars] = 0;
+			unicodeToUtf8 (text, textSize, u);
+			binFree (u);
+			return CSVRET_OK;
+		}
+		case FC_bits:     value = bitsToNumeric (buffer, bitOffset, fl->binaryLengthBits); break;
+		case FC_binary:   value = binaryToNumeric (buffer, bitOffset, fl->binaryLengthBits); break;
+		case FC_bcd:      value = BCDToNumeric (buffer, bitOffset, fl->binaryLengthBits); break;
+		case FC_revBcd:   value = RevBCDToNumeric (buffer, bitOffset, fl->binaryLengthBits); break;
+		case FC_bcdTones: value = BCDToNumericForTones (buffer, bitOffset); break;
+	}
+
+	/* Numbers are shown by enumeration name when available */
+	if (fl->layoutType == FL_numeric) {
+		unsigned i;
+		for (i=0; i<fd->enumCount; i++) {
+			if (fd->fieldEnumerators[i].enumValue == value) {
+				strncpy (text, fd->fieldEnumerators[i].enumName, textSize-1);
+				text[textSize-1] = 0;
+				return CSVRET_OK;
+			}
+		}
+	}
+	sprintf (text, "%lu", (unsigned long)value);
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Writes a field into a buffer
+=========================================================================*/
+int md380_SetField (t_buffer* buffer, unsigned bitOffset, const MD380_FieldLocation* location, const char* text, char** errorMessage)
+{
+	const FieldLayout* fl = location->fieldLayout;
+	const FieldDescriptor* fd = location->fieldDescriptor;
+	t_numeric value = 0;
+	t_numeric limit = 1;
+	unsigned i;
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+
+	switch (fl->codec) {
+		case FC_unicode:
+		case FC_ascii: {
+			unsigned chars = fieldChars (fl);
+			t_unicode* u = (t_unicode*)binAlloc ((chars+1)*sizeof (t_unicode));
+			if (u == NULL) return CSVRET_OUT_OF_MEMORY;
+			memset (u, 0, (chars+1)*sizeof (t_unicode));
+			if (utf8ToUnicode (u, chars, text, strlen (text)) > chars) {
+				binFree (u);
+				fieldError (location, text, "value too long", errorMessage);
+				return MD380ERR_INVALID_VALUE;
+			}
+			if (fl->codec == FC_unicode) {
+				unicodeToBinary (buffer, bitOffset, u, fl->binaryLengthBits);
+			}
+			else {
+				unicodeToAsciiBinary (buffer, bitOffset, u, fl->binaryLengthBits);
+			}
+			binFree (u);
+			return CSVRET_OK;
+		}
+		default: break;
+	}
+
+	/* Numbers are given either by enumeration name or in decimal */
+	for (i=0; i<fd->enumCount && fl->layoutType == FL_numeric; i++) {
+		if (fd->fieldEnumerators[i].enumNameCRC == crc32_AddAsciizLowerCase (0, text)) break;
+	}
+	if (fl->layoutType == FL_numeric && i < fd->enumCount) {
+		value = fd->fieldEnumerators[i].enumValue;
+	}
+	else {
+		char* end;
+		errno = 0;
+		value = strtoul (text, &end, 10);
+		if (*text < '0' || *text > '9' || *end != 0 || errno) {
+			fieldError (location, text, "invalid value", errorMessage);
+			return MD380ERR_INVALID_VALUE;
+		}
+	}
+
+	switch (fl->codec) {
+		case FC_bits:
+		case FC_binary:
+			for (i=0; i<fl->binaryLengthBits; i++) limit *= 2;
+			break;
+		case FC_bcd:
+		case FC_revBcd:
+			for (i=0; i<fl->binaryLengthBits/4; i++) limit *= 10;
+			break;
+		default:
+			limit = 0;
+	}
+	if (limit && value >= limit) {
+		fieldError (location, text, "value out of range", errorMessage);
+		return MD380ERR_INVALID_VALUE;
+	}
+
+	switch (fl->codec) {
+		case FC_bits:     numericToBits (buffer, bitOffset, value, fl->binaryLengthBits); break;
+		case FC_binary:   numericToBinary (buffer, bitOffset, value, fl->binaryLengthBits); break;
+		case FC_bcd:      numericToBCD (buffer, bitOffset, value, fl->binaryLengthBits); break;
+		case FC_revBcd:   numericToRevBCD (buffer, bitOffset, value, fl->binaryLengthBits); break;
+		case FC_bcdTones: numericToBCDForTones (buffer, bitOffset, value); break;
+		default: assert (0);
+	}
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Opens a .rdt or .bin file and loads the octets holding the field.
+	On success '*f' is open, '*window' holds the octets and '*windowOffset'
+	is the bit offset of the field within the window.
+=========================================================================*/
+static int loadFieldWindow (const char* fileName, const char* mode, const MD380_FieldLocation* location, FILE** f, t_buffer** window, unsigned* windowLength, long* filePosition, unsigned* windowOffset, char** errorMessage)
+{
+	struct stat st;
+	unsigned imageOffset = 0;
+	unsigned first = location->bitOffset/8;
+	unsigned last = (location->bitOffset+location->fieldLayout->binaryLengthBits-1)/8;
+	const char* reason = NULL;
+	(*f) = NULL;
+	(*window) = NULL;
+
+	if (stat (fileName, &st)) {
+		reason = strerror (errno);
+	}
+	else if (st.st_size == FILE_SIZE_TBINFile) {
+		imageOffset = FILE_OFST_TBINFile;
+	}
+	else if (st.st_size != FILE_SIZE_TRDTFile) {
+		reason = "size does not match a .rdt, .img or .bin file";
+	}
+	if (reason == NULL && first < imageOffset) {
+		reason = "field not present in a .bin file";
+	}
+	if (reason == NULL) {
+		(*f) = fopen (fileName, mode);
+		if ((*f) == NULL) reason = strerror (errno);
+	}
+	if (reason == NULL) {
+		(*windowLength) = last-first+1;
+		(*filePosition) = (long)(first-imageOffset);
+		(*windowOffset) = location->bitOffset - first*8;
+		(*window) = binAlloc (*windowLength);
+		if ((*window) == NULL) reason = "out of memory";
+	}
+	if (reason == NULL) {
+		if (fseek ((*f), (*filePosition), SEEK_SET) || fread ((*window), 1, (*windowLength), (*f)) != (*windowLength)) {
+			reason = "read error";
+		}
+	}
+	if (reason) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+strlen (reason)+40);
+		if (*errorMessage) sprintf ((*errorMessage), "Error in file '%s': %s", fileName, reason);
+		if (*f) {fclose (*f); (*f) = NULL;}
+		if (*window) {binFree (*window); (*window) = NULL;}
+		return MD380ERR_FILE_ERROR;
+	}
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Reads a field from a file
+=========================================================================*/
+int md380_GetFileField (const char* fileName, const MD380_FieldLocation* location, char* text, unsigned textSize, char** errorMessage)
+{
+	FILE* f;
+	t_buffer* window;
+	unsigned windowLength, windowOffset;
+	long filePosition;
+	int ret = loadFieldWindow (fileName, "rb", location, &f, &window, &windowLength, &filePosition, &windowOffset, errorMessage);
+	if (ret != CSVRET_OK) return ret;
+
+	ret = md380_GetField (window, windowOffset, location, text, textSize, errorMessage);
+	fclose (f);
+	binFree (window);
+	return ret;
+}
+
+/*=========================================================================
+	Writes a field into a file
+=========================================================================*/
+int md380_SetFileField (const char* fileName, const MD380_FieldLocation* location, const char* text, char** errorMessage)
+{
+	FILE* f;
+	t_buffer* window;
+	unsigned windowLength, windowOffset;
+	long filePosition;
+	int ret = loadFieldWindow (fileName, "r+b", location, &f, &window, &windowLength, &filePosition, &windowOffset, errorMessage);
+	if (ret != CSVRET_OK) return ret;
+
+	ret = md380_SetField (window, windowOffset, location, text, errorMessage);
+	if (ret == CSVRET_OK) {
+		if (fseek (f, filePosition, SEEK_SET) || fwrite (window, 1, windowLength, f) != windowLength) {
+			(*errorMessage) = (char*)binAlloc (strlen (fileName)+40);
+			if (*errorMessage) sprintf ((*errorMessage), "Error in file '%s': write error", fileName);
+			ret = MD380ERR_FILE_ERROR;
+		}
+	}
+	if (fclose (f) && ret == CSVRET_OK) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+40);
+		if (*errorMessage) sprintf ((*errorMessage), "Error in file '%s': write error", fileName);
+		ret = MD380ERR_FILE_ERROR;
+	}
+	binFree (window);
+	return ret;
+}
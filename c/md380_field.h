@@ -0,0 +1,103 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_FIELD_H
+#define __MD380_FIELD_H
+#include "md380.h"
+#include "md380_tools.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Field level access to a binary image.
+	
+	A field is located from the descriptor tables (RECORDS_TRDTFile and
+	the LAYOUT_xxx tables) and read or written directly in the image with
+	the binlib codecs: no container is decoded, nothing is validated and
+	no other record is touched.
+	
+	Values are exchanged as text: numbers in decimal or as enumeration
+	names, names in UTF-8. References are exchanged as the 1-based number
+	of the referenced record (0 if none), as stored in the image.
+=========================================================================*/
+
+/* Location of one field of one record in the image */
+typedef struct {
+	const RecordDescriptor* recordDescriptor;
+	const FieldDescriptor* fieldDescriptor;
+	const FieldLayout* fieldLayout;
+	
+	/* Position of the field in bits from the beginning of the .rdt image */
+	unsigned bitOffset;
+} MD380_FieldLocation;
+
+/* Size of a text buffer large enough for any field value */
+#define MD380_FIELD_TEXT_SIZE 1024
+
+/*=========================================================================
+	Finds a record type, either by name (e.g. "ChannelInformation") or by
+	its CSV option without dash (e.g. "ch"), any case. Returns its index
+	in RECORDS_TRDTFile, NO_OF_RECORDS_TRDTFile if not found.
+=========================================================================*/
+extern unsigned md380_FindRecordType (const char* recordName);
+
+/*=========================================================================
+	Locates a field.
+	
+	PARAMETERS
+	
+	recordName   record type, either by name (e.g. "ChannelInformation") or
+	             by its CSV option without dash (e.g. "ch"), any case
+	recordNo     1-based record number; 1 for single records
+	fieldName    field name as in the CSV header, any case
+	location     receives the location
+	
+	Returns CSVRET_OK or MD380ERR_FIELD_NOT_FOUND. The 'errorMessage'
+	string is allocated with binAlloc in case of error and it is to be
+	freed with binFree.
+=========================================================================*/
+extern int md380_LocateField (const char* recordName, unsigned recordNo, const char* fieldName, MD380_FieldLocation* location, char** errorMessage);
+
+/*=========================================================================
+	Reads or writes a located field in a buffer; the field starts at
+	bit 'bitOffset' of 'buffer' (location->bitOffset for a whole .rdt
+	image as returned by loadRdtFile).
+	
+	md380_GetField writes the zero terminated value in 'text', which is
+	'textSize' octets long. md380_SetField returns MD380ERR_INVALID_VALUE
+	if 'text' is not a valid value for the field.
+	
+	Returns CSVRET_xxx and MD380ERR_xxx values, with 'errorMessage' as
+	md380_LocateField.
+=========================================================================*/
+extern int md380_GetField (const t_buffer* buffer, unsigned bitOffset, const MD380_FieldLocation* location, char* text, unsigned textSize, char** errorMessage);
+extern int md380_SetField (t_buffer* buffer, unsigned bitOffset, const MD380_FieldLocation* location, const char* text, char** errorMessage);
+
+/*=========================================================================
+	Same as md380_GetField/md380_SetField, working on a .rdt or .bin
+	file; only the octets holding the field are read and written.
+=========================================================================*/
+extern int md380_GetFileField (const char* fileName, const MD380_FieldLocation* location, char* text, unsigned textSize, char** errorMessage);
+extern int md380_SetFileField (const char* fileName, const MD380_FieldLocation* location, const char* text, char** errorMessage);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
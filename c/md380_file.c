@@ -1,10 +1,45 @@
 /* Generated by Macrocoder - do not edit */
 #define _CRT_SECURE_NO_WARNINGS
 #include "md380_file.h"
+#include "md380_stats.h"
 #include <stdio.h>
 #include <assert.h>
 #include <errno.h>
 
+/* Function that saves all the records of 'ChannelInformation' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int saveCSVStream_ChannelInformation (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	MD380_StatsTimer timer;
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	MD380_STATS_START (&timer);
+	ret = encodeCSVHeader_ChannelInformation (separator, writeBinaryFunc, writeBinaryFuncParameter);
+	if (ret != CSVRET_OK) {
+		(*errorMessage) = (char*)binAlloc (strlen (streamName)+146);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", streamName, md380_CsvRetToString (ret));
+		goto exitFunc;
+	}
+
+	for (i=0; i<container->ChannelInformation_COUNT; i++) {
+		ret = encodeCSVRecord_ChannelInformation (i, separator, writeBinaryFunc, writeBinaryFuncParameter, container->ChannelInformation+i, errorMessage);
+		if (ret != CSVRET_OK) break;
+	}
+
+
+	exitFunc:
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_WRITE, TABLE_ChannelInformation, container->ChannelInformation_COUNT);
+	return ret;
+}
+
 /* Function that opens a file and saves all the records of 'ChannelInformation'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
@@ -13,7 +48,6 @@ int saveCSVFile_ChannelInformation (const char* fileName, const TRDTFile* contai
 {
 	int ret = CSVRET_OK;
 	FILE* f = NULL;
-	unsigned i;
 	
 	assert (errorMessage != NULL);
 	assert ((*errorMessage) == NULL);
@@ -27,54 +61,84 @@ int saveCSVFile_ChannelInformation (const char* fileName, const TRDTFile* contai
 		goto exitFunc;
 	}
 
-	ret = encodeCSVHeader_ChannelInformation (separator, md380_FILEWriteBinaryFunc, f);
-	if (ret != CSVRET_OK) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
-		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", fileName, md380_CsvRetToString (ret));
-		goto exitFunc;
-	}
-
-	for (i=0; i<container->ChannelInformation_COUNT; i++) {
-		ret = encodeCSVRecord_ChannelInformation (i, separator, md380_FILEWriteBinaryFunc, f, container->ChannelInformation+i, errorMessage);
-		if (ret != CSVRET_OK) break;
-	}
-
-
+	ret = saveCSVStream_ChannelInformation (fileName, container, separator, md380_FILEWriteBinaryFunc, f, errorMessage);
+	
 	exitFunc:
 	if (f) fclose (f);
 	return ret;
 }
 
-/* Function that opens a file and reads all the records of 'ChannelInformation'. */
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'ChannelInformation' record, where 'fieldNo' indexes DESC_ChannelInformation. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+int loadCSVField_ChannelInformation (unsigned fieldNo, T_ChannelInformation* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	
+	switch (fieldNo) {
+		case 0: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+0, &(record->LoneWorker), sizeof (record->LoneWorker), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 1: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+1, &(record->Squelch), sizeof (record->Squelch), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 2: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+2, &(record->Autoscan), sizeof (record->Autoscan), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 3: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+3, &(record->Bandwidth), sizeof (record->Bandwidth), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 4: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+4, &(record->ChannelMode), sizeof (record->ChannelMode), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 5: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+5, &(record->Colorcode), sizeof (record->Colorcode), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 6: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+6, &(record->RepeaterSlot), sizeof (record->RepeaterSlot), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 7: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+7, &(record->RxOnly), sizeof (record->RxOnly), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 8: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+8, &(record->AllowTalkaround), sizeof (record->AllowTalkaround), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 9: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+9, &(record->DataCallConf), sizeof (record->DataCallConf), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 10: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+10, &(record->PrivateCallConf), sizeof (record->PrivateCallConf), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 11: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+11, &(record->Privacy), sizeof (record->Privacy), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 12: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+12, &(record->PrivacyNo), sizeof (record->PrivacyNo), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 13: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+13, &(record->DisplayPttId), sizeof (record->DisplayPttId), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 14: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+14, &(record->CompressedUdpHdr), sizeof (record->CompressedUdpHdr), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 15: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+15, &(record->EmergencyAlarmAck), sizeof (record->EmergencyAlarmAck), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 16: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+16, &(record->RxRefFrequency), sizeof (record->RxRefFrequency), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 17: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+17, &(record->AdmintCriteria), sizeof (record->AdmintCriteria), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 18: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+18, &(record->Power), sizeof (record->Power), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 19: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+19, &(record->Vox), sizeof (record->Vox), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 20: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+20, &(record->QtReverse), sizeof (record->QtReverse), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 21: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+21, &(record->ReverseBurst), sizeof (record->ReverseBurst), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 22: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+22, &(record->TxRefFrequency), sizeof (record->TxRefFrequency), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 23: ret = md380_ReadFieldReferenceNumeric (DESC_ChannelInformation+23, &(record->ContactName), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 24: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+24, &(record->Tot), sizeof (record->Tot), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 25: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+25, &(record->TotRekeyDelay), sizeof (record->TotRekeyDelay), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 26: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+26, &(record->EmergencySystem), sizeof (record->EmergencySystem), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 27: ret = md380_ReadFieldReferenceUnicode (DESC_ChannelInformation+27, &(record->ScanList), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 28: ret = md380_ReadFieldReferenceUnicode (DESC_ChannelInformation+28, &(record->GroupList), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 29: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+29, &(record->Decode18), sizeof (record->Decode18), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 30: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+30, &(record->RxFrequency), sizeof (record->RxFrequency), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 31: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+31, &(record->TxFrequency), sizeof (record->TxFrequency), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 32: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+32, &(record->CtcssDcsDecode), sizeof (record->CtcssDcsDecode), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 33: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+33, &(record->CtcssDcsEncode), sizeof (record->CtcssDcsEncode), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 34: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+34, &(record->TxSignalingSyst), sizeof (record->TxSignalingSyst), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 35: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+35, &(record->RxSignalingSyst), sizeof (record->RxSignalingSyst), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 36: ret = md380_ReadFieldUnicode (DESC_ChannelInformation+36, record->Name, 16, fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		default: assert (0);
+	}
+	return ret;
+}
+
+/* Function that reads all the records of 'ChannelInformation' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
-int loadCSVFile_ChannelInformation (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
+int loadCSVStream_ChannelInformation (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
 {
 	int ret;
 	unsigned i, j, numberOfColumns;
 	unsigned fieldsMap[FIELDS_ChannelInformation];
-	FILE* f = NULL;
 	T_ChannelInformation record;
+	MD380_StatsTimer timer;
 	
+	MD380_STATS_START (&timer);
 
 	/* Clear the container */
 	container->ChannelInformation_COUNT = 0;
 
 	
-	/* Open the file for reading */
-	f = fopen (fileName, "rb");
-	if (f == NULL) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
-		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
-		ret = MD380ERR_FILE_ERROR;
-		goto exitFunc;
-	}
-	
 	/* Read the titles */
-	ret = md380_ReadColumnsMapping (DESC_ChannelInformation, FIELDS_ChannelInformation, fieldsMap, &numberOfColumns, separator, md380_FILEReadCharFunc, f, errorMessage);
+	ret = md380_ReadColumnsMapping (DESC_ChannelInformation, FIELDS_ChannelInformation, fieldsMap, &numberOfColumns, separator, readCharFunc, readCharFuncParameter, errorMessage);
 	if (ret != CSVRET_OK) goto exitFunc;
 	
 	/* Read the records */
@@ -85,61 +149,22 @@ int loadCSVFile_ChannelInformation (const char* fileName, TRDTFile* container, c
 		/* Read fields within records */
 		for (j=0; ; j++) {
 			if (j >= numberOfColumns) {
-				(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
+				(*errorMessage) = (char*)binAlloc (strlen (streamName)+146);
 				if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", fileName, i+2);
+				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", streamName, i+2);
 				ret = MD380ERR_INVALID_CSV_FORMAT;
 				goto exitFunc;
 			}
 			
-			switch (fieldsMap[j]) {
-				case 0: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+0, &(record.LoneWorker), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 1: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+1, &(record.Squelch), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 2: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+2, &(record.Autoscan), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 3: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+3, &(record.Bandwidth), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 4: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+4, &(record.ChannelMode), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 5: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+5, &(record.Colorcode), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 6: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+6, &(record.RepeaterSlot), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 7: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+7, &(record.RxOnly), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 8: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+8, &(record.AllowTalkaround), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 9: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+9, &(record.DataCallConf), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 10: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+10, &(record.PrivateCallConf), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 11: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+11, &(record.Privacy), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 12: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+12, &(record.PrivacyNo), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 13: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+13, &(record.DisplayPttId), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 14: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+14, &(record.CompressedUdpHdr), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 15: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+15, &(record.EmergencyAlarmAck), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 16: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+16, &(record.RxRefFrequency), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 17: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+17, &(record.AdmintCriteria), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 18: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+18, &(record.Power), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 19: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+19, &(record.Vox), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 20: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+20, &(record.QtReverse), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 21: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+21, &(record.ReverseBurst), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 22: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+22, &(record.TxRefFrequency), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 23: ret = md380_ReadFieldReferenceNumeric (DESC_ChannelInformation+23, &(record.ContactName), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 24: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+24, &(record.Tot), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 25: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+25, &(record.TotRekeyDelay), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 26: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+26, &(record.EmergencySystem), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 27: ret = md380_ReadFieldReferenceUnicode (DESC_ChannelInformation+27, &(record.ScanList), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 28: ret = md380_ReadFieldReferenceUnicode (DESC_ChannelInformation+28, &(record.GroupList), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 29: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+29, &(record.Decode18), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 30: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+30, &(record.RxFrequency), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 31: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+31, &(record.TxFrequency), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 32: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+32, &(record.CtcssDcsDecode), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 33: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+33, &(record.CtcssDcsEncode), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 34: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+34, &(record.TxSignalingSyst), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 35: ret = md380_ReadFieldNumeric (DESC_ChannelInformation+35, &(record.RxSignalingSyst), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 36: ret = md380_ReadFieldUnicode (DESC_ChannelInformation+36, record.Name, 16, fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				default: assert (0);
-			}
+			ret = loadCSVField_ChannelInformation (fieldsMap[j], &record, streamName, i+2, separator, readCharFunc, readCharFuncParameter, errorMessage);
 			if (ret == CSVRET_EOL || ret == CSVRET_EOF || ret == MD380ERR_EMPTY_EOF) break;
 			if (ret != CSVRET_OK) goto exitFunc;
 		}
 		if (j == 0 && ret == MD380ERR_EMPTY_EOF) break;
 		if (j+1 < numberOfColumns) {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+146);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", fileName, i+2);
+			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", streamName, i+2);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -153,9 +178,9 @@ int loadCSVFile_ChannelInformation (const char* fileName, TRDTFile* container, c
 			container->ChannelInformation_COUNT = i+1;
 		}
 		else {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+146);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", fileName, i+2, COUNT_ChannelInformation);
+			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", streamName, i+2, COUNT_ChannelInformation);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -166,80 +191,136 @@ int loadCSVFile_ChannelInformation (const char* fileName, TRDTFile* container, c
 	ret = CSVRET_OK;
 	
 	exitFunc:
-	if (f) fclose (f);
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_READ, TABLE_ChannelInformation, container->ChannelInformation_COUNT);
 	return ret;
 }
 
-/* Function that opens a file and saves all the records of 'DigitalContact'. */
+/* Function that opens a file and reads all the records of 'ChannelInformation'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
-int saveCSVFile_DigitalContact (const char* fileName, const TRDTFile* container, char separator, char** errorMessage)
+int loadCSVFile_ChannelInformation (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
 {
-	int ret = CSVRET_OK;
+	int ret;
 	FILE* f = NULL;
-	unsigned i;
 	
-	assert (errorMessage != NULL);
-	assert ((*errorMessage) == NULL);
-	
-	f = fopen (fileName, "wb");
+	/* Open the file for reading */
+	f = fopen (fileName, "rb");
 	if (f == NULL) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+142);
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
 		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error opening '%s' for writing (%s)\n", fileName, strerror (errno));
+		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
 		ret = MD380ERR_FILE_ERROR;
 		goto exitFunc;
 	}
+	
+	ret = loadCSVStream_ChannelInformation (fileName, container, separator, md380_FILEReadCharFunc, f, errorMessage);
+	
+	exitFunc:
+	if (f) fclose (f);
+	return ret;
+}
 
-	ret = encodeCSVHeader_DigitalContact (separator, md380_FILEWriteBinaryFunc, f);
+/* Function that saves all the records of 'DigitalContact' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int saveCSVStream_DigitalContact (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	MD380_StatsTimer timer;
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	MD380_STATS_START (&timer);
+	ret = encodeCSVHeader_DigitalContact (separator, writeBinaryFunc, writeBinaryFuncParameter);
 	if (ret != CSVRET_OK) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+142);
+		(*errorMessage) = (char*)binAlloc (strlen (streamName)+142);
 		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", fileName, md380_CsvRetToString (ret));
+		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", streamName, md380_CsvRetToString (ret));
 		goto exitFunc;
 	}
 
 	for (i=0; i<container->DigitalContact_COUNT; i++) {
-		ret = encodeCSVRecord_DigitalContact (i, separator, md380_FILEWriteBinaryFunc, f, container->DigitalContact+i, errorMessage);
+		ret = encodeCSVRecord_DigitalContact (i, separator, writeBinaryFunc, writeBinaryFuncParameter, container->DigitalContact+i, errorMessage);
 		if (ret != CSVRET_OK) break;
 	}
 
 
+	exitFunc:
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_WRITE, TABLE_DigitalContact, container->DigitalContact_COUNT);
+	return ret;
+}
+
+/* Function that opens a file and saves all the records of 'DigitalContact'. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int saveCSVFile_DigitalContact (const char* fileName, const TRDTFile* container, char separator, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	FILE* f = NULL;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	f = fopen (fileName, "wb");
+	if (f == NULL) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+142);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "Error opening '%s' for writing (%s)\n", fileName, strerror (errno));
+		ret = MD380ERR_FILE_ERROR;
+		goto exitFunc;
+	}
+
+	ret = saveCSVStream_DigitalContact (fileName, container, separator, md380_FILEWriteBinaryFunc, f, errorMessage);
+	
 	exitFunc:
 	if (f) fclose (f);
 	return ret;
 }
 
-/* Function that opens a file and reads all the records of 'DigitalContact'. */
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'DigitalContact' record, where 'fieldNo' indexes DESC_DigitalContact. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+int loadCSVField_DigitalContact (unsigned fieldNo, T_DigitalContact* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	
+	switch (fieldNo) {
+		case 0: ret = md380_ReadFieldNumeric (DESC_DigitalContact+0, &(record->CallId), sizeof (record->CallId), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 1: ret = md380_ReadFieldNumeric (DESC_DigitalContact+1, &(record->CallReceiveTone), sizeof (record->CallReceiveTone), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 2: ret = md380_ReadFieldNumeric (DESC_DigitalContact+2, &(record->CallType), sizeof (record->CallType), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 3: ret = md380_ReadFieldUnicode (DESC_DigitalContact+3, record->Name, 16, fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		default: assert (0);
+	}
+	return ret;
+}
+
+/* Function that reads all the records of 'DigitalContact' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
-int loadCSVFile_DigitalContact (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
+int loadCSVStream_DigitalContact (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
 {
 	int ret;
 	unsigned i, j, numberOfColumns;
 	unsigned fieldsMap[FIELDS_DigitalContact];
-	FILE* f = NULL;
 	T_DigitalContact record;
+	MD380_StatsTimer timer;
 	
+	MD380_STATS_START (&timer);
 
 	/* Clear the container */
 	container->DigitalContact_COUNT = 0;
 
 	
-	/* Open the file for reading */
-	f = fopen (fileName, "rb");
-	if (f == NULL) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+142);
-		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
-		ret = MD380ERR_FILE_ERROR;
-		goto exitFunc;
-	}
-	
 	/* Read the titles */
-	ret = md380_ReadColumnsMapping (DESC_DigitalContact, FIELDS_DigitalContact, fieldsMap, &numberOfColumns, separator, md380_FILEReadCharFunc, f, errorMessage);
+	ret = md380_ReadColumnsMapping (DESC_DigitalContact, FIELDS_DigitalContact, fieldsMap, &numberOfColumns, separator, readCharFunc, readCharFuncParameter, errorMessage);
 	if (ret != CSVRET_OK) goto exitFunc;
 	
 	/* Read the records */
@@ -250,28 +331,22 @@ int loadCSVFile_DigitalContact (const char* fileName, TRDTFile* container, char
 		/* Read fields within records */
 		for (j=0; ; j++) {
 			if (j >= numberOfColumns) {
-				(*errorMessage) = (char*)binAlloc (strlen (fileName)+142);
+				(*errorMessage) = (char*)binAlloc (strlen (streamName)+142);
 				if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", fileName, i+2);
+				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", streamName, i+2);
 				ret = MD380ERR_INVALID_CSV_FORMAT;
 				goto exitFunc;
 			}
 			
-			switch (fieldsMap[j]) {
-				case 0: ret = md380_ReadFieldNumeric (DESC_DigitalContact+0, &(record.CallId), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 1: ret = md380_ReadFieldNumeric (DESC_DigitalContact+1, &(record.CallReceiveTone), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 2: ret = md380_ReadFieldNumeric (DESC_DigitalContact+2, &(record.CallType), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 3: ret = md380_ReadFieldUnicode (DESC_DigitalContact+3, record.Name, 16, fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				default: assert (0);
-			}
+			ret = loadCSVField_DigitalContact (fieldsMap[j], &record, streamName, i+2, separator, readCharFunc, readCharFuncParameter, errorMessage);
 			if (ret == CSVRET_EOL || ret == CSVRET_EOF || ret == MD380ERR_EMPTY_EOF) break;
 			if (ret != CSVRET_OK) goto exitFunc;
 		}
 		if (j == 0 && ret == MD380ERR_EMPTY_EOF) break;
 		if (j+1 < numberOfColumns) {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+142);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+142);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", fileName, i+2);
+			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", streamName, i+2);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -285,9 +360,9 @@ int loadCSVFile_DigitalContact (const char* fileName, TRDTFile* container, char
 			container->DigitalContact_COUNT = i+1;
 		}
 		else {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+142);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+142);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", fileName, i+2, COUNT_DigitalContact);
+			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", streamName, i+2, COUNT_DigitalContact);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -298,80 +373,165 @@ int loadCSVFile_DigitalContact (const char* fileName, TRDTFile* container, char
 	ret = CSVRET_OK;
 	
 	exitFunc:
-	if (f) fclose (f);
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_READ, TABLE_DigitalContact, container->DigitalContact_COUNT);
 	return ret;
 }
 
-/* Function that opens a file and saves all the records of 'DigitalRxGroupList'. */
+/* Function that opens a file and reads all the records of 'DigitalContact'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
-int saveCSVFile_DigitalRxGroupList (const char* fileName, const TRDTFile* container, char separator, char** errorMessage)
+int loadCSVFile_DigitalContact (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
 {
-	int ret = CSVRET_OK;
+	int ret;
 	FILE* f = NULL;
-	unsigned i;
 	
-	assert (errorMessage != NULL);
-	assert ((*errorMessage) == NULL);
-	
-	f = fopen (fileName, "wb");
+	/* Open the file for reading */
+	f = fopen (fileName, "rb");
 	if (f == NULL) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+142);
 		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error opening '%s' for writing (%s)\n", fileName, strerror (errno));
+		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
 		ret = MD380ERR_FILE_ERROR;
 		goto exitFunc;
 	}
+	
+	ret = loadCSVStream_DigitalContact (fileName, container, separator, md380_FILEReadCharFunc, f, errorMessage);
+	
+	exitFunc:
+	if (f) fclose (f);
+	return ret;
+}
 
-	ret = encodeCSVHeader_DigitalRxGroupList (separator, md380_FILEWriteBinaryFunc, f);
+/* Function that saves all the records of 'DigitalRxGroupList' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int saveCSVStream_DigitalRxGroupList (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	MD380_StatsTimer timer;
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	MD380_STATS_START (&timer);
+	ret = encodeCSVHeader_DigitalRxGroupList (separator, writeBinaryFunc, writeBinaryFuncParameter);
 	if (ret != CSVRET_OK) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
+		(*errorMessage) = (char*)binAlloc (strlen (streamName)+146);
 		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", fileName, md380_CsvRetToString (ret));
+		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", streamName, md380_CsvRetToString (ret));
 		goto exitFunc;
 	}
 
 	for (i=0; i<container->DigitalRxGroupList_COUNT; i++) {
-		ret = encodeCSVRecord_DigitalRxGroupList (i, separator, md380_FILEWriteBinaryFunc, f, container->DigitalRxGroupList+i, errorMessage);
+		ret = encodeCSVRecord_DigitalRxGroupList (i, separator, writeBinaryFunc, writeBinaryFuncParameter, container->DigitalRxGroupList+i, errorMessage);
 		if (ret != CSVRET_OK) break;
 	}
 
 
+	exitFunc:
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_WRITE, TABLE_DigitalRxGroupList, container->DigitalRxGroupList_COUNT);
+	return ret;
+}
+
+/* Function that opens a file and saves all the records of 'DigitalRxGroupList'. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int saveCSVFile_DigitalRxGroupList (const char* fileName, const TRDTFile* container, char separator, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	FILE* f = NULL;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	f = fopen (fileName, "wb");
+	if (f == NULL) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "Error opening '%s' for writing (%s)\n", fileName, strerror (errno));
+		ret = MD380ERR_FILE_ERROR;
+		goto exitFunc;
+	}
+
+	ret = saveCSVStream_DigitalRxGroupList (fileName, container, separator, md380_FILEWriteBinaryFunc, f, errorMessage);
+	
 	exitFunc:
 	if (f) fclose (f);
 	return ret;
 }
 
-/* Function that opens a file and reads all the records of 'DigitalRxGroupList'. */
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'DigitalRxGroupList' record, where 'fieldNo' indexes DESC_DigitalRxGroupList. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+int loadCSVField_DigitalRxGroupList (unsigned fieldNo, T_DigitalRxGroupList* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	
+	switch (fieldNo) {
+		case 0: ret = md380_ReadFieldUnicode (DESC_DigitalRxGroupList+0, record->Name, 16, fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 1: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+1, &(record->ContactMember[0]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 2: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+2, &(record->ContactMember[1]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 3: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+3, &(record->ContactMember[2]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 4: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+4, &(record->ContactMember[3]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 5: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+5, &(record->ContactMember[4]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 6: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+6, &(record->ContactMember[5]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 7: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+7, &(record->ContactMember[6]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 8: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+8, &(record->ContactMember[7]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 9: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+9, &(record->ContactMember[8]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 10: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+10, &(record->ContactMember[9]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 11: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+11, &(record->ContactMember[10]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 12: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+12, &(record->ContactMember[11]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 13: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+13, &(record->ContactMember[12]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 14: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+14, &(record->ContactMember[13]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 15: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+15, &(record->ContactMember[14]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 16: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+16, &(record->ContactMember[15]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 17: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+17, &(record->ContactMember[16]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 18: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+18, &(record->ContactMember[17]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 19: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+19, &(record->ContactMember[18]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 20: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+20, &(record->ContactMember[19]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 21: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+21, &(record->ContactMember[20]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 22: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+22, &(record->ContactMember[21]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 23: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+23, &(record->ContactMember[22]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 24: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+24, &(record->ContactMember[23]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 25: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+25, &(record->ContactMember[24]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 26: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+26, &(record->ContactMember[25]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 27: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+27, &(record->ContactMember[26]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 28: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+28, &(record->ContactMember[27]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 29: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+29, &(record->ContactMember[28]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 30: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+30, &(record->ContactMember[29]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 31: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+31, &(record->ContactMember[30]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 32: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+32, &(record->ContactMember[31]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		default: assert (0);
+	}
+	return ret;
+}
+
+/* Function that reads all the records of 'DigitalRxGroupList' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
-int loadCSVFile_DigitalRxGroupList (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
+int loadCSVStream_DigitalRxGroupList (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
 {
 	int ret;
 	unsigned i, j, numberOfColumns;
 	unsigned fieldsMap[FIELDS_DigitalRxGroupList];
-	FILE* f = NULL;
 	T_DigitalRxGroupList record;
+	MD380_StatsTimer timer;
 	
+	MD380_STATS_START (&timer);
 
 	/* Clear the container */
 	container->DigitalRxGroupList_COUNT = 0;
 
 	
-	/* Open the file for reading */
-	f = fopen (fileName, "rb");
-	if (f == NULL) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
-		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
-		ret = MD380ERR_FILE_ERROR;
-		goto exitFunc;
-	}
-	
 	/* Read the titles */
-	ret = md380_ReadColumnsMapping (DESC_DigitalRxGroupList, FIELDS_DigitalRxGroupList, fieldsMap, &numberOfColumns, separator, md380_FILEReadCharFunc, f, errorMessage);
+	ret = md380_ReadColumnsMapping (DESC_DigitalRxGroupList, FIELDS_DigitalRxGroupList, fieldsMap, &numberOfColumns, separator, readCharFunc, readCharFuncParameter, errorMessage);
 	if (ret != CSVRET_OK) goto exitFunc;
 	
 	/* Read the records */
@@ -382,57 +542,22 @@ int loadCSVFile_DigitalRxGroupList (const char* fileName, TRDTFile* container, c
 		/* Read fields within records */
 		for (j=0; ; j++) {
 			if (j >= numberOfColumns) {
-				(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
+				(*errorMessage) = (char*)binAlloc (strlen (streamName)+146);
 				if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", fileName, i+2);
+				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", streamName, i+2);
 				ret = MD380ERR_INVALID_CSV_FORMAT;
 				goto exitFunc;
 			}
 			
-			switch (fieldsMap[j]) {
-				case 0: ret = md380_ReadFieldUnicode (DESC_DigitalRxGroupList+0, record.Name, 16, fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 1: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+1, &(record.ContactMember[0]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 2: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+2, &(record.ContactMember[1]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 3: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+3, &(record.ContactMember[2]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 4: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+4, &(record.ContactMember[3]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 5: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+5, &(record.ContactMember[4]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 6: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+6, &(record.ContactMember[5]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 7: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+7, &(record.ContactMember[6]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 8: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+8, &(record.ContactMember[7]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 9: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+9, &(record.ContactMember[8]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 10: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+10, &(record.ContactMember[9]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 11: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+11, &(record.ContactMember[10]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 12: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+12, &(record.ContactMember[11]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 13: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+13, &(record.ContactMember[12]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 14: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+14, &(record.ContactMember[13]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 15: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+15, &(record.ContactMember[14]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 16: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+16, &(record.ContactMember[15]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 17: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+17, &(record.ContactMember[16]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 18: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+18, &(record.ContactMember[17]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 19: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+19, &(record.ContactMember[18]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 20: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+20, &(record.ContactMember[19]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 21: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+21, &(record.ContactMember[20]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 22: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+22, &(record.ContactMember[21]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 23: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+23, &(record.ContactMember[22]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 24: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+24, &(record.ContactMember[23]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 25: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+25, &(record.ContactMember[24]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 26: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+26, &(record.ContactMember[25]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 27: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+27, &(record.ContactMember[26]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 28: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+28, &(record.ContactMember[27]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 29: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+29, &(record.ContactMember[28]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 30: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+30, &(record.ContactMember[29]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 31: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+31, &(record.ContactMember[30]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 32: ret = md380_ReadFieldReferenceNumeric (DESC_DigitalRxGroupList+32, &(record.ContactMember[31]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				default: assert (0);
-			}
+			ret = loadCSVField_DigitalRxGroupList (fieldsMap[j], &record, streamName, i+2, separator, readCharFunc, readCharFuncParameter, errorMessage);
 			if (ret == CSVRET_EOL || ret == CSVRET_EOF || ret == MD380ERR_EMPTY_EOF) break;
 			if (ret != CSVRET_OK) goto exitFunc;
 		}
 		if (j == 0 && ret == MD380ERR_EMPTY_EOF) break;
 		if (j+1 < numberOfColumns) {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+146);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", fileName, i+2);
+			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", streamName, i+2);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -446,9 +571,9 @@ int loadCSVFile_DigitalRxGroupList (const char* fileName, TRDTFile* container, c
 			container->DigitalRxGroupList_COUNT = i+1;
 		}
 		else {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+146);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", fileName, i+2, COUNT_DigitalRxGroupList);
+			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", streamName, i+2, COUNT_DigitalRxGroupList);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -458,11 +583,67 @@ int loadCSVFile_DigitalRxGroupList (const char* fileName, TRDTFile* container, c
 	}
 	ret = CSVRET_OK;
 	
+	exitFunc:
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_READ, TABLE_DigitalRxGroupList, container->DigitalRxGroupList_COUNT);
+	return ret;
+}
+
+/* Function that opens a file and reads all the records of 'DigitalRxGroupList'. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int loadCSVFile_DigitalRxGroupList (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
+{
+	int ret;
+	FILE* f = NULL;
+	
+	/* Open the file for reading */
+	f = fopen (fileName, "rb");
+	if (f == NULL) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+146);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
+		ret = MD380ERR_FILE_ERROR;
+		goto exitFunc;
+	}
+	
+	ret = loadCSVStream_DigitalRxGroupList (fileName, container, separator, md380_FILEReadCharFunc, f, errorMessage);
+	
 	exitFunc:
 	if (f) fclose (f);
 	return ret;
 }
 
+/* Function that saves all the records of 'GeneralSettings' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int saveCSVStream_GeneralSettings (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	MD380_StatsTimer timer;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	MD380_STATS_START (&timer);
+	ret = encodeCSVHeader_GeneralSettings (separator, writeBinaryFunc, writeBinaryFuncParameter);
+	if (ret != CSVRET_OK) {
+		(*errorMessage) = (char*)binAlloc (strlen (streamName)+143);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", streamName, md380_CsvRetToString (ret));
+		goto exitFunc;
+	}
+
+	ret = encodeCSVRecord_GeneralSettings (0, separator, writeBinaryFunc, writeBinaryFuncParameter, &container->GeneralSettings, errorMessage);
+
+
+	exitFunc:
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_WRITE, TABLE_GeneralSettings, 1);
+	return ret;
+}
+
 /* Function that opens a file and saves all the records of 'GeneralSettings'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
@@ -484,48 +665,73 @@ int saveCSVFile_GeneralSettings (const char* fileName, const TRDTFile* container
 		goto exitFunc;
 	}
 
-	ret = encodeCSVHeader_GeneralSettings (separator, md380_FILEWriteBinaryFunc, f);
-	if (ret != CSVRET_OK) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
-		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", fileName, md380_CsvRetToString (ret));
-		goto exitFunc;
-	}
-
-	ret = encodeCSVRecord_GeneralSettings (0, separator, md380_FILEWriteBinaryFunc, f, &container->GeneralSettings, errorMessage);
-
-
+	ret = saveCSVStream_GeneralSettings (fileName, container, separator, md380_FILEWriteBinaryFunc, f, errorMessage);
+	
 	exitFunc:
 	if (f) fclose (f);
 	return ret;
 }
 
-/* Function that opens a file and reads all the records of 'GeneralSettings'. */
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'GeneralSettings' record, where 'fieldNo' indexes DESC_GeneralSettings. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+int loadCSVField_GeneralSettings (unsigned fieldNo, T_GeneralSettings* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	
+	switch (fieldNo) {
+		case 0: ret = md380_ReadFieldUnicode (DESC_GeneralSettings+0, record->InfoScreenLine1, 10, fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 1: ret = md380_ReadFieldUnicode (DESC_GeneralSettings+1, record->InfoScreenLine2, 10, fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 2: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+2, &(record->MonitorType), sizeof (record->MonitorType), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 3: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+3, &(record->DisableAllLeds), sizeof (record->DisableAllLeds), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 4: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+4, &(record->TalkPermitTone), sizeof (record->TalkPermitTone), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 5: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+5, &(record->PasswordAndLockEnable), sizeof (record->PasswordAndLockEnable), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 6: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+6, &(record->CHFreeIndicationTone), sizeof (record->CHFreeIndicationTone), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 7: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+7, &(record->DisableAllTone), sizeof (record->DisableAllTone), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 8: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+8, &(record->SaveModeReceive), sizeof (record->SaveModeReceive), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 9: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+9, &(record->SavePreamble), sizeof (record->SavePreamble), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 10: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+10, &(record->IntroScreen), sizeof (record->IntroScreen), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 11: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+11, &(record->RadioId), sizeof (record->RadioId), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 12: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+12, &(record->TxPreamble), sizeof (record->TxPreamble), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 13: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+13, &(record->GroupCallHangTime), sizeof (record->GroupCallHangTime), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 14: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+14, &(record->PrivateCallHangTime), sizeof (record->PrivateCallHangTime), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 15: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+15, &(record->VoxSensitivity), sizeof (record->VoxSensitivity), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 16: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+16, &(record->RxLowBatteryInterval), sizeof (record->RxLowBatteryInterval), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 17: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+17, &(record->CallAlertTone), sizeof (record->CallAlertTone), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 18: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+18, &(record->LoneWorkerRespTime), sizeof (record->LoneWorkerRespTime), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 19: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+19, &(record->LoneWorkerReminderTime), sizeof (record->LoneWorkerReminderTime), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 20: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+20, &(record->ScanDigitalHangTime), sizeof (record->ScanDigitalHangTime), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 21: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+21, &(record->ScanAnalogHangTime), sizeof (record->ScanAnalogHangTime), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 22: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+22, &(record->Unknown1), sizeof (record->Unknown1), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 23: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+23, &(record->KeypadLockTime), sizeof (record->KeypadLockTime), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 24: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+24, &(record->Mode), sizeof (record->Mode), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 25: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+25, &(record->PowerOnPassword), sizeof (record->PowerOnPassword), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 26: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+26, &(record->RadioProgPassowrd), sizeof (record->RadioProgPassowrd), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 27: ret = md380_ReadFieldUnicode (DESC_GeneralSettings+27, record->PcProgPassword, 8, fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 28: ret = md380_ReadFieldUnicode (DESC_GeneralSettings+28, record->RadioName, 16, fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		default: assert (0);
+	}
+	return ret;
+}
+
+/* Function that reads all the records of 'GeneralSettings' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
-int loadCSVFile_GeneralSettings (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
+int loadCSVStream_GeneralSettings (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
 {
 	int ret;
 	unsigned i, j, numberOfColumns;
 	unsigned fieldsMap[FIELDS_GeneralSettings];
-	FILE* f = NULL;
 	T_GeneralSettings record;
+	MD380_StatsTimer timer;
 	
+	MD380_STATS_START (&timer);
 
 	
-	/* Open the file for reading */
-	f = fopen (fileName, "rb");
-	if (f == NULL) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
-		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
-		ret = MD380ERR_FILE_ERROR;
-		goto exitFunc;
-	}
-	
 	/* Read the titles */
-	ret = md380_ReadColumnsMapping (DESC_GeneralSettings, FIELDS_GeneralSettings, fieldsMap, &numberOfColumns, separator, md380_FILEReadCharFunc, f, errorMessage);
+	ret = md380_ReadColumnsMapping (DESC_GeneralSettings, FIELDS_GeneralSettings, fieldsMap, &numberOfColumns, separator, readCharFunc, readCharFuncParameter, errorMessage);
 	if (ret != CSVRET_OK) goto exitFunc;
 	
 	/* Read the records */
@@ -536,53 +742,22 @@ int loadCSVFile_GeneralSettings (const char* fileName, TRDTFile* container, char
 		/* Read fields within records */
 		for (j=0; ; j++) {
 			if (j >= numberOfColumns) {
-				(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
+				(*errorMessage) = (char*)binAlloc (strlen (streamName)+143);
 				if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", fileName, i+2);
+				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", streamName, i+2);
 				ret = MD380ERR_INVALID_CSV_FORMAT;
 				goto exitFunc;
 			}
 			
-			switch (fieldsMap[j]) {
-				case 0: ret = md380_ReadFieldUnicode (DESC_GeneralSettings+0, record.InfoScreenLine1, 10, fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 1: ret = md380_ReadFieldUnicode (DESC_GeneralSettings+1, record.InfoScreenLine2, 10, fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 2: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+2, &(record.MonitorType), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 3: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+3, &(record.DisableAllLeds), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 4: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+4, &(record.TalkPermitTone), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 5: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+5, &(record.PasswordAndLockEnable), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 6: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+6, &(record.CHFreeIndicationTone), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 7: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+7, &(record.DisableAllTone), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 8: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+8, &(record.SaveModeReceive), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 9: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+9, &(record.SavePreamble), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 10: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+10, &(record.IntroScreen), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 11: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+11, &(record.RadioId), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 12: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+12, &(record.TxPreamble), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 13: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+13, &(record.GroupCallHangTime), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 14: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+14, &(record.PrivateCallHangTime), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 15: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+15, &(record.VoxSensitivity), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 16: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+16, &(record.RxLowBatteryInterval), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 17: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+17, &(record.CallAlertTone), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 18: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+18, &(record.LoneWorkerRespTime), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 19: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+19, &(record.LoneWorkerReminderTime), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 20: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+20, &(record.ScanDigitalHangTime), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 21: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+21, &(record.ScanAnalogHangTime), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 22: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+22, &(record.Unknown1), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 23: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+23, &(record.KeypadLockTime), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 24: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+24, &(record.Mode), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 25: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+25, &(record.PowerOnPassword), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 26: ret = md380_ReadFieldNumeric (DESC_GeneralSettings+26, &(record.RadioProgPassowrd), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 27: ret = md380_ReadFieldUnicode (DESC_GeneralSettings+27, record.PcProgPassword, 8, fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 28: ret = md380_ReadFieldUnicode (DESC_GeneralSettings+28, record.RadioName, 16, fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				default: assert (0);
-			}
+			ret = loadCSVField_GeneralSettings (fieldsMap[j], &record, streamName, i+2, separator, readCharFunc, readCharFuncParameter, errorMessage);
 			if (ret == CSVRET_EOL || ret == CSVRET_EOF || ret == MD380ERR_EMPTY_EOF) break;
 			if (ret != CSVRET_OK) goto exitFunc;
 		}
 		if (j == 0 && ret == MD380ERR_EMPTY_EOF) break;
 		if (j+1 < numberOfColumns) {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+143);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", fileName, i+2);
+			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", streamName, i+2);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -595,9 +770,9 @@ int loadCSVFile_GeneralSettings (const char* fileName, TRDTFile* container, char
 			memcpy (&container->GeneralSettings, &record, sizeof (record));
 		}
 		else {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+143);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", fileName, i+2, COUNT_GeneralSettings);
+			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", streamName, i+2, COUNT_GeneralSettings);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -605,13 +780,73 @@ int loadCSVFile_GeneralSettings (const char* fileName, TRDTFile* container, char
 		/* If the last field included an EOF, we are done */
 		if (ret == CSVRET_EOF) break;
 	}
-	ret = CSVRET_OK;
+	ret = CSVRET_OK;
+	
+	exitFunc:
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_READ, TABLE_GeneralSettings, (ret == CSVRET_OK));
+	return ret;
+}
+
+/* Function that opens a file and reads all the records of 'GeneralSettings'. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int loadCSVFile_GeneralSettings (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
+{
+	int ret;
+	FILE* f = NULL;
+	
+	/* Open the file for reading */
+	f = fopen (fileName, "rb");
+	if (f == NULL) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
+		ret = MD380ERR_FILE_ERROR;
+		goto exitFunc;
+	}
+	
+	ret = loadCSVStream_GeneralSettings (fileName, container, separator, md380_FILEReadCharFunc, f, errorMessage);
 	
 	exitFunc:
 	if (f) fclose (f);
 	return ret;
 }
 
+/* Function that saves all the records of 'ScanList' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int saveCSVStream_ScanList (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	MD380_StatsTimer timer;
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	MD380_STATS_START (&timer);
+	ret = encodeCSVHeader_ScanList (separator, writeBinaryFunc, writeBinaryFuncParameter);
+	if (ret != CSVRET_OK) {
+		(*errorMessage) = (char*)binAlloc (strlen (streamName)+136);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", streamName, md380_CsvRetToString (ret));
+		goto exitFunc;
+	}
+
+	for (i=0; i<container->ScanList_COUNT; i++) {
+		ret = encodeCSVRecord_ScanList (i, separator, writeBinaryFunc, writeBinaryFuncParameter, container->ScanList+i, errorMessage);
+		if (ret != CSVRET_OK) break;
+	}
+
+
+	exitFunc:
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_WRITE, TABLE_ScanList, container->ScanList_COUNT);
+	return ret;
+}
+
 /* Function that opens a file and saves all the records of 'ScanList'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
@@ -620,7 +855,6 @@ int saveCSVFile_ScanList (const char* fileName, const TRDTFile* container, char
 {
 	int ret = CSVRET_OK;
 	FILE* f = NULL;
-	unsigned i;
 	
 	assert (errorMessage != NULL);
 	assert ((*errorMessage) == NULL);
@@ -634,54 +868,84 @@ int saveCSVFile_ScanList (const char* fileName, const TRDTFile* container, char
 		goto exitFunc;
 	}
 
-	ret = encodeCSVHeader_ScanList (separator, md380_FILEWriteBinaryFunc, f);
-	if (ret != CSVRET_OK) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+136);
-		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", fileName, md380_CsvRetToString (ret));
-		goto exitFunc;
-	}
-
-	for (i=0; i<container->ScanList_COUNT; i++) {
-		ret = encodeCSVRecord_ScanList (i, separator, md380_FILEWriteBinaryFunc, f, container->ScanList+i, errorMessage);
-		if (ret != CSVRET_OK) break;
-	}
-
-
+	ret = saveCSVStream_ScanList (fileName, container, separator, md380_FILEWriteBinaryFunc, f, errorMessage);
+	
 	exitFunc:
 	if (f) fclose (f);
 	return ret;
 }
 
-/* Function that opens a file and reads all the records of 'ScanList'. */
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'ScanList' record, where 'fieldNo' indexes DESC_ScanList. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+int loadCSVField_ScanList (unsigned fieldNo, T_ScanList* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	
+	switch (fieldNo) {
+		case 0: ret = md380_ReadFieldUnicode (DESC_ScanList+0, record->Name, 16, fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 1: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+1, &(record->PriorityCh1), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 2: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+2, &(record->PriorityCh2), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 3: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+3, &(record->TXDesignatedCh), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 4: ret = md380_ReadFieldNumeric (DESC_ScanList+4, &(record->SignHoldTime), sizeof (record->SignHoldTime), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 5: ret = md380_ReadFieldNumeric (DESC_ScanList+5, &(record->PrioSamplTime), sizeof (record->PrioSamplTime), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 6: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+6, &(record->ChannelMember[0]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 7: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+7, &(record->ChannelMember[1]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 8: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+8, &(record->ChannelMember[2]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 9: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+9, &(record->ChannelMember[3]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 10: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+10, &(record->ChannelMember[4]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 11: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+11, &(record->ChannelMember[5]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 12: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+12, &(record->ChannelMember[6]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 13: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+13, &(record->ChannelMember[7]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 14: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+14, &(record->ChannelMember[8]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 15: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+15, &(record->ChannelMember[9]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 16: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+16, &(record->ChannelMember[10]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 17: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+17, &(record->ChannelMember[11]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 18: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+18, &(record->ChannelMember[12]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 19: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+19, &(record->ChannelMember[13]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 20: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+20, &(record->ChannelMember[14]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 21: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+21, &(record->ChannelMember[15]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 22: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+22, &(record->ChannelMember[16]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 23: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+23, &(record->ChannelMember[17]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 24: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+24, &(record->ChannelMember[18]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 25: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+25, &(record->ChannelMember[19]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 26: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+26, &(record->ChannelMember[20]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 27: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+27, &(record->ChannelMember[21]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 28: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+28, &(record->ChannelMember[22]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 29: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+29, &(record->ChannelMember[23]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 30: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+30, &(record->ChannelMember[24]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 31: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+31, &(record->ChannelMember[25]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 32: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+32, &(record->ChannelMember[26]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 33: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+33, &(record->ChannelMember[27]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 34: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+34, &(record->ChannelMember[28]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 35: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+35, &(record->ChannelMember[29]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 36: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+36, &(record->ChannelMember[30]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		default: assert (0);
+	}
+	return ret;
+}
+
+/* Function that reads all the records of 'ScanList' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
-int loadCSVFile_ScanList (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
+int loadCSVStream_ScanList (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
 {
 	int ret;
 	unsigned i, j, numberOfColumns;
 	unsigned fieldsMap[FIELDS_ScanList];
-	FILE* f = NULL;
 	T_ScanList record;
+	MD380_StatsTimer timer;
 	
+	MD380_STATS_START (&timer);
 
 	/* Clear the container */
 	container->ScanList_COUNT = 0;
 
 	
-	/* Open the file for reading */
-	f = fopen (fileName, "rb");
-	if (f == NULL) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+136);
-		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
-		ret = MD380ERR_FILE_ERROR;
-		goto exitFunc;
-	}
-	
 	/* Read the titles */
-	ret = md380_ReadColumnsMapping (DESC_ScanList, FIELDS_ScanList, fieldsMap, &numberOfColumns, separator, md380_FILEReadCharFunc, f, errorMessage);
+	ret = md380_ReadColumnsMapping (DESC_ScanList, FIELDS_ScanList, fieldsMap, &numberOfColumns, separator, readCharFunc, readCharFuncParameter, errorMessage);
 	if (ret != CSVRET_OK) goto exitFunc;
 	
 	/* Read the records */
@@ -692,61 +956,22 @@ int loadCSVFile_ScanList (const char* fileName, TRDTFile* container, char separa
 		/* Read fields within records */
 		for (j=0; ; j++) {
 			if (j >= numberOfColumns) {
-				(*errorMessage) = (char*)binAlloc (strlen (fileName)+136);
+				(*errorMessage) = (char*)binAlloc (strlen (streamName)+136);
 				if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", fileName, i+2);
+				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", streamName, i+2);
 				ret = MD380ERR_INVALID_CSV_FORMAT;
 				goto exitFunc;
 			}
 			
-			switch (fieldsMap[j]) {
-				case 0: ret = md380_ReadFieldUnicode (DESC_ScanList+0, record.Name, 16, fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 1: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+1, &(record.PriorityCh1), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 2: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+2, &(record.PriorityCh2), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 3: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+3, &(record.TXDesignatedCh), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 4: ret = md380_ReadFieldNumeric (DESC_ScanList+4, &(record.SignHoldTime), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 5: ret = md380_ReadFieldNumeric (DESC_ScanList+5, &(record.PrioSamplTime), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 6: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+6, &(record.ChannelMember[0]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 7: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+7, &(record.ChannelMember[1]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 8: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+8, &(record.ChannelMember[2]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 9: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+9, &(record.ChannelMember[3]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 10: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+10, &(record.ChannelMember[4]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 11: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+11, &(record.ChannelMember[5]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 12: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+12, &(record.ChannelMember[6]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 13: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+13, &(record.ChannelMember[7]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 14: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+14, &(record.ChannelMember[8]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 15: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+15, &(record.ChannelMember[9]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 16: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+16, &(record.ChannelMember[10]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 17: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+17, &(record.ChannelMember[11]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 18: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+18, &(record.ChannelMember[12]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 19: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+19, &(record.ChannelMember[13]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 20: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+20, &(record.ChannelMember[14]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 21: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+21, &(record.ChannelMember[15]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 22: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+22, &(record.ChannelMember[16]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 23: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+23, &(record.ChannelMember[17]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 24: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+24, &(record.ChannelMember[18]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 25: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+25, &(record.ChannelMember[19]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 26: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+26, &(record.ChannelMember[20]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 27: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+27, &(record.ChannelMember[21]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 28: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+28, &(record.ChannelMember[22]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 29: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+29, &(record.ChannelMember[23]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 30: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+30, &(record.ChannelMember[24]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 31: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+31, &(record.ChannelMember[25]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 32: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+32, &(record.ChannelMember[26]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 33: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+33, &(record.ChannelMember[27]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 34: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+34, &(record.ChannelMember[28]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 35: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+35, &(record.ChannelMember[29]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 36: ret = md380_ReadFieldReferenceUnicode (DESC_ScanList+36, &(record.ChannelMember[30]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				default: assert (0);
-			}
+			ret = loadCSVField_ScanList (fieldsMap[j], &record, streamName, i+2, separator, readCharFunc, readCharFuncParameter, errorMessage);
 			if (ret == CSVRET_EOL || ret == CSVRET_EOF || ret == MD380ERR_EMPTY_EOF) break;
 			if (ret != CSVRET_OK) goto exitFunc;
 		}
 		if (j == 0 && ret == MD380ERR_EMPTY_EOF) break;
 		if (j+1 < numberOfColumns) {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+136);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+136);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", fileName, i+2);
+			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", streamName, i+2);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -760,9 +985,9 @@ int loadCSVFile_ScanList (const char* fileName, TRDTFile* container, char separa
 			container->ScanList_COUNT = i+1;
 		}
 		else {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+136);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+136);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", fileName, i+2, COUNT_ScanList);
+			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", streamName, i+2, COUNT_ScanList);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -773,80 +998,133 @@ int loadCSVFile_ScanList (const char* fileName, TRDTFile* container, char separa
 	ret = CSVRET_OK;
 	
 	exitFunc:
-	if (f) fclose (f);
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_READ, TABLE_ScanList, container->ScanList_COUNT);
 	return ret;
 }
 
-/* Function that opens a file and saves all the records of 'TextMessage'. */
+/* Function that opens a file and reads all the records of 'ScanList'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
-int saveCSVFile_TextMessage (const char* fileName, const TRDTFile* container, char separator, char** errorMessage)
+int loadCSVFile_ScanList (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
 {
-	int ret = CSVRET_OK;
+	int ret;
 	FILE* f = NULL;
-	unsigned i;
-	
-	assert (errorMessage != NULL);
-	assert ((*errorMessage) == NULL);
 	
-	f = fopen (fileName, "wb");
+	/* Open the file for reading */
+	f = fopen (fileName, "rb");
 	if (f == NULL) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+139);
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+136);
 		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error opening '%s' for writing (%s)\n", fileName, strerror (errno));
+		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
 		ret = MD380ERR_FILE_ERROR;
 		goto exitFunc;
 	}
+	
+	ret = loadCSVStream_ScanList (fileName, container, separator, md380_FILEReadCharFunc, f, errorMessage);
+	
+	exitFunc:
+	if (f) fclose (f);
+	return ret;
+}
 
-	ret = encodeCSVHeader_TextMessage (separator, md380_FILEWriteBinaryFunc, f);
+/* Function that saves all the records of 'TextMessage' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int saveCSVStream_TextMessage (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	MD380_StatsTimer timer;
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	MD380_STATS_START (&timer);
+	ret = encodeCSVHeader_TextMessage (separator, writeBinaryFunc, writeBinaryFuncParameter);
 	if (ret != CSVRET_OK) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+139);
+		(*errorMessage) = (char*)binAlloc (strlen (streamName)+139);
 		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", fileName, md380_CsvRetToString (ret));
+		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", streamName, md380_CsvRetToString (ret));
 		goto exitFunc;
 	}
 
 	for (i=0; i<container->TextMessage_COUNT; i++) {
-		ret = encodeCSVRecord_TextMessage (i, separator, md380_FILEWriteBinaryFunc, f, container->TextMessage+i, errorMessage);
+		ret = encodeCSVRecord_TextMessage (i, separator, writeBinaryFunc, writeBinaryFuncParameter, container->TextMessage+i, errorMessage);
 		if (ret != CSVRET_OK) break;
 	}
 
 
+	exitFunc:
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_WRITE, TABLE_TextMessage, container->TextMessage_COUNT);
+	return ret;
+}
+
+/* Function that opens a file and saves all the records of 'TextMessage'. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int saveCSVFile_TextMessage (const char* fileName, const TRDTFile* container, char separator, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	FILE* f = NULL;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	f = fopen (fileName, "wb");
+	if (f == NULL) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+139);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "Error opening '%s' for writing (%s)\n", fileName, strerror (errno));
+		ret = MD380ERR_FILE_ERROR;
+		goto exitFunc;
+	}
+
+	ret = saveCSVStream_TextMessage (fileName, container, separator, md380_FILEWriteBinaryFunc, f, errorMessage);
+	
 	exitFunc:
 	if (f) fclose (f);
 	return ret;
 }
 
-/* Function that opens a file and reads all the records of 'TextMessage'. */
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'TextMessage' record, where 'fieldNo' indexes DESC_TextMessage. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+int loadCSVField_TextMessage (unsigned fieldNo, T_TextMessage* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	
+	switch (fieldNo) {
+		case 0: ret = md380_ReadFieldUnicode (DESC_TextMessage+0, record->Text, 144, fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		default: assert (0);
+	}
+	return ret;
+}
+
+/* Function that reads all the records of 'TextMessage' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
-int loadCSVFile_TextMessage (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
+int loadCSVStream_TextMessage (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
 {
 	int ret;
 	unsigned i, j, numberOfColumns;
 	unsigned fieldsMap[FIELDS_TextMessage];
-	FILE* f = NULL;
 	T_TextMessage record;
+	MD380_StatsTimer timer;
 	
+	MD380_STATS_START (&timer);
 
 	/* Clear the container */
 	container->TextMessage_COUNT = 0;
 
 	
-	/* Open the file for reading */
-	f = fopen (fileName, "rb");
-	if (f == NULL) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+139);
-		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
-		ret = MD380ERR_FILE_ERROR;
-		goto exitFunc;
-	}
-	
 	/* Read the titles */
-	ret = md380_ReadColumnsMapping (DESC_TextMessage, FIELDS_TextMessage, fieldsMap, &numberOfColumns, separator, md380_FILEReadCharFunc, f, errorMessage);
+	ret = md380_ReadColumnsMapping (DESC_TextMessage, FIELDS_TextMessage, fieldsMap, &numberOfColumns, separator, readCharFunc, readCharFuncParameter, errorMessage);
 	if (ret != CSVRET_OK) goto exitFunc;
 	
 	/* Read the records */
@@ -857,25 +1135,22 @@ int loadCSVFile_TextMessage (const char* fileName, TRDTFile* container, char sep
 		/* Read fields within records */
 		for (j=0; ; j++) {
 			if (j >= numberOfColumns) {
-				(*errorMessage) = (char*)binAlloc (strlen (fileName)+139);
+				(*errorMessage) = (char*)binAlloc (strlen (streamName)+139);
 				if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", fileName, i+2);
+				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", streamName, i+2);
 				ret = MD380ERR_INVALID_CSV_FORMAT;
 				goto exitFunc;
 			}
 			
-			switch (fieldsMap[j]) {
-				case 0: ret = md380_ReadFieldUnicode (DESC_TextMessage+0, record.Text, 144, fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				default: assert (0);
-			}
+			ret = loadCSVField_TextMessage (fieldsMap[j], &record, streamName, i+2, separator, readCharFunc, readCharFuncParameter, errorMessage);
 			if (ret == CSVRET_EOL || ret == CSVRET_EOF || ret == MD380ERR_EMPTY_EOF) break;
 			if (ret != CSVRET_OK) goto exitFunc;
 		}
 		if (j == 0 && ret == MD380ERR_EMPTY_EOF) break;
 		if (j+1 < numberOfColumns) {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+139);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+139);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", fileName, i+2);
+			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", streamName, i+2);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -889,9 +1164,9 @@ int loadCSVFile_TextMessage (const char* fileName, TRDTFile* container, char sep
 			container->TextMessage_COUNT = i+1;
 		}
 		else {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+139);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+139);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", fileName, i+2, COUNT_TextMessage);
+			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", streamName, i+2, COUNT_TextMessage);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -902,80 +1177,149 @@ int loadCSVFile_TextMessage (const char* fileName, TRDTFile* container, char sep
 	ret = CSVRET_OK;
 	
 	exitFunc:
-	if (f) fclose (f);
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_READ, TABLE_TextMessage, container->TextMessage_COUNT);
 	return ret;
 }
 
-/* Function that opens a file and saves all the records of 'ZoneInformation'. */
+/* Function that opens a file and reads all the records of 'TextMessage'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
-int saveCSVFile_ZoneInformation (const char* fileName, const TRDTFile* container, char separator, char** errorMessage)
+int loadCSVFile_TextMessage (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
 {
-	int ret = CSVRET_OK;
+	int ret;
 	FILE* f = NULL;
-	unsigned i;
-	
-	assert (errorMessage != NULL);
-	assert ((*errorMessage) == NULL);
 	
-	f = fopen (fileName, "wb");
+	/* Open the file for reading */
+	f = fopen (fileName, "rb");
 	if (f == NULL) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+139);
 		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error opening '%s' for writing (%s)\n", fileName, strerror (errno));
+		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
 		ret = MD380ERR_FILE_ERROR;
 		goto exitFunc;
 	}
+	
+	ret = loadCSVStream_TextMessage (fileName, container, separator, md380_FILEReadCharFunc, f, errorMessage);
+	
+	exitFunc:
+	if (f) fclose (f);
+	return ret;
+}
 
-	ret = encodeCSVHeader_ZoneInformation (separator, md380_FILEWriteBinaryFunc, f);
+/* Function that saves all the records of 'ZoneInformation' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int saveCSVStream_ZoneInformation (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	MD380_StatsTimer timer;
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	MD380_STATS_START (&timer);
+	ret = encodeCSVHeader_ZoneInformation (separator, writeBinaryFunc, writeBinaryFuncParameter);
 	if (ret != CSVRET_OK) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
+		(*errorMessage) = (char*)binAlloc (strlen (streamName)+143);
 		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", fileName, md380_CsvRetToString (ret));
+		sprintf ((*errorMessage), "Error writing CSV header when saving %s (%s)\n", streamName, md380_CsvRetToString (ret));
 		goto exitFunc;
 	}
 
 	for (i=0; i<container->ZoneInformation_COUNT; i++) {
-		ret = encodeCSVRecord_ZoneInformation (i, separator, md380_FILEWriteBinaryFunc, f, container->ZoneInformation+i, errorMessage);
+		ret = encodeCSVRecord_ZoneInformation (i, separator, writeBinaryFunc, writeBinaryFuncParameter, container->ZoneInformation+i, errorMessage);
 		if (ret != CSVRET_OK) break;
 	}
 
 
+	exitFunc:
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_WRITE, TABLE_ZoneInformation, container->ZoneInformation_COUNT);
+	return ret;
+}
+
+/* Function that opens a file and saves all the records of 'ZoneInformation'. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int saveCSVFile_ZoneInformation (const char* fileName, const TRDTFile* container, char separator, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	FILE* f = NULL;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	f = fopen (fileName, "wb");
+	if (f == NULL) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "Error opening '%s' for writing (%s)\n", fileName, strerror (errno));
+		ret = MD380ERR_FILE_ERROR;
+		goto exitFunc;
+	}
+
+	ret = saveCSVStream_ZoneInformation (fileName, container, separator, md380_FILEWriteBinaryFunc, f, errorMessage);
+	
 	exitFunc:
 	if (f) fclose (f);
 	return ret;
 }
 
-/* Function that opens a file and reads all the records of 'ZoneInformation'. */
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'ZoneInformation' record, where 'fieldNo' indexes DESC_ZoneInformation. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+int loadCSVField_ZoneInformation (unsigned fieldNo, T_ZoneInformation* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
+{
+	int ret = CSVRET_OK;
+	
+	switch (fieldNo) {
+		case 0: ret = md380_ReadFieldUnicode (DESC_ZoneInformation+0, record->Name, 16, fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage); break;
+		case 1: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+1, &(record->ChannelMember[0]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 2: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+2, &(record->ChannelMember[1]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 3: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+3, &(record->ChannelMember[2]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 4: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+4, &(record->ChannelMember[3]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 5: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+5, &(record->ChannelMember[4]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 6: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+6, &(record->ChannelMember[5]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 7: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+7, &(record->ChannelMember[6]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 8: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+8, &(record->ChannelMember[7]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 9: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+9, &(record->ChannelMember[8]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 10: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+10, &(record->ChannelMember[9]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 11: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+11, &(record->ChannelMember[10]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 12: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+12, &(record->ChannelMember[11]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 13: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+13, &(record->ChannelMember[12]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 14: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+14, &(record->ChannelMember[13]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 15: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+15, &(record->ChannelMember[14]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		case 16: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+16, &(record->ChannelMember[15]), fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);; break;
+		default: assert (0);
+	}
+	return ret;
+}
+
+/* Function that reads all the records of 'ZoneInformation' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
-int loadCSVFile_ZoneInformation (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
+int loadCSVStream_ZoneInformation (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
 {
 	int ret;
 	unsigned i, j, numberOfColumns;
 	unsigned fieldsMap[FIELDS_ZoneInformation];
-	FILE* f = NULL;
 	T_ZoneInformation record;
+	MD380_StatsTimer timer;
 	
+	MD380_STATS_START (&timer);
 
 	/* Clear the container */
 	container->ZoneInformation_COUNT = 0;
 
 	
-	/* Open the file for reading */
-	f = fopen (fileName, "rb");
-	if (f == NULL) {
-		(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
-		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
-		ret = MD380ERR_FILE_ERROR;
-		goto exitFunc;
-	}
-	
 	/* Read the titles */
-	ret = md380_ReadColumnsMapping (DESC_ZoneInformation, FIELDS_ZoneInformation, fieldsMap, &numberOfColumns, separator, md380_FILEReadCharFunc, f, errorMessage);
+	ret = md380_ReadColumnsMapping (DESC_ZoneInformation, FIELDS_ZoneInformation, fieldsMap, &numberOfColumns, separator, readCharFunc, readCharFuncParameter, errorMessage);
 	if (ret != CSVRET_OK) goto exitFunc;
 	
 	/* Read the records */
@@ -986,41 +1330,22 @@ int loadCSVFile_ZoneInformation (const char* fileName, TRDTFile* container, char
 		/* Read fields within records */
 		for (j=0; ; j++) {
 			if (j >= numberOfColumns) {
-				(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
+				(*errorMessage) = (char*)binAlloc (strlen (streamName)+143);
 				if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", fileName, i+2);
+				sprintf ((*errorMessage), "In file '%s', line %d, too many columns\n", streamName, i+2);
 				ret = MD380ERR_INVALID_CSV_FORMAT;
 				goto exitFunc;
 			}
 			
-			switch (fieldsMap[j]) {
-				case 0: ret = md380_ReadFieldUnicode (DESC_ZoneInformation+0, record.Name, 16, fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage); break;
-				case 1: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+1, &(record.ChannelMember[0]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 2: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+2, &(record.ChannelMember[1]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 3: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+3, &(record.ChannelMember[2]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 4: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+4, &(record.ChannelMember[3]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 5: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+5, &(record.ChannelMember[4]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 6: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+6, &(record.ChannelMember[5]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 7: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+7, &(record.ChannelMember[6]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 8: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+8, &(record.ChannelMember[7]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 9: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+9, &(record.ChannelMember[8]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 10: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+10, &(record.ChannelMember[9]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 11: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+11, &(record.ChannelMember[10]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 12: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+12, &(record.ChannelMember[11]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 13: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+13, &(record.ChannelMember[12]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 14: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+14, &(record.ChannelMember[13]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 15: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+15, &(record.ChannelMember[14]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				case 16: ret = md380_ReadFieldReferenceUnicode (DESC_ZoneInformation+16, &(record.ChannelMember[15]), fileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);; break;
-				default: assert (0);
-			}
+			ret = loadCSVField_ZoneInformation (fieldsMap[j], &record, streamName, i+2, separator, readCharFunc, readCharFuncParameter, errorMessage);
 			if (ret == CSVRET_EOL || ret == CSVRET_EOF || ret == MD380ERR_EMPTY_EOF) break;
 			if (ret != CSVRET_OK) goto exitFunc;
 		}
 		if (j == 0 && ret == MD380ERR_EMPTY_EOF) break;
 		if (j+1 < numberOfColumns) {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+143);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", fileName, i+2);
+			sprintf ((*errorMessage), "In file '%s', line %d, missing columns\n", streamName, i+2);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -1034,9 +1359,9 @@ int loadCSVFile_ZoneInformation (const char* fileName, TRDTFile* container, char
 			container->ZoneInformation_COUNT = i+1;
 		}
 		else {
-			(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
+			(*errorMessage) = (char*)binAlloc (strlen (streamName)+143);
 			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
-			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", fileName, i+2, COUNT_ZoneInformation);
+			sprintf ((*errorMessage), "In file '%s', line %d, too many lines (MAX=%d)\n", streamName, i+2, COUNT_ZoneInformation);
 			ret = MD380ERR_INVALID_CSV_FORMAT;
 			goto exitFunc;
 		}
@@ -1046,6 +1371,32 @@ int loadCSVFile_ZoneInformation (const char* fileName, TRDTFile* container, char
 	}
 	ret = CSVRET_OK;
 	
+	exitFunc:
+	MD380_STATS_STOP_TABLE (&timer, MD380_PHASE_CSV_READ, TABLE_ZoneInformation, container->ZoneInformation_COUNT);
+	return ret;
+}
+
+/* Function that opens a file and reads all the records of 'ZoneInformation'. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+int loadCSVFile_ZoneInformation (const char* fileName, TRDTFile* container, char separator, char** errorMessage)
+{
+	int ret;
+	FILE* f = NULL;
+	
+	/* Open the file for reading */
+	f = fopen (fileName, "rb");
+	if (f == NULL) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+143);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)\n", fileName, strerror (errno));
+		ret = MD380ERR_FILE_ERROR;
+		goto exitFunc;
+	}
+	
+	ret = loadCSVStream_ZoneInformation (fileName, container, separator, md380_FILEReadCharFunc, f, errorMessage);
+	
 	exitFunc:
 	if (f) fclose (f);
 	return ret;
@@ -1177,3 +1528,14 @@ int loadCSVFileAll (const CSVFileNames* csvFileNames, TRDTFile* container, char
 	exitFunc:
 	return ret;
 }
+
+/* Stream functions of each record, in the same order of cliCommands */
+const CSVStreamFuncs csvStreamFuncs[NO_OF_CSV_STREAMS] = {
+	{"ChannelInformation", saveCSVStream_ChannelInformation, loadCSVStream_ChannelInformation},
+	{"DigitalContact", saveCSVStream_DigitalContact, loadCSVStream_DigitalContact},
+	{"DigitalRxGroupList", saveCSVStream_DigitalRxGroupList, loadCSVStream_DigitalRxGroupList},
+	{"GeneralSettings", saveCSVStream_GeneralSettings, loadCSVStream_GeneralSettings},
+	{"ScanList", saveCSVStream_ScanList, loadCSVStream_ScanList},
+	{"TextMessage", saveCSVStream_TextMessage, loadCSVStream_TextMessage},
+	{"ZoneInformation", saveCSVStream_ZoneInformation, loadCSVStream_ZoneInformation}
+};
@@ -7,84 +7,232 @@
 #include "md380_cli.h"
 #include "md380_csv.h"
 
+/* Pointers to the functions saving/loading the records of a table to/from a CSV stream */
+typedef int (*SaveCSVStreamFunc)(const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage);
+typedef int (*LoadCSVStreamFunc)(const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
+/* Stream functions of a table */
+typedef struct {
+	const char* recordName;
+	SaveCSVStreamFunc saveCSVStream;
+	LoadCSVStreamFunc loadCSVStream;
+} CSVStreamFuncs;
+
+/* Stream functions of each record, in the same order of cliCommands */
+#define NO_OF_CSV_STREAMS 7
+extern const CSVStreamFuncs csvStreamFuncs[NO_OF_CSV_STREAMS];
+
+/* Function that saves all the records of 'ChannelInformation' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int saveCSVStream_ChannelInformation (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage);
+
 /* Function that opens a file and saves all the records of 'ChannelInformation'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
 extern int saveCSVFile_ChannelInformation (const char* fileName, const TRDTFile* container, char separator, char** errorMessage);
 
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'ChannelInformation' record, where 'fieldNo' indexes DESC_ChannelInformation. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+extern int loadCSVField_ChannelInformation (unsigned fieldNo, T_ChannelInformation* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
+/* Function that reads all the records of 'ChannelInformation' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int loadCSVStream_ChannelInformation (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
 /* Function that opens a file and reads all the records of 'ChannelInformation'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
 extern int loadCSVFile_ChannelInformation (const char* fileName, TRDTFile* container, char separator, char** errorMessage);
 
+/* Function that saves all the records of 'DigitalContact' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int saveCSVStream_DigitalContact (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage);
+
 /* Function that opens a file and saves all the records of 'DigitalContact'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
 extern int saveCSVFile_DigitalContact (const char* fileName, const TRDTFile* container, char separator, char** errorMessage);
 
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'DigitalContact' record, where 'fieldNo' indexes DESC_DigitalContact. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+extern int loadCSVField_DigitalContact (unsigned fieldNo, T_DigitalContact* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
+/* Function that reads all the records of 'DigitalContact' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int loadCSVStream_DigitalContact (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
 /* Function that opens a file and reads all the records of 'DigitalContact'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
 extern int loadCSVFile_DigitalContact (const char* fileName, TRDTFile* container, char separator, char** errorMessage);
 
+/* Function that saves all the records of 'DigitalRxGroupList' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int saveCSVStream_DigitalRxGroupList (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage);
+
 /* Function that opens a file and saves all the records of 'DigitalRxGroupList'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
 extern int saveCSVFile_DigitalRxGroupList (const char* fileName, const TRDTFile* container, char separator, char** errorMessage);
 
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'DigitalRxGroupList' record, where 'fieldNo' indexes DESC_DigitalRxGroupList. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+extern int loadCSVField_DigitalRxGroupList (unsigned fieldNo, T_DigitalRxGroupList* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
+/* Function that reads all the records of 'DigitalRxGroupList' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int loadCSVStream_DigitalRxGroupList (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
 /* Function that opens a file and reads all the records of 'DigitalRxGroupList'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
 extern int loadCSVFile_DigitalRxGroupList (const char* fileName, TRDTFile* container, char separator, char** errorMessage);
 
+/* Function that saves all the records of 'GeneralSettings' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int saveCSVStream_GeneralSettings (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage);
+
 /* Function that opens a file and saves all the records of 'GeneralSettings'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
 extern int saveCSVFile_GeneralSettings (const char* fileName, const TRDTFile* container, char separator, char** errorMessage);
 
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'GeneralSettings' record, where 'fieldNo' indexes DESC_GeneralSettings. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+extern int loadCSVField_GeneralSettings (unsigned fieldNo, T_GeneralSettings* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
+/* Function that reads all the records of 'GeneralSettings' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int loadCSVStream_GeneralSettings (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
 /* Function that opens a file and reads all the records of 'GeneralSettings'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
 extern int loadCSVFile_GeneralSettings (const char* fileName, TRDTFile* container, char separator, char** errorMessage);
 
+/* Function that saves all the records of 'ScanList' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int saveCSVStream_ScanList (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage);
+
 /* Function that opens a file and saves all the records of 'ScanList'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
 extern int saveCSVFile_ScanList (const char* fileName, const TRDTFile* container, char separator, char** errorMessage);
 
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'ScanList' record, where 'fieldNo' indexes DESC_ScanList. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+extern int loadCSVField_ScanList (unsigned fieldNo, T_ScanList* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
+/* Function that reads all the records of 'ScanList' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int loadCSVStream_ScanList (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
 /* Function that opens a file and reads all the records of 'ScanList'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
 extern int loadCSVFile_ScanList (const char* fileName, TRDTFile* container, char separator, char** errorMessage);
 
+/* Function that saves all the records of 'TextMessage' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int saveCSVStream_TextMessage (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage);
+
 /* Function that opens a file and saves all the records of 'TextMessage'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
 extern int saveCSVFile_TextMessage (const char* fileName, const TRDTFile* container, char separator, char** errorMessage);
 
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'TextMessage' record, where 'fieldNo' indexes DESC_TextMessage. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+extern int loadCSVField_TextMessage (unsigned fieldNo, T_TextMessage* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
+/* Function that reads all the records of 'TextMessage' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int loadCSVStream_TextMessage (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
 /* Function that opens a file and reads all the records of 'TextMessage'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
 extern int loadCSVFile_TextMessage (const char* fileName, TRDTFile* container, char separator, char** errorMessage);
 
+/* Function that saves all the records of 'ZoneInformation' to a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int saveCSVStream_ZoneInformation (const char* streamName, const TRDTFile* container, char separator, WriteBinaryFunc writeBinaryFunc, void* writeBinaryFuncParameter, char** errorMessage);
+
 /* Function that opens a file and saves all the records of 'ZoneInformation'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
 /* and it is to be freed with binFree. */
 extern int saveCSVFile_ZoneInformation (const char* fileName, const TRDTFile* container, char separator, char** errorMessage);
 
+/* Function that reads from a CSV source the field number 'fieldNo' */
+/* of a 'ZoneInformation' record, where 'fieldNo' indexes DESC_ZoneInformation. */
+/* Returns one of the CSVRET_XXX and MD380ERR_XXX values. */
+extern int loadCSVField_ZoneInformation (unsigned fieldNo, T_ZoneInformation* record, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
+/* Function that reads all the records of 'ZoneInformation' from a CSV stream. */
+/* The 'streamName' is only used for error messages. */
+/* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
+/* describing the error, is allocated with binAlloc in case of error */
+/* and it is to be freed with binFree. */
+extern int loadCSVStream_ZoneInformation (const char* streamName, TRDTFile* container, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+
 /* Function that opens a file and reads all the records of 'ZoneInformation'. */
 /* Returns one of the CSVRET_XXX values. The 'errorMessage' string, */
 /* describing the error, is allocated with binAlloc in case of error */
@@ -0,0 +1,366 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_lib.h"
+#include "md380_valid.h"
+#include "md380_resolve.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+
+#define MEMBUFFER_MIN_SIZE 4096
+#define DIAGNOSTICS_MIN_SIZE 16
+
+/*=========================================================================
+	Memory buffer
+=========================================================================*/
+void INIT_MD380_MemBuffer (MD380_MemBuffer* buffer)
+{
+	memset (buffer, 0, sizeof (*buffer));
+}
+
+void FREE_MD380_MemBuffer (MD380_MemBuffer* buffer)
+{
+	if (buffer->data) binFree (buffer->data);
+	INIT_MD380_MemBuffer (buffer);
+}
+
+/*=========================================================================
+	Grows the buffer to hold at least 'size' octets
+=========================================================================*/
+int md380_ReserveMemBuffer (MD380_MemBuffer* buffer, unsigned size)
+{
+	unsigned newSize;
+	char* newData;
+	
+	if (size <= buffer->allocated) return 0;
+	newSize = (buffer->allocated ? buffer->allocated : MEMBUFFER_MIN_SIZE);
+	while (newSize < size) newSize *= 2;
+	newData = (char*)binAlloc (newSize);
+	if (newData == NULL) return 1;
+	if (buffer->data) {
+		memcpy (newData, buffer->data, buffer->length);
+		binFree (buffer->data);
+	}
+	buffer->data = newData;
+	buffer->allocated = newSize;
+	return 0;
+}
+
+/*=========================================================================
+	CSV Lib callback function compatibile with "WriteBinaryFunc"
+=========================================================================*/
+int md380_MemWriteBinaryFunc (void* param, const char* buffer, unsigned length)
+{
+	MD380_MemBuffer* b = (MD380_MemBuffer*)param;
+	
+	/* 'buffer' can be NULL when there is nothing to write */
+	if (length == 0) return 0;
+	if (md380_ReserveMemBuffer (b, b->length+length)) return 1;
+	memcpy (b->data+b->length, buffer, length);
+	b->length += length;
+	return 0;
+}
+
+/*=========================================================================
+	Memory reader
+=========================================================================*/
+void md380_OpenMemReader (MD380_MemReader* reader, const char* data, unsigned length)
+{
+	reader->data = data;
+	reader->length = length;
+	reader->position = 0;
+}
+
+/*=========================================================================
+	CSV Lib callback function compatibile with "ReadCharFunc"
+=========================================================================*/
+int md380_MemReadCharFunc (void* param)
+{
+	MD380_MemReader* r = (MD380_MemReader*)param;
+	if (r->position >= r->length) return csvEOF;
+	return (unsigned char)r->data[r->position++];
+}
+
+/*=========================================================================
+	Diagnostics
+=========================================================================*/
+void INIT_MD380_Diagnostics (MD380_Diagnostics* diagnostics)
+{
+	memset (diagnostics, 0, sizeof (*diagnostics));
+	INIT_MD380_Arena (&diagnostics->strings);
+}
+
+void FREE_MD380_Diagnostics (MD380_Diagnostics* diagnostics)
+{
+	FREE_MD380_Arena (&diagnostics->strings);
+	if (diagnostics->items) binFree (diagnostics->items);
+	INIT_MD380_Diagnostics (diagnostics);
+}
+
+/*=========================================================================
+	Removes the diagnostics, keeping the list allocated for reuse
+=========================================================================*/
+void md380_ResetDiagnostics (MD380_Diagnostics* diagnostics)
+{
+	md380_ResetArena (&diagnostics->strings);
+	diagnostics->noOfItems = 0;
+	diagnostics->outOfMemory = 0;
+}
+
+/*=========================================================================
+	Callback function compatible with "ReportErrorFunc": stores a copy
+	of the violation
+=========================================================================*/
+void md380_CollectDiagnosticFunc (void* param, const char* recordType, int recordNumber, const char* fieldName, const char* text)
+{
+	MD380_Diagnostics* d = (MD380_Diagnostics*)param;
+	MD380_Diagnostic* item;
+	size_t recordTypeLen = strlen (recordType)+1;
+	size_t fieldNameLen = strlen (fieldName)+1;
+	char* strings;
+	
+	if (d->noOfItems == d->allocated) {
+		unsigned newSize = (d->allocated ? d->allocated*2 : DIAGNOSTICS_MIN_SIZE);
+		MD380_Diagnostic* newItems = (MD380_Diagnostic*)binAlloc (newSize*sizeof (MD380_Diagnostic));
+		if (newItems == NULL) {d->outOfMemory = 1; return;}
+		if (d->items) {
+			memcpy (newItems, d->items, d->noOfItems*sizeof (MD380_Diagnostic));
+			binFree (d->items);
+		}
+		d->items = newItems;
+		d->allocated = newSize;
+	}
+	
+	/* The strings are allocated together with recordType */
+	strings = (char*)md380_ArenaAlloc (&d->strings, recordTypeLen+fieldNameLen+strlen (text)+1);
+	if (strings == NULL) {d->outOfMemory = 1; return;}
+	item = d->items + d->noOfItems++;
+	item->recordNumber = recordNumber;
+	item->recordType = strings;
+	item->fieldName = strings+recordTypeLen;
+	item->text = strings+recordTypeLen+fieldNameLen;
+	strcpy (item->recordType, recordType);
+	strcpy (item->fieldName, fieldName);
+	strcpy (item->text, text);
+}
+
+/*=========================================================================
+	Position of the image within a file of 'size' octets
+=========================================================================*/
+int md380_ImageLayout (unsigned size, unsigned* offset, unsigned* length)
+{
+	if (size == FILE_SIZE_TRDTFile) {
+		(*offset) = 0;
+		(*length) = FILE_SIZE_TRDTFile;
+		return CSVRET_OK;
+	}
+	if (size == FILE_SIZE_TBINFile) {
+		(*offset) = FILE_OFST_TBINFile;
+		(*length) = FILE_SIZE_TBINFile;
+		return CSVRET_OK;
+	}
+	return MD380ERR_FILE_ERROR;
+}
+
+/*=========================================================================
+	Converter
+=========================================================================*/
+void INIT_MD380_Converter (MD380_Converter* converter)
+{
+	unsigned i;
+	converter->image = NULL;
+	converter->offset = 0;
+	converter->length = 0;
+	converter->container = NULL;
+	for (i=0; i<NO_OF_CSV_STREAMS; i++) INIT_MD380_MemBuffer (converter->csv+i);
+	INIT_MD380_Diagnostics (&converter->diagnostics);
+	INIT_MD380_Changes (&converter->changes);
+	INIT_MD380Tables (&converter->tables);
+}
+
+void FREE_MD380_Converter (MD380_Converter* converter)
+{
+	unsigned i;
+	if (converter->image) {binFree (converter->image); converter->image = NULL;}
+	if (converter->container) {binFree (converter->container); converter->container = NULL;}
+	for (i=0; i<NO_OF_CSV_STREAMS; i++) FREE_MD380_MemBuffer (converter->csv+i);
+	FREE_MD380_Diagnostics (&converter->diagnostics);
+	FREE_MD380_Changes (&converter->changes);
+	FREE_MD380Tables (&converter->tables);
+}
+
+/*=========================================================================
+	Allocates the image and the container
+=========================================================================*/
+int md380_AllocConverter (MD380_Converter* converter)
+{
+	if (converter->image == NULL) {
+		converter->image = (t_buffer*)binAlloc (FILE_SIZE_TRDTFile);
+		if (converter->image == NULL) return CSVRET_OUT_OF_MEMORY;
+	}
+	if (converter->container == NULL) {
+		converter->container = (TRDTFile*)binAlloc (sizeof (TRDTFile));
+		if (converter->container == NULL) return CSVRET_OUT_OF_MEMORY;
+	}
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Validates the container, registers the names and resolves the
+	references. Returns CSVRET_OK, MD380ERR_RULES_VIOLATION or
+	CSVRET_OUT_OF_MEMORY.
+=========================================================================*/
+static int md380_ValidateConverter (MD380_Converter* converter, int resolve)
+{
+	int noOfViolations;
+	
+	md380_ResetDiagnostics (&converter->diagnostics);
+	noOfViolations = validateContainer (converter->container, md380_CollectDiagnosticFunc, &converter->diagnostics);
+	noOfViolations += registerContainerNames (&converter->tables, converter->container, md380_CollectDiagnosticFunc, &converter->diagnostics);
+	if (resolve) {
+		noOfViolations += resolveReferences (&converter->tables, converter->container, md380_CollectDiagnosticFunc, &converter->diagnostics);
+	}
+	else {
+		noOfViolations += bindReferences (converter->container, md380_CollectDiagnosticFunc, &converter->diagnostics);
+	}
+	if (converter->diagnostics.outOfMemory) return CSVRET_OUT_OF_MEMORY;
+	return (noOfViolations ? MD380ERR_RULES_VIOLATION : CSVRET_OK);
+}
+
+/*=========================================================================
+	Ignores the violations of an image already reported by md380_LoadImage
+=========================================================================*/
+static void md380_IgnoreDiagnosticFunc (void* param, const char* recordType, int recordNumber, const char* fieldName, const char* text)
+{
+	NOWARN_UNUSED(param);
+	NOWARN_UNUSED(recordType);
+	NOWARN_UNUSED(recordNumber);
+	NOWARN_UNUSED(fieldName);
+	NOWARN_UNUSED(text);
+}
+
+/*=========================================================================
+	Decodes the container again from the image, dropping the tables
+	read by a failed md380_UpdateFromCSV
+=========================================================================*/
+static void md380_RestoreContainer (MD380_Converter* converter)
+{
+	memset (converter->container, 0, sizeof (TRDTFile));
+	decodeBinary_TRDTFile (converter->image, converter->container);
+	bindReferences (converter->container, md380_IgnoreDiagnosticFunc, NULL);
+	FREE_MD380_Changes (&converter->changes);
+}
+
+/*=========================================================================
+	Loads an image from memory
+=========================================================================*/
+int md380_LoadImage (MD380_Converter* converter, const void* data, unsigned size, char** errorMessage)
+{
+	unsigned offset, length;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	md380_ResetDiagnostics (&converter->diagnostics);
+	if (md380_ImageLayout (size, &offset, &length) != CSVRET_OK) {
+		(*errorMessage) = (char*)binAlloc (128);
+		if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
+		sprintf ((*errorMessage), "Image size %u does not match expected size of %u (.rdt) or %u octets (.bin/.img)", size, FILE_SIZE_TRDTFile, FILE_SIZE_TBINFile);
+		return MD380ERR_FILE_ERROR;
+	}
+	
+	if (md380_AllocConverter (converter) != CSVRET_OK) return CSVRET_OUT_OF_MEMORY;
+	
+	/* A .bin file does not hold the whole .rdt image: the rest is zero */
+	memset (converter->image, 0, FILE_SIZE_TRDTFile);
+	memcpy (converter->image+offset, data, length);
+	converter->offset = offset;
+	converter->length = length;
+	
+	memset (converter->container, 0, sizeof (TRDTFile));
+	decodeBinary_TRDTFile (converter->image, converter->container);
+	FREE_MD380_Changes (&converter->changes);
+	
+	return md380_ValidateConverter (converter, 0);
+}
+
+/*=========================================================================
+	Exports the CSV of some tables to memory
+=========================================================================*/
+int md380_ExportCSV (MD380_Converter* converter, unsigned tableMask, char separator, char** errorMessage)
+{
+	unsigned i;
+	int ret;
+	
+	assert (converter->container != NULL);
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	for (i=0; i<NO_OF_CSV_STREAMS; i++) {
+		converter->csv[i].length = 0;
+		if ((tableMask & (1u << i)) == 0) continue;
+		ret = csvStreamFuncs[i].saveCSVStream (csvStreamFuncs[i].recordName, converter->container, separator, md380_MemWriteBinaryFunc, converter->csv+i, errorMessage);
+		if (ret != CSVRET_OK) return ret;
+	}
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Updates the image from CSV held in memory
+=========================================================================*/
+int md380_UpdateFromCSV (MD380_Converter* converter, const char* const csvData [NO_OF_CSV_STREAMS], const unsigned csvLength [NO_OF_CSV_STREAMS], char separator, char** errorMessage)
+{
+	MD380_MemReader reader;
+	unsigned loadedMask = 0;
+	unsigned encodeMask;
+	unsigned i;
+	int ret;
+	
+	assert (converter->container != NULL);
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	md380_ResetDiagnostics (&converter->diagnostics);
+	FREE_MD380_Changes (&converter->changes);
+	md380_SetOriginalCounts (&converter->changes, converter->container);
+	for (i=0; i<NO_OF_CSV_STREAMS; i++) {
+		if (csvData[i] == NULL) continue;
+		md380_OpenMemReader (&reader, csvData[i], csvLength[i]);
+		ret = csvStreamFuncs[i].loadCSVStream (csvStreamFuncs[i].recordName, converter->container, separator, md380_MemReadCharFunc, &reader, errorMessage);
+		if (ret != CSVRET_OK) goto exitFunc;
+		loadedMask |= (1u << i);
+	}
+	
+	ret = md380_ValidateConverter (converter, 1);
+	if (ret != CSVRET_OK) goto exitFunc;
+	
+	/* Only the loaded tables and the tables referring to them, whose */
+	/* references may have been renumbered, are encoded */
+	encodeMask = loadedMask;
+	for (i=0; i<NO_OF_RECORDS_TRDTFile; i++) {
+		if (RECORDS_TRDTFile[i].referencedTables & loadedMask) encodeMask |= (1u << i);
+	}
+	ret = md380_EncodeChanges (converter->image, converter->container, encodeMask, &converter->changes);
+
+exitFunc:
+	/* The image is unchanged: the container goes back to it */
+	if (ret != CSVRET_OK) md380_RestoreContainer (converter);
+	return ret;
+}
@@ -0,0 +1,193 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_LIB_H
+#define __MD380_LIB_H
+#include "md380.h"
+#include "md380_tools.h"
+#include "md380_file.h"
+#include "md380_tables.h"
+#include "md380_changes.h"
+#include "md380_arena.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	In-memory conversion API (librdt2csv).
+	
+	The same conversions of the command line tool, working on buffers
+	instead of files: the image is taken from memory, the CSV of each
+	table is written to and read from memory through the ReadCharFunc
+	and WriteBinaryFunc of the CSV library, and the rules violations
+	are collected as a list instead of being printed.
+	
+	Every MD380_Converter is independent and several of them can be
+	used at the same time by different threads. The only global state
+	is the run statistics (md380_stats, see md380_stats.h) and the
+	allocation counter of binlib.h, which are not thread safe:
+	md380_StatsEnable must not be called while the library is used by
+	more than one thread.
+	The functions are in out/linklib.a, built with the executable.
+=========================================================================*/
+
+/*-------------------------------------------------------------------------
+	Growable memory buffer, written by md380_MemWriteBinaryFunc.
+	Use INIT_MD380_MemBuffer and FREE_MD380_MemBuffer
+-------------------------------------------------------------------------*/
+typedef struct {
+	char* data;
+	unsigned length;
+	unsigned allocated;
+} MD380_MemBuffer;
+
+extern void INIT_MD380_MemBuffer (MD380_MemBuffer* buffer);
+extern void FREE_MD380_MemBuffer (MD380_MemBuffer* buffer);
+
+/* Grows the buffer to hold at least 'size' octets; returns 0=ok 1=out of memory */
+extern int md380_ReserveMemBuffer (MD380_MemBuffer* buffer, unsigned size);
+
+/* CSV Lib callback compatible with "WriteBinaryFunc"; param is a MD380_MemBuffer */
+extern int md380_MemWriteBinaryFunc (void* param, const char* buffer, unsigned length);
+
+/*-------------------------------------------------------------------------
+	Memory source, read by md380_MemReadCharFunc
+-------------------------------------------------------------------------*/
+typedef struct {
+	const char* data;
+	unsigned length;
+	unsigned position;
+} MD380_MemReader;
+
+/* Sets the reader at the beginning of 'data' */
+extern void md380_OpenMemReader (MD380_MemReader* reader, const char* data, unsigned length);
+
+/* CSV Lib callback compatible with "ReadCharFunc"; param is a MD380_MemReader */
+extern int md380_MemReadCharFunc (void* param);
+
+/*-------------------------------------------------------------------------
+	Rules violations, collected by md380_CollectDiagnosticFunc.
+	Use INIT_MD380_Diagnostics and FREE_MD380_Diagnostics
+-------------------------------------------------------------------------*/
+typedef struct {
+	char* recordType;
+	int recordNumber;        /* 0 based, -1 if not related to a record */
+	char* fieldName;
+	char* text;
+} MD380_Diagnostic;
+
+typedef struct {
+	MD380_Diagnostic* items;
+	unsigned noOfItems;
+	unsigned allocated;
+	
+	/* The strings of the items, released together by md380_ResetDiagnostics */
+	MD380_Arena strings;
+	
+	/* Non zero if some violation could not be stored */
+	int outOfMemory;
+} MD380_Diagnostics;
+
+extern void INIT_MD380_Diagnostics (MD380_Diagnostics* diagnostics);
+extern void FREE_MD380_Diagnostics (MD380_Diagnostics* diagnostics);
+
+/* Removes all the diagnostics, keeping the list allocated */
+extern void md380_ResetDiagnostics (MD380_Diagnostics* diagnostics);
+
+/* Callback compatible with "ReportErrorFunc"; param is a MD380_Diagnostics */
+extern void md380_CollectDiagnosticFunc (void* param, const char* recordType, int recordNumber, const char* fieldName, const char* text);
+
+/*=========================================================================
+	Returns in 'offset' and 'length' where the .rdt image lies in a
+	file of 'size' octets: a .rdt file holds the whole image, a .bin
+	file holds it from FILE_OFST_TBINFile.
+	Returns CSVRET_OK or MD380ERR_FILE_ERROR if the size is neither.
+=========================================================================*/
+extern int md380_ImageLayout (unsigned size, unsigned* offset, unsigned* length);
+
+/*=========================================================================
+	Conversion context. Use INIT_MD380_Converter and FREE_MD380_Converter
+=========================================================================*/
+typedef struct {
+	/* Whole .rdt image, FILE_SIZE_TRDTFile octets; the original .rdt */
+	/* or .bin file is the 'length' octets from 'offset' */
+	t_buffer* image;
+	unsigned offset;
+	unsigned length;
+	
+	/* Decoded container */
+	TRDTFile* container;
+	
+	/* CSV of each table, in the same order of csvStreamFuncs */
+	MD380_MemBuffer csv [NO_OF_CSV_STREAMS];
+	
+	/* Rules violations found by the last operation */
+	MD380_Diagnostics diagnostics;
+	
+	/* Changes applied to the image by the last md380_UpdateFromCSV */
+	MD380_Changes changes;
+	
+	MD380Tables tables;
+} MD380_Converter;
+
+extern void INIT_MD380_Converter (MD380_Converter* converter);
+extern void FREE_MD380_Converter (MD380_Converter* converter);
+
+/*=========================================================================
+	Allocates the image and the container in advance; md380_LoadImage
+	does it anyway on first use.
+	Returns CSVRET_OK or CSVRET_OUT_OF_MEMORY.
+=========================================================================*/
+extern int md380_AllocConverter (MD380_Converter* converter);
+
+/*=========================================================================
+	Takes a copy of the .rdt or .bin file 'data' of 'size' octets,
+	decodes it and validates it.
+	Returns CSVRET_xxx and MD380ERR_xxx values; MD380ERR_RULES_VIOLATION
+	if the image breaks some rule, listed in converter->diagnostics.
+	The 'errorMessage' string is allocated with binAlloc in case of
+	error and it is to be freed with binFree.
+=========================================================================*/
+extern int md380_LoadImage (MD380_Converter* converter, const void* data, unsigned size, char** errorMessage);
+
+/*=========================================================================
+	Writes in converter->csv the CSV of the tables selected by
+	'tableMask' (TABLE_xxx bits); the other buffers are emptied.
+	Returns CSVRET_xxx and MD380ERR_xxx values.
+=========================================================================*/
+extern int md380_ExportCSV (MD380_Converter* converter, unsigned tableMask, char separator, char** errorMessage);
+
+/*=========================================================================
+	Replaces the tables having a non NULL entry in 'csvData' (same
+	order of csvStreamFuncs) with the records read from it, validates
+	the result and encodes the changed records in converter->image.
+	The updated file is then the converter->length octets from
+	converter->image+converter->offset.
+	Returns CSVRET_xxx and MD380ERR_xxx values; MD380ERR_RULES_VIOLATION
+	if the result breaks some rule, listed in converter->diagnostics.
+	In case of error the image is left unchanged and the container is
+	decoded again from it, so that the converter holds the image as
+	before the call.
+=========================================================================*/
+extern int md380_UpdateFromCSV (MD380_Converter* converter, const char* const csvData [NO_OF_CSV_STREAMS], const unsigned csvLength [NO_OF_CSV_STREAMS], char separator, char** errorMessage);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
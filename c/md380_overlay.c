@@ -0,0 +1,194 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_overlay.h"
+#include "md380_file.h"
+#include "md380_valid.h"
+#include "crc.h"
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <assert.h>
+
+/* The overlay columns are the GeneralSettings ones plus the file name */
+#define OVERLAY_FILENAME FIELDS_GeneralSettings
+#define OVERLAY_FIELDS   (FIELDS_GeneralSettings+1)
+
+/*=========================================================================
+	Save one generated image
+=========================================================================*/
+static int md380_SaveOverlayImage (const char* fileName, const t_buffer* image, unsigned length, char** errorMessage)
+{
+	FILE* f;
+	size_t written;
+	
+	f = fopen (fileName, "wb");
+	if (f == NULL) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+128);
+		if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
+		sprintf ((*errorMessage), "Error opening '%s' for writing (%s)", fileName, strerror (errno));
+		return MD380ERR_FILE_ERROR;
+	}
+	written = fwrite (image, 1, length, f);
+	if (fclose (f) != 0 || written != length) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+128);
+		if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
+		sprintf ((*errorMessage), "Error writing '%s' (%s)", fileName, strerror (errno));
+		return MD380ERR_FILE_ERROR;
+	}
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Generates one codeplug for each line of an overlay CSV file.
+=========================================================================*/
+int md380_GenerateFromOverlay (const t_buffer* templateBuffer, unsigned offset, unsigned length, const TRDTFile* templateContainer, const char* overlayFileName, char separator, ReportErrorFunc reportErrorFunc, void* reportErrorParam, unsigned* noOfImages, int* noOfViolations, char** errorMessage)
+{
+	int ret;
+	unsigned i, j, numberOfColumns;
+	FieldDescriptor desc[OVERLAY_FIELDS];
+	unsigned fieldsMap[OVERLAY_FIELDS];
+	char outputName[MD380_OVERLAY_PATH_SIZE];
+	int outputNameLength;
+	T_GeneralSettings record;
+	t_buffer* image = NULL;
+	FILE* f = NULL;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	(*noOfImages) = 0;
+	(*noOfViolations) = 0;
+	
+	/* Overlay columns: the GeneralSettings ones plus the file name */
+	memcpy (desc, DESC_GeneralSettings, sizeof (DESC_GeneralSettings));
+	desc[OVERLAY_FILENAME].fieldNameCRC = crc32_AddAsciizLowerCase (0, MD380_OVERLAY_FILENAME_FIELD);
+	desc[OVERLAY_FILENAME].fieldType = BL_unicode;
+	desc[OVERLAY_FILENAME].fieldName = MD380_OVERLAY_FILENAME_FIELD;
+	desc[OVERLAY_FILENAME].enumCount = 0;
+	desc[OVERLAY_FILENAME].fieldEnumerators = NULL;
+	
+	/* The working image is copied from the template only once: each line */
+	/* rewrites the whole GeneralSettings area and nothing else */
+	image = (t_buffer*)binAlloc (FILE_SIZE_TRDTFile);
+	if (image == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+	memcpy (image, templateBuffer, FILE_SIZE_TRDTFile);
+	
+	/* Open the overlay for reading */
+	f = fopen (overlayFileName, "rb");
+	if (f == NULL) {
+		(*errorMessage) = (char*)binAlloc (strlen (overlayFileName)+128);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "Error opening '%s' for reading (%s)", overlayFileName, strerror (errno));
+		ret = MD380ERR_FILE_ERROR;
+		goto exitFunc;
+	}
+	
+	/* Read the titles */
+	ret = md380_ReadColumnsMapping (desc, OVERLAY_FIELDS, fieldsMap, &numberOfColumns, separator, md380_FILEReadCharFunc, f, errorMessage);
+	if (ret != CSVRET_OK) goto exitFunc;
+	for (j=0; j<numberOfColumns && fieldsMap[j] != OVERLAY_FILENAME; j++);
+	if (j >= numberOfColumns) {
+		(*errorMessage) = (char*)binAlloc (strlen (overlayFileName)+128);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "In file '%s', missing column '%s'", overlayFileName, MD380_OVERLAY_FILENAME_FIELD);
+		ret = MD380ERR_INVALID_CSV_HEADER;
+		goto exitFunc;
+	}
+	
+	/* Read the lines */
+	ret = CSVRET_EOF;
+	for (i=0;;i++) {
+		int violations, endOfFile;
+		memcpy (&record, &templateContainer->GeneralSettings, sizeof (record));
+		outputName[0] = '\0';
+		
+		/* Read fields within the line */
+		for (j=0; ; j++) {
+			if (j >= numberOfColumns) {
+				(*errorMessage) = (char*)binAlloc (strlen (overlayFileName)+128);
+				if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+				sprintf ((*errorMessage), "In file '%s', line %d, too many columns", overlayFileName, i+2);
+				ret = MD380ERR_INVALID_CSV_FORMAT;
+				goto exitFunc;
+			}
+			
+			if (fieldsMap[j] == OVERLAY_FILENAME) {
+				ret = csvReadToken (outputName, MD380_OVERLAY_PATH_SIZE, &outputNameLength, separator, md380_FILEReadCharFunc, f);
+				if (ret == CSVRET_EOF && outputNameLength == 0) ret = MD380ERR_EMPTY_EOF;
+				else if (ret != CSVRET_OK && ret != CSVRET_EOL && ret != CSVRET_EOF) {
+					(*errorMessage) = (char*)binAlloc (strlen (overlayFileName)+128);
+					if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+					sprintf ((*errorMessage), "file %s, line %u, field '%s' error %s", overlayFileName, i+2, MD380_OVERLAY_FILENAME_FIELD, md380_CsvRetToString(ret));
+					ret = MD380ERR_INVALID_CSV_FORMAT;
+					goto exitFunc;
+				}
+				else if (outputNameLength >= MD380_OVERLAY_PATH_SIZE) {
+					(*errorMessage) = (char*)binAlloc (strlen (overlayFileName)+128);
+					if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+					sprintf ((*errorMessage), "file %s, line %u, field '%s' too long", overlayFileName, i+2, MD380_OVERLAY_FILENAME_FIELD);
+					ret = MD380ERR_INVALID_CSV_FORMAT;
+					goto exitFunc;
+				}
+			}
+			else {
+				ret = loadCSVField_GeneralSettings (fieldsMap[j], &record, overlayFileName, i+2, separator, md380_FILEReadCharFunc, f, errorMessage);
+			}
+			if (ret == CSVRET_EOL || ret == CSVRET_EOF || ret == MD380ERR_EMPTY_EOF) break;
+			if (ret != CSVRET_OK) goto exitFunc;
+		}
+		if (j == 0 && ret == MD380ERR_EMPTY_EOF) break;
+		if (j+1 < numberOfColumns) {
+			(*errorMessage) = (char*)binAlloc (strlen (overlayFileName)+128);
+			if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+			sprintf ((*errorMessage), "In file '%s', line %d, missing columns", overlayFileName, i+2);
+			ret = MD380ERR_INVALID_CSV_FORMAT;
+			goto exitFunc;
+		}
+		
+		/* Abort if an unexpected result has been detected */
+		if (ret != CSVRET_EOL && ret != CSVRET_EOF) break;
+		endOfFile = (ret == CSVRET_EOF);
+		
+		/* Validate the patched record and skip the line if violated. */
+		/* The record number is reported as one more: i+1 is reported */
+		/* as line i+2 of the file, as the errors above */
+		violations = validate_GeneralSettings (templateContainer, &record, i+1, reportErrorFunc, reportErrorParam);
+		if (outputName[0] == '\0') {
+			reportErrorFunc (reportErrorParam, "Overlay", i+1, MD380_OVERLAY_FILENAME_FIELD, "empty file name");
+			violations++;
+		}
+		(*noOfViolations) += violations;
+		
+		/* Patch the working image and save it */
+		if (violations == 0) {
+			encodeBinary_GeneralSettings (image, OFFSET_GeneralSettings, &record);
+			ret = md380_SaveOverlayImage (outputName, image+offset, length, errorMessage);
+			if (ret != CSVRET_OK) goto exitFunc;
+			(*noOfImages)++;
+		}
+		
+		/* If the last field included an EOF, we are done */
+		if (endOfFile) break;
+	}
+	ret = CSVRET_OK;
+	
+exitFunc:
+	if (f) fclose (f);
+	if (image) binFree (image);
+	return ret;
+}
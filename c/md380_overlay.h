@@ -0,0 +1,65 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_OVERLAY_H
+#define __MD380_OVERLAY_H
+#include "md380.h"
+#include "md380_tools.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/* Name of the overlay column holding the output file name */
+#define MD380_OVERLAY_FILENAME_FIELD "FileName"
+
+/* Maximum length of the output file names in the overlay */
+#define MD380_OVERLAY_PATH_SIZE 512
+
+/*=========================================================================
+	Generates one codeplug for each line of an overlay CSV file.
+	
+	The overlay has the "FileName" column, with the name of the file to
+	be generated, and any subset of the GeneralSettings columns; the
+	columns not listed keep the value found in the template.
+	
+	The template must be already decoded and validated: for each line
+	only the GeneralSettings record is parsed, validated and encoded
+	into a working copy of the template image, which is then saved
+	with the same format (.rdt or .bin) of the template.
+	
+	PARAMETERS
+	
+	templateBuffer     template image, FILE_SIZE_TRDTFile octets
+	offset, length     portion of the image to be saved (see loadRdtFile)
+	templateContainer  decoded template
+	overlayFileName    name of the overlay CSV file
+	noOfImages         receives the number of files generated
+	noOfViolations     receives the number of rules violations; lines
+	                   with violations are reported and skipped
+	
+	Returns CSVRET_xxx and MD380ERR_xxx values. The 'errorMessage' string
+	is allocated with binAlloc in case of error and it is to be freed
+	with binFree.
+=========================================================================*/
+extern int md380_GenerateFromOverlay (const t_buffer* templateBuffer, unsigned offset, unsigned length, const TRDTFile* templateContainer, const char* overlayFileName, char separator, ReportErrorFunc reportErrorFunc, void* reportErrorParam, unsigned* noOfImages, int* noOfViolations, char** errorMessage);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -0,0 +1,154 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_refgraph.h"
+#include "md380_stats.h"
+#include <string.h>
+#include <assert.h>
+#include "crc.h"
+
+/*=========================================================================
+	Resolves the references of an edge
+=========================================================================*/
+int md380_ResolveEdge (const MD380Tables* tab, TRDTFile* container, const ReferenceEdge* edge, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+{
+	const RecordDescriptor* source = RECORDS_TRDTFile+edge->sourceTable;
+	const FieldDescriptor* fd = source->fieldDescriptors+edge->sourceField;
+	const FieldLayout* fl = source->fieldLayouts+edge->sourceField;
+	const LookupTable* lookup = (const LookupTable*)((const unsigned char*)tab+edge->lookupOffset);
+	const char* targetName = RECORDS_TRDTFile[edge->targetTable].recordName;
+	unsigned count = md380_RecordCount (source, container);
+	unsigned char* records = (unsigned char*)container+source->containerOffset;
+	int noOfViolations = 0;
+	unsigned i, j;
+
+	for (i=0; i<count; i++) {
+		unsigned char* record = records+i*source->recordSize;
+		for (j=0; j<edge->arity; j++) {
+			t_reference* ref = (t_reference*)(record+fl[j].structOffset);
+			assert (fl[j].layoutType == FL_reference);
+			if (md380_ResolveReference (fd+j, ref, lookup, source->recordName, i, edge->fieldName, targetName, reportErrorFunc, reportErrorParam)) noOfViolations++;
+		}
+	}
+	MD380_STATS_ADD (referencesResolved, count*edge->arity-noOfViolations);
+	return noOfViolations;
+}
+
+/*=========================================================================
+	Binds the references of an edge
+=========================================================================*/
+int md380_BindEdge (TRDTFile* container, const ReferenceEdge* edge, const BoundKey* keys, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+{
+	const RecordDescriptor* source = RECORDS_TRDTFile+edge->sourceTable;
+	const RecordDescriptor* target = RECORDS_TRDTFile+edge->targetTable;
+	const FieldDescriptor* fd = source->fieldDescriptors+edge->sourceField;
+	const FieldLayout* fl = source->fieldLayouts+edge->sourceField;
+	const FieldLayout* keyLayout = target->fieldLayouts+edge->targetKeyField;
+	unsigned count = md380_RecordCount (source, container);
+	unsigned targetCount = md380_RecordCount (target, container);
+	unsigned char* records = (unsigned char*)container+source->containerOffset;
+	const unsigned char* targets = (const unsigned char*)container+target->containerOffset;
+	int noOfViolations = 0;
+	unsigned i, j;
+
+	for (i=0; i<count; i++) {
+		unsigned char* record = records+i*source->recordSize;
+		for (j=0; j<edge->arity; j++) {
+			t_reference* ref = (t_reference*)(record+fl[j].structOffset);
+			unsigned targetNo = (ref->refLineNo > 0 && ref->refLineNo <= targetCount) ? ref->refLineNo-1 : 0;
+			const unsigned char* key = targets+targetNo*target->recordSize+keyLayout->structOffset;
+			int ret;
+			assert (fl[j].layoutType == FL_reference);
+			if (edge->keyKind != RK_unicode) {
+				ret = md380_BindReferenceNumeric (fd, ref, targetCount, md380_GetNumeric (key, keyLayout->numericSize), source->recordName, i, edge->fieldName, target->recordName, reportErrorFunc, reportErrorParam);
+			}
+			else if (keys != NULL) {
+				ret = md380_BindReferenceKey (fd, ref, targetCount, (const t_unicode*)key, keys[targetNo].refId, source->recordName, i, edge->fieldName, target->recordName, reportErrorFunc, reportErrorParam);
+			}
+			else {
+				ret = md380_BindReferenceUnicode (fd, ref, targetCount, (const t_unicode*)key, source->recordName, i, edge->fieldName, target->recordName, reportErrorFunc, reportErrorParam);
+			}
+			if (ret) noOfViolations++;
+		}
+	}
+	MD380_STATS_ADD (referencesResolved, count*edge->arity-noOfViolations);
+	return noOfViolations;
+}
+
+/*=========================================================================
+	Computes the keys of the referenced records
+=========================================================================*/
+BoundKey* md380_ComputeBoundKeys (const TRDTFile* container, unsigned table, unsigned keyField)
+{
+	const RecordDescriptor* rd = RECORDS_TRDTFile+table;
+	const FieldLayout* keyLayout = rd->fieldLayouts+keyField;
+	const unsigned char* records = (const unsigned char*)container+rd->containerOffset;
+	unsigned count = md380_RecordCount (rd, container);
+	BoundKey* keys;
+	unsigned i;
+
+	assert (keyLayout->layoutType == FL_unicode);
+	if (count == 0) return NULL;
+	keys = (BoundKey*)binAlloc (count*sizeof (BoundKey));
+	if (keys == NULL) return NULL;
+	memset (keys, 0, count*sizeof (BoundKey));
+	for (i=0; i<count; i++) {
+		const t_unicode* name = (const t_unicode*)(records+i*rd->recordSize+keyLayout->structOffset);
+		keys[i].refId = crc32_AddUnicodeLowerCase (0, name);
+	}
+	return keys;
+}
+
+/*=========================================================================
+	Resolves or binds the selected edges
+=========================================================================*/
+int md380_ResolveEdges (const MD380Tables* tab, TRDTFile* container, const ReferenceEdge* edges, unsigned noOfEdges, unsigned tableMask, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+{
+	int noOfViolations = 0;
+	unsigned i;
+	for (i=0; i<noOfEdges; i++) {
+		if (tableMask & (1u << edges[i].sourceTable)) {
+			noOfViolations += md380_ResolveEdge (tab, container, edges+i, reportErrorFunc, reportErrorParam);
+		}
+	}
+	return noOfViolations;
+}
+
+int md380_BindEdges (TRDTFile* container, const ReferenceEdge* edges, unsigned noOfEdges, unsigned tableMask, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+{
+	BoundKey* keys [NO_OF_RECORDS_TRDTFile];
+	int computed [NO_OF_RECORDS_TRDTFile];
+	int noOfViolations = 0;
+	unsigned i;
+
+	memset (keys, 0, sizeof (keys));
+	memset (computed, 0, sizeof (computed));
+	for (i=0; i<noOfEdges; i++) {
+		const ReferenceEdge* edge = edges+i;
+		if (!(tableMask & (1u << edge->sourceTable))) continue;
+		if (edge->keyKind == RK_unicode && !computed[edge->targetTable]) {
+			keys[edge->targetTable] = md380_ComputeBoundKeys (container, edge->targetTable, edge->targetKeyField);
+			computed[edge->targetTable] = 1;
+		}
+		noOfViolations += md380_BindEdge (container, edge, keys[edge->targetTable], reportErrorFunc, reportErrorParam);
+	}
+	for (i=0; i<NO_OF_RECORDS_TRDTFile; i++) {
+		if (keys[i]) binFree (keys[i]);
+	}
+	return noOfViolations;
+}
@@ -0,0 +1,113 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_REFGRAPH_H
+#define __MD380_REFGRAPH_H
+#include "md380.h"
+#include "md380_tools.h"
+#include "md380_tables.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Reference graph.
+	
+	Each reference field of a record type, possibly repeated, is an edge
+	towards the record type it refers to. The edges are generated in
+	md380_resolve.c and walked by the generic engine below, which only
+	visits the records present in the container.
+	
+	An edge only writes the t_reference fields of its own source field
+	and reads its target records and lookup table: different edges can
+	be processed on separate threads, provided that ReportErrorFunc is
+	thread safe.
+=========================================================================*/
+
+/* Kind of key identifying the referenced record */
+typedef enum {
+	RK_numeric,       /* numeric field, e.g. DigitalContact.CallId */
+	RK_unicode        /* name field, e.g. ChannelInformation.Name */
+} ReferenceKeyKind;
+
+typedef struct {
+	/* Record type holding the reference (index in RECORDS_TRDTFile), */
+	/* its first field in DESC_xxx/LAYOUT_xxx and number of repetitions */
+	unsigned sourceTable;
+	unsigned sourceField;
+	unsigned arity;
+	
+	/* Name of the field, without the repetition number */
+	const char* fieldName;
+	
+	/* Record type referenced (index in RECORDS_TRDTFile) and its key */
+	/* field in DESC_xxx/LAYOUT_xxx */
+	unsigned targetTable;
+	ReferenceKeyKind keyKind;
+	unsigned targetKeyField;
+	
+	/* Offset of the LookupTable of the referenced type in MD380Tables */
+	unsigned lookupOffset;
+	
+} ReferenceEdge;
+
+/* Key of a referenced record, computed once and shared by all the */
+/* references bound to that record */
+typedef struct {
+	/* CRC-32 of the lowercase name, as in t_reference.refId */
+	unsigned refId;
+} BoundKey;
+
+/*=========================================================================
+	Resolves the references of an edge: the names read from a CSV are
+	translated into line numbers through the lookup tables.
+	Returns the number of violations reported.
+=========================================================================*/
+extern int md380_ResolveEdge (const MD380Tables* tab, TRDTFile* container, const ReferenceEdge* edge, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
+/*=========================================================================
+	Binds the references of an edge: the line numbers read from the
+	binary image are bound to the name or value of the referenced record.
+	For RK_unicode edges, 'keys' holds the BoundKey of each record of the
+	target type (see md380_ComputeBoundKeys); if NULL, the keys are
+	computed for each reference.
+	Returns the number of violations reported.
+=========================================================================*/
+extern int md380_BindEdge (TRDTFile* container, const ReferenceEdge* edge, const BoundKey* keys, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
+/*=========================================================================
+	Computes the BoundKey of the records of type 'table' whose key is
+	the unicode field 'keyField'. Returns a binAlloc'ed array holding
+	one element per record present in the container (to be binFree'd),
+	NULL if there are no records or in case of out of memory.
+=========================================================================*/
+extern BoundKey* md380_ComputeBoundKeys (const TRDTFile* container, unsigned table, unsigned keyField);
+
+/*=========================================================================
+	Same as above for all the 'edges' whose source record type is
+	selected by 'tableMask' (TABLE_xxx bits). When binding, the keys of
+	each referenced record type are computed once for all its edges.
+=========================================================================*/
+extern int md380_ResolveEdges (const MD380Tables* tab, TRDTFile* container, const ReferenceEdge* edges, unsigned noOfEdges, unsigned tableMask, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+extern int md380_BindEdges (TRDTFile* container, const ReferenceEdge* edges, unsigned noOfEdges, unsigned tableMask, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -0,0 +1,280 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_refindex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "crc.h"
+
+/* Initialize */
+void INIT_MD380_RefIndex (MD380_RefIndex* index)
+{
+	memset (index, 0, sizeof (*index));
+}
+
+/* Free */
+void FREE_MD380_RefIndex (MD380_RefIndex* index)
+{
+	unsigned i;
+	for (i=0; i<NO_OF_RECORDS_TRDTFile; i++) {
+		if (index->heads[i]) binFree (index->heads[i]);
+	}
+	if (index->entries) binFree (index->entries);
+	INIT_MD380_RefIndex (index);
+}
+
+/*=========================================================================
+	The t_reference slot of an entry
+=========================================================================*/
+static t_reference* md380_RefIndexSlot (const MD380_RefIndex* index, TRDTFile* container, const MD380_RefIndexEntry* entry)
+{
+	const ReferenceEdge* edge = index->edges+entry->edge;
+	const RecordDescriptor* source = RECORDS_TRDTFile+edge->sourceTable;
+	unsigned char* record = (unsigned char*)container+source->containerOffset+entry->recordNo*source->recordSize;
+	return (t_reference*)(record+source->fieldLayouts[edge->sourceField+entry->slot].structOffset);
+}
+
+/*=========================================================================
+	Builds the index
+=========================================================================*/
+int md380_BuildRefIndex (MD380_RefIndex* index, TRDTFile* container, const ReferenceEdge* edges, unsigned noOfEdges)
+{
+	unsigned maxEntries = 0;
+	unsigned e, i, j;
+
+	FREE_MD380_RefIndex (index);
+	index->edges = edges;
+	index->noOfEdges = noOfEdges;
+
+	/* Allocate the heads of the referenced types and the entries */
+	for (e=0; e<noOfEdges; e++) {
+		const RecordDescriptor* target = RECORDS_TRDTFile+edges[e].targetTable;
+		maxEntries += md380_RecordCount (RECORDS_TRDTFile+edges[e].sourceTable, container)*edges[e].arity;
+		if (index->heads[edges[e].targetTable] == NULL) {
+			index->heads[edges[e].targetTable] = (unsigned*)binAlloc (target->maxCount*sizeof (unsigned));
+			if (index->heads[edges[e].targetTable] == NULL) goto outOfMemory;
+			for (i=0; i<target->maxCount; i++) index->heads[edges[e].targetTable][i] = REFINDEX_NONE;
+		}
+	}
+	if (maxEntries > 0) {
+		index->entries = (MD380_RefIndexEntry*)binAlloc (maxEntries*sizeof (MD380_RefIndexEntry));
+		if (index->entries == NULL) goto outOfMemory;
+	}
+
+	/* Link each bound reference to its target */
+	for (e=0; e<noOfEdges; e++) {
+		const ReferenceEdge* edge = edges+e;
+		const RecordDescriptor* source = RECORDS_TRDTFile+edge->sourceTable;
+		const FieldDescriptor* fd = source->fieldDescriptors+edge->sourceField;
+		unsigned count = md380_RecordCount (source, container);
+		unsigned targetCount = md380_RecordCount (RECORDS_TRDTFile+edge->targetTable, container);
+		unsigned* heads = index->heads[edge->targetTable];
+		for (i=0; i<count; i++) {
+			for (j=0; j<edge->arity; j++) {
+				MD380_RefIndexEntry* entry = index->entries+index->noOfEntries;
+				const t_reference* ref;
+				entry->edge = e;
+				entry->recordNo = i;
+				entry->slot = j;
+				ref = md380_RefIndexSlot (index, container, entry);
+				if (ref->refLineNo == 0 || ref->refLineNo > targetCount || md380_IsEnumReference (fd, ref)) continue;
+				entry->next = heads[ref->refLineNo-1];
+				heads[ref->refLineNo-1] = index->noOfEntries++;
+			}
+		}
+	}
+	return CSVRET_OK;
+
+outOfMemory:
+	FREE_MD380_RefIndex (index);
+	return CSVRET_OUT_OF_MEMORY;
+}
+
+/*=========================================================================
+	Counts the references to a record
+=========================================================================*/
+unsigned md380_CountReferences (const MD380_RefIndex* index, unsigned table, unsigned lineNo)
+{
+	unsigned n = 0;
+	unsigned k;
+	assert (table < NO_OF_RECORDS_TRDTFile);
+	if (index->heads[table] == NULL || lineNo < 1 || lineNo > RECORDS_TRDTFile[table].maxCount) return 0;
+	for (k=index->heads[table][lineNo-1]; k!=REFINDEX_NONE; k=index->entries[k].next) {
+		if (index->entries[k].recordNo != REFINDEX_NONE) n++;
+	}
+	return n;
+}
+
+/*=========================================================================
+	Checks that a record exists; returns the RecordDescriptor or NULL
+	with the error message set
+=========================================================================*/
+static const RecordDescriptor* md380_RefIndexRecord (const TRDTFile* container, unsigned table, unsigned lineNo, char** errorMessage)
+{
+	const RecordDescriptor* rd = RECORDS_TRDTFile+table;
+	unsigned count = md380_RecordCount (rd, container);
+	assert (table < NO_OF_RECORDS_TRDTFile);
+	if (rd->countOffset == RD_NO_COUNT) {
+		(*errorMessage) = (char*)binAlloc (strlen (rd->recordName)+60);
+		if (*errorMessage) sprintf ((*errorMessage), "Error in %s: single record, no lines", rd->recordName);
+		return NULL;
+	}
+	if (lineNo < 1 || lineNo > count) {
+		(*errorMessage) = (char*)binAlloc (strlen (rd->recordName)+60);
+		if (*errorMessage) sprintf ((*errorMessage), "Error in %s: line %u not found (%u records)", rd->recordName, lineNo, count);
+		return NULL;
+	}
+	return rd;
+}
+
+/*=========================================================================
+	Renames a record
+=========================================================================*/
+int md380_RenameRecord (MD380_RefIndex* index, TRDTFile* container, unsigned table, unsigned lineNo, const char* newKey, unsigned* noOfReferences, char** errorMessage)
+{
+	const RecordDescriptor* rd;
+	const ReferenceEdge* edge = NULL;
+	const FieldLayout* keyLayout;
+	unsigned char* key;
+	unsigned refId;
+	unsigned n = 0;
+	unsigned k;
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+
+	rd = md380_RefIndexRecord (container, table, lineNo, errorMessage);
+	if (rd == NULL) return MD380ERR_FIELD_NOT_FOUND;
+	for (k=0; k<index->noOfEdges && edge==NULL; k++) {
+		if (index->edges[k].targetTable == table) edge = index->edges+k;
+	}
+	if (edge == NULL) {
+		(*errorMessage) = (char*)binAlloc (strlen (rd->recordName)+60);
+		if (*errorMessage) sprintf ((*errorMessage), "Error in %s: records not referenced by name", rd->recordName);
+		return MD380ERR_FIELD_NOT_FOUND;
+	}
+	keyLayout = rd->fieldLayouts+edge->targetKeyField;
+	key = (unsigned char*)container+rd->containerOffset+(lineNo-1)*rd->recordSize+keyLayout->structOffset;
+
+	/* Set the key */
+	if (edge->keyKind == RK_unicode) {
+		t_unicode* name = (t_unicode*)key;
+		t_unicode* u = (t_unicode*)binAlloc ((keyLayout->unicodeChars+1)*sizeof (t_unicode));
+		if (u == NULL) return CSVRET_OUT_OF_MEMORY;
+		memset (u, 0, (keyLayout->unicodeChars+1)*sizeof (t_unicode));
+		if (utf8ToUnicode (u, keyLayout->unicodeChars, newKey, strlen (newKey)) > keyLayout->unicodeChars) {
+			binFree (u);
+			(*errorMessage) = (char*)binAlloc (strlen (rd->recordName)+strlen (newKey)+60);
+			if (*errorMessage) sprintf ((*errorMessage), "Error in %s: name '%s' too long", rd->recordName, newKey);
+			return MD380ERR_INVALID_VALUE;
+		}
+		memcpy (name, u, (keyLayout->unicodeChars+1)*sizeof (t_unicode));
+		binFree (u);
+		refId = crc32_AddUnicodeLowerCase (0, name);
+	}
+	else {
+		char* end;
+		t_numeric value = strtoul (newKey, &end, 10);
+		if (*newKey < '0' || *newKey > '9' || *end != '\0' || md380_SetNumeric (key, keyLayout->numericSize, value) != 0) {
+			(*errorMessage) = (char*)binAlloc (strlen (rd->recordName)+strlen (newKey)+60);
+			if (*errorMessage) sprintf ((*errorMessage), "Error in %s: invalid value '%s'", rd->recordName, newKey);
+			return MD380ERR_INVALID_VALUE;
+		}
+		refId = (unsigned)value;
+	}
+
+	/* Update the references; resolvedName already points to the key */
+	for (k=index->heads[table][lineNo-1]; k!=REFINDEX_NONE; k=index->entries[k].next) {
+		t_reference* ref;
+		if (index->entries[k].recordNo == REFINDEX_NONE) continue;
+		ref = md380_RefIndexSlot (index, container, index->entries+k);
+		ref->refId = refId;
+		n++;
+	}
+	if (noOfReferences) (*noOfReferences) = n;
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Deletes a record
+=========================================================================*/
+int md380_DeleteRecord (MD380_RefIndex* index, TRDTFile* container, unsigned table, unsigned lineNo, unsigned* noOfReferences, char** errorMessage)
+{
+	const RecordDescriptor* rd;
+	unsigned char* records;
+	unsigned* count;
+	unsigned n = 0;
+	unsigned i, k;
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+
+	rd = md380_RefIndexRecord (container, table, lineNo, errorMessage);
+	if (rd == NULL) return MD380ERR_FIELD_NOT_FOUND;
+	records = (unsigned char*)container+rd->containerOffset;
+	count = (unsigned*)((unsigned char*)container+rd->countOffset);
+
+	/* Clear the references to the record */
+	if (index->heads[table]) {
+		for (k=index->heads[table][lineNo-1]; k!=REFINDEX_NONE; k=index->entries[k].next) {
+			t_reference* ref;
+			if (index->entries[k].recordNo == REFINDEX_NONE) continue;
+			ref = md380_RefIndexSlot (index, container, index->entries+k);
+			memset (ref, 0, sizeof (*ref));
+			n++;
+		}
+	}
+
+	/* The references held by the record disappear with it; the ones */
+	/* held by the following records move up with them */
+	for (k=0; k<index->noOfEntries; k++) {
+		MD380_RefIndexEntry* entry = index->entries+k;
+		if (index->edges[entry->edge].sourceTable != table || entry->recordNo == REFINDEX_NONE) continue;
+		if (entry->recordNo == lineNo-1) entry->recordNo = REFINDEX_NONE;
+		else if (entry->recordNo > lineNo-1) entry->recordNo--;
+	}
+
+	/* Remove the record */
+	memmove (records+(lineNo-1)*rd->recordSize, records+lineNo*rd->recordSize, ((*count)-lineNo)*rd->recordSize);
+	memset (records+((*count)-1)*rd->recordSize, 0, rd->recordSize);
+
+	/* Renumber the references to the following records */
+	if (index->heads[table]) {
+		unsigned* heads = index->heads[table];
+		for (i=lineNo; i<(*count); i++) {
+			for (k=heads[i]; k!=REFINDEX_NONE; k=index->entries[k].next) {
+				const ReferenceEdge* edge;
+				t_reference* ref;
+				if (index->entries[k].recordNo == REFINDEX_NONE) continue;
+				edge = index->edges+index->entries[k].edge;
+				ref = md380_RefIndexSlot (index, container, index->entries+k);
+				assert (ref->refLineNo == i+1);
+				ref->refLineNo = i;
+				if (ref->resolvedName) {
+					ref->resolvedName = (const t_unicode*)(records+(i-1)*rd->recordSize+rd->fieldLayouts[edge->targetKeyField].structOffset);
+				}
+			}
+			heads[i-1] = heads[i];
+		}
+		heads[(*count)-1] = REFINDEX_NONE;
+	}
+	(*count)--;
+
+	if (noOfReferences) (*noOfReferences) = n;
+	return CSVRET_OK;
+}
@@ -0,0 +1,120 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_REFINDEX_H
+#define __MD380_REFINDEX_H
+#include "md380.h"
+#include "md380_tools.h"
+#include "md380_refgraph.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Reverse reference index.
+	
+	For each record referenced by some other record, the index lists the
+	t_reference slots pointing to it, as (edge, record, repetition). It is
+	built in one pass over a bound or resolved container; renaming or
+	deleting a record then touches exactly the slots referring to it.
+	
+	The index holds positions, not pointers: it stays valid while records
+	are deleted through md380_DeleteRecord, but it must be rebuilt if the
+	container is changed in any other way.
+=========================================================================*/
+
+#define REFINDEX_NONE 0xFFFFFFFF
+
+/* One t_reference slot referring to a record */
+typedef struct {
+	/* Edge of the reference, index in MD380_RefIndex.edges */
+	unsigned edge;
+	
+	/* 0-based record holding the reference, REFINDEX_NONE if deleted */
+	unsigned recordNo;
+	
+	/* Repetition of the field, 0..edge->arity-1 */
+	unsigned slot;
+	
+	/* Next slot referring to the same record, REFINDEX_NONE at the end */
+	unsigned next;
+} MD380_RefIndexEntry;
+
+/* Use INIT_MD380_RefIndex and FREE_MD380_RefIndex */
+typedef struct {
+	const ReferenceEdge* edges;
+	unsigned noOfEdges;
+	
+	/* For each record type, first entry referring to each of its */
+	/* records (maxCount elements); NULL if the type is not referenced */
+	unsigned* heads [NO_OF_RECORDS_TRDTFile];
+	
+	/* Entries, linked by 'next' */
+	MD380_RefIndexEntry* entries;
+	unsigned noOfEntries;
+} MD380_RefIndex;
+
+/* Initialize */
+extern void INIT_MD380_RefIndex (MD380_RefIndex* index);
+
+/* Free */
+extern void FREE_MD380_RefIndex (MD380_RefIndex* index);
+
+/*=========================================================================
+	Builds the index of the references of 'container' described by
+	'edges' (normally REFERENCE_EDGES_TRDTFile), which must be bound or
+	resolved. Enumeration values and empty references are not indexed.
+	Returns CSVRET_OK or CSVRET_OUT_OF_MEMORY.
+=========================================================================*/
+extern int md380_BuildRefIndex (MD380_RefIndex* index, TRDTFile* container, const ReferenceEdge* edges, unsigned noOfEdges);
+
+/*=========================================================================
+	Number of references to record 'lineNo' (1-based) of type 'table'
+	(index in RECORDS_TRDTFile)
+=========================================================================*/
+extern unsigned md380_CountReferences (const MD380_RefIndex* index, unsigned table, unsigned lineNo);
+
+/*=========================================================================
+	Renames record 'lineNo' (1-based) of type 'table': its key field is
+	set to 'newKey' (UTF-8 name or decimal value, as in the CSV files)
+	and the references to it are updated. Other fields of the record are
+	not changed; the line numbers in the binary image do not change.
+	
+	Deletes record 'lineNo' (1-based) of type 'table': the references to
+	it are cleared, the following records are moved up and the
+	references to them are renumbered.
+	
+	'noOfReferences', if not NULL, receives the number of references
+	updated or cleared. The container is not validated: duplicate names
+	are detected by registerContainerNames.
+	
+	Return CSVRET_OK, CSVRET_OUT_OF_MEMORY, MD380ERR_FIELD_NOT_FOUND if
+	the record does not exist (or, when renaming, if its type is not
+	referenced by any other type) or MD380ERR_INVALID_VALUE if 'newKey'
+	is not a valid key.
+	The 'errorMessage' string is allocated with binAlloc in case of error
+	and it is to be freed with binFree.
+=========================================================================*/
+extern int md380_RenameRecord (MD380_RefIndex* index, TRDTFile* container, unsigned table, unsigned lineNo, const char* newKey, unsigned* noOfReferences, char** errorMessage);
+extern int md380_DeleteRecord (MD380_RefIndex* index, TRDTFile* container, unsigned table, unsigned lineNo, unsigned* noOfReferences, char** errorMessage);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -0,0 +1,158 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_reorder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "crc.h"
+
+/* Sort key of a record */
+typedef struct {
+	t_numeric value;
+	const t_unicode* name;
+	unsigned position;
+} SortItem;
+
+/*=========================================================================
+	Compares two sort keys; ties are broken by the original position
+	so that qsort behaves as a stable sort. Names are compared with the
+	case folding of the name lookup (see crc32_UnicodeLowerCase)
+=========================================================================*/
+static int compareSortItems (const void* p1, const void* p2)
+{
+	const SortItem* a = (const SortItem*)p1;
+	const SortItem* b = (const SortItem*)p2;
+	if (a->name) {
+		const t_unicode* s1 = a->name;
+		const t_unicode* s2 = b->name;
+		for (; *s1 || *s2; s1++, s2++) {
+			t_unicode c1 = crc32_UnicodeLowerCase (*s1);
+			t_unicode c2 = crc32_UnicodeLowerCase (*s2);
+			if (c1 != c2) return (c1 < c2 ? -1 : 1);
+		}
+	}
+	else if (a->value != b->value) {
+		return (a->value < b->value ? -1 : 1);
+	}
+	return (a->position < b->position ? -1 : (a->position > b->position));
+}
+
+/*=========================================================================
+	Computes the sorting permutation
+=========================================================================*/
+int md380_SortPermutation (const TRDTFile* container, unsigned table, const char* fieldName, unsigned* order, char** errorMessage)
+{
+	const RecordDescriptor* rd = RECORDS_TRDTFile+table;
+	const unsigned char* records = (const unsigned char*)container+rd->containerOffset;
+	unsigned count = md380_RecordCount (rd, container);
+	unsigned nameCrc = crc32_AddAsciizLowerCase (0, fieldName);
+	const FieldLayout* fl;
+	SortItem* items;
+	unsigned i;
+	assert (table < NO_OF_RECORDS_TRDTFile);
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+
+	for (i=0; i<rd->noOfFields; i++) {
+		if (rd->fieldDescriptors[i].fieldNameCRC == nameCrc) break;
+	}
+	if (i >= rd->noOfFields || (rd->fieldLayouts[i].layoutType != FL_numeric && rd->fieldLayouts[i].layoutType != FL_unicode)) {
+		(*errorMessage) = (char*)binAlloc (strlen (rd->recordName)+strlen (fieldName)+60);
+		if (*errorMessage) sprintf ((*errorMessage), "Error in %s: '%s' is not a number or name field", rd->recordName, fieldName);
+		return MD380ERR_FIELD_NOT_FOUND;
+	}
+	fl = rd->fieldLayouts+i;
+	if (count == 0) return CSVRET_OK;
+
+	items = (SortItem*)binAlloc (count*sizeof (SortItem));
+	if (items == NULL) return CSVRET_OUT_OF_MEMORY;
+	for (i=0; i<count; i++) {
+		const unsigned char* field = records+i*rd->recordSize+fl->structOffset;
+		items[i].value = (fl->layoutType == FL_numeric ? md380_GetNumeric (field, fl->numericSize) : 0);
+		items[i].name = (fl->layoutType == FL_unicode ? (const t_unicode*)field : NULL);
+		items[i].position = i;
+	}
+	qsort (items, count, sizeof (SortItem), compareSortItems);
+	for (i=0; i<count; i++) {
+		order[i] = items[i].position;
+	}
+	binFree (items);
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Applies a permutation
+=========================================================================*/
+int md380_ApplyPermutation (TRDTFile* container, const ReferenceEdge* edges, unsigned noOfEdges, unsigned table, const unsigned* order, unsigned* noOfMoved)
+{
+	const RecordDescriptor* rd = RECORDS_TRDTFile+table;
+	unsigned char* records = (unsigned char*)container+rd->containerOffset;
+	unsigned count = md380_RecordCount (rd, container);
+	unsigned char* copy;
+	unsigned* inverse;
+	unsigned moved = 0;
+	unsigned e, i, j;
+	assert (table < NO_OF_RECORDS_TRDTFile);
+
+	if (noOfMoved) (*noOfMoved) = 0;
+	if (count == 0) return CSVRET_OK;
+	copy = (unsigned char*)binAlloc (count*rd->recordSize);
+	inverse = (unsigned*)binAlloc (count*sizeof (unsigned));
+	if (copy == NULL || inverse == NULL) {
+		if (copy) binFree (copy);
+		if (inverse) binFree (inverse);
+		return CSVRET_OUT_OF_MEMORY;
+	}
+
+	/* Move the records */
+	memcpy (copy, records, count*rd->recordSize);
+	for (i=0; i<count; i++) {
+		assert (order[i] < count);
+		memcpy (records+i*rd->recordSize, copy+order[i]*rd->recordSize, rd->recordSize);
+		inverse[order[i]] = i;
+		if (order[i] != i) moved++;
+	}
+
+	/* Remap the references to them */
+	for (e=0; e<noOfEdges && moved>0; e++) {
+		const ReferenceEdge* edge = edges+e;
+		const RecordDescriptor* source = RECORDS_TRDTFile+edge->sourceTable;
+		const FieldDescriptor* fd = source->fieldDescriptors+edge->sourceField;
+		const FieldLayout* fl = source->fieldLayouts+edge->sourceField;
+		unsigned sourceCount = md380_RecordCount (source, container);
+		if (edge->targetTable != table) continue;
+		for (i=0; i<sourceCount; i++) {
+			unsigned char* record = (unsigned char*)container+source->containerOffset+i*source->recordSize;
+			for (j=0; j<edge->arity; j++) {
+				t_reference* ref = (t_reference*)(record+fl[j].structOffset);
+				if (ref->refLineNo == 0 || ref->refLineNo > count || md380_IsEnumReference (fd, ref)) continue;
+				ref->refLineNo = inverse[ref->refLineNo-1]+1;
+				if (ref->resolvedName) {
+					ref->resolvedName = (const t_unicode*)(records+(ref->refLineNo-1)*rd->recordSize+rd->fieldLayouts[edge->targetKeyField].structOffset);
+				}
+			}
+		}
+	}
+
+	binFree (copy);
+	binFree (inverse);
+	if (noOfMoved) (*noOfMoved) = moved;
+	return CSVRET_OK;
+}
@@ -0,0 +1,68 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_REORDER_H
+#define __MD380_REORDER_H
+#include "md380.h"
+#include "md380_tools.h"
+#include "md380_refgraph.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Reordering of the records of a table.
+	
+	A permutation lists, for each new position, the 0-based position
+	the record comes from. Applying it moves the records and remaps
+	every reference to them through the inverse permutation, so the
+	meaning of the image does not change.
+=========================================================================*/
+
+/*=========================================================================
+	Computes the permutation sorting the records of type 'table' (index
+	in RECORDS_TRDTFile) by the field 'fieldName' (as in the CSV header,
+	any case), in ascending order. Numeric fields are compared by value,
+	names without regard to the case of latin letters; records with the
+	same key keep their order.
+	
+	'order' receives md380_RecordCount elements; it must be able to hold
+	RECORDS_TRDTFile[table].maxCount.
+	
+	Returns CSVRET_OK, CSVRET_OUT_OF_MEMORY or MD380ERR_FIELD_NOT_FOUND
+	if the field does not exist or is not a number or a name. The
+	'errorMessage' string is allocated with binAlloc in case of error
+	and it is to be freed with binFree.
+=========================================================================*/
+extern int md380_SortPermutation (const TRDTFile* container, unsigned table, const char* fieldName, unsigned* order, char** errorMessage);
+
+/*=========================================================================
+	Moves the records of type 'table' as listed in 'order' and remaps
+	the references to them described by 'edges' (normally
+	REFERENCE_EDGES_TRDTFile), which must be bound or resolved.
+	'noOfMoved', if not NULL, receives the number of records that
+	changed position.
+	Returns CSVRET_OK or CSVRET_OUT_OF_MEMORY.
+=========================================================================*/
+extern int md380_ApplyPermutation (TRDTFile* container, const ReferenceEdge* edges, unsigned noOfEdges, unsigned table, const unsigned* order, unsigned* noOfMoved);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -4,6 +4,11 @@
 #include "md380.h"
 #include "md380_valid.h"
 #include "md380_tables.h"
+#include "md380_refgraph.h"
+
+/* Reference fields of all the record types */
+#define NO_OF_REFERENCE_EDGES_TRDTFile 9
+extern const ReferenceEdge REFERENCE_EDGES_TRDTFile [NO_OF_REFERENCE_EDGES_TRDTFile];
 
 /* Resolve the references in a container. Resolves the references read from a CSV, */
 /* i.e. it translates the unresolvedCrc into a refLineNo within t_reference  */
@@ -13,4 +18,8 @@ extern int resolveReferences(const MD380Tables* tab, TRDTFile* container, Report
 /* i.e. given valid refLineNo within t_reference, it binds the related resolvedName */
 extern int bindReferences(TRDTFile* container, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
 
+/* Binds the references of the record types selected by tableMask (TABLE_xxx bits); */
+/* the record types they refer to must have been decoded */
+extern int bindReferencesTables(TRDTFile* container, unsigned tableMask, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
 #endif
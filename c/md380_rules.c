@@ -0,0 +1,266 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_rules.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+/* DigitalContact.CallType value for group calls */
+#define CALL_TYPE_GROUP 1
+
+/* Indexes shared by the rules */
+typedef struct {
+	const TRDTFile* container;
+	const ReferenceEdge* edges;
+	unsigned noOfEdges;
+	const MD380_RuleLimits* limits;
+	
+	/* Number of references to each record of each referenced type, */
+	/* NULL for the types not referenced, and the key of the type */
+	unsigned* referenceCounts [NO_OF_RECORDS_TRDTFile];
+	unsigned keyFields [NO_OF_RECORDS_TRDTFile];
+	
+	ReportErrorFunc reportErrorFunc;
+	void* reportErrorParam;
+} RuleContext;
+
+typedef int (*RuleFunc) (const RuleContext* ctx);
+
+/*=========================================================================
+	RULE: two channels with the same frequencies, tones, color code
+	and slot
+=========================================================================*/
+static unsigned channelHash (const T_ChannelInformation* ch)
+{
+	/* FNV-1a over the compared settings */
+	t_numeric values [7];
+	unsigned hash = 2166136261u;
+	unsigned i;
+	values[0] = ch->ChannelMode;
+	values[1] = ch->RxFrequency;
+	values[2] = ch->TxFrequency;
+	values[3] = ch->CtcssDcsDecode;
+	values[4] = ch->CtcssDcsEncode;
+	values[5] = ch->Colorcode;
+	values[6] = ch->RepeaterSlot;
+	for (i=0; i<7; i++) {
+		hash = (hash ^ (unsigned)values[i]) * 16777619u;
+	}
+	return hash;
+}
+
+static int sameChannel (const T_ChannelInformation* a, const T_ChannelInformation* b)
+{
+	return a->ChannelMode == b->ChannelMode && a->RxFrequency == b->RxFrequency && a->TxFrequency == b->TxFrequency &&
+		a->CtcssDcsDecode == b->CtcssDcsDecode && a->CtcssDcsEncode == b->CtcssDcsEncode &&
+		a->Colorcode == b->Colorcode && a->RepeaterSlot == b->RepeaterSlot;
+}
+
+static int ruleDuplicateChannels (const RuleContext* ctx)
+{
+	const TRDTFile* container = ctx->container;
+	unsigned count = container->ChannelInformation_COUNT;
+	unsigned size = 16;
+	unsigned* slots;
+	int noOfViolations = 0;
+	unsigned i;
+
+	/* Open addressing, at most half full; slots hold line numbers */
+	while (size < count*2) size *= 2;
+	slots = (unsigned*)binAlloc (size*sizeof (unsigned));
+	if (slots == NULL) return CSVRET_OUT_OF_MEMORY;
+	memset (slots, 0, size*sizeof (unsigned));
+	for (i=0; i<count; i++) {
+		const T_ChannelInformation* ch = container->ChannelInformation+i;
+		unsigned k = channelHash (ch) & (size-1);
+		while (slots[k] != 0 && !sameChannel (container->ChannelInformation+slots[k]-1, ch)) {
+			k = (k+1) & (size-1);
+		}
+		if (slots[k] == 0) {
+			slots[k] = i+1;
+		}
+		else {
+			char buf [80];
+			sprintf (buf, "same frequencies, tones, color code and slot as line %u", slots[k]);
+			ctx->reportErrorFunc (ctx->reportErrorParam, "ChannelInformation", i, "RxFrequency", buf);
+			noOfViolations++;
+		}
+	}
+	binFree (slots);
+	return noOfViolations;
+}
+
+/*=========================================================================
+	RULE: lists (zones, scan lists, RX group lists) empty or longer
+	than the limits
+=========================================================================*/
+static int ruleListSizes (const RuleContext* ctx)
+{
+	int noOfViolations = 0;
+	unsigned e, i, j;
+	for (e=0; e<ctx->noOfEdges; e++) {
+		const ReferenceEdge* edge = ctx->edges+e;
+		const RecordDescriptor* source = RECORDS_TRDTFile+edge->sourceTable;
+		const FieldDescriptor* fd = source->fieldDescriptors+edge->sourceField;
+		const FieldLayout* fl = source->fieldLayouts+edge->sourceField;
+		unsigned count = md380_RecordCount (source, ctx->container);
+		unsigned targetCount = md380_RecordCount (RECORDS_TRDTFile+edge->targetTable, ctx->container);
+		unsigned limit = 0;
+		if (edge->arity <= 1) continue;
+		if ((1u << edge->sourceTable) == TABLE_ZoneInformation) limit = ctx->limits->maxZoneChannels;
+		if ((1u << edge->sourceTable) == TABLE_ScanList) limit = ctx->limits->maxScanChannels;
+		if ((1u << edge->sourceTable) == TABLE_DigitalRxGroupList) limit = ctx->limits->maxGroupContacts;
+		for (i=0; i<count; i++) {
+			const unsigned char* record = (const unsigned char*)ctx->container+source->containerOffset+i*source->recordSize;
+			unsigned members = 0;
+			for (j=0; j<edge->arity; j++) {
+				const t_reference* ref = (const t_reference*)(record+fl[j].structOffset);
+				if (ref->refLineNo > 0 && ref->refLineNo <= targetCount && !md380_IsEnumReference (fd, ref)) members++;
+			}
+			if (members == 0) {
+				ctx->reportErrorFunc (ctx->reportErrorParam, source->recordName, i, edge->fieldName, "empty list");
+				noOfViolations++;
+			}
+			else if (limit > 0 && members > limit) {
+				char buf [80];
+				sprintf (buf, "%u members, more than %u", members, limit);
+				ctx->reportErrorFunc (ctx->reportErrorParam, source->recordName, i, edge->fieldName, buf);
+				noOfViolations++;
+			}
+		}
+	}
+	return noOfViolations;
+}
+
+/*=========================================================================
+	RULE: RX group lists must list group call contacts only
+=========================================================================*/
+static int ruleGroupListCallTypes (const RuleContext* ctx)
+{
+	const TRDTFile* container = ctx->container;
+	int noOfViolations = 0;
+	unsigned i, j;
+	for (i=0; i<container->DigitalRxGroupList_COUNT; i++) {
+		for (j=0; j<sizeof (container->DigitalRxGroupList[i].ContactMember)/sizeof (t_reference); j++) {
+			const t_reference* ref = container->DigitalRxGroupList[i].ContactMember+j;
+			if (ref->refLineNo == 0 || ref->refLineNo > container->DigitalContact_COUNT) continue;
+			if (container->DigitalContact[ref->refLineNo-1].CallType != CALL_TYPE_GROUP) {
+				char buf [80];
+				sprintf (buf, "contact %u is not a group call", (unsigned)container->DigitalContact[ref->refLineNo-1].CallId);
+				ctx->reportErrorFunc (ctx->reportErrorParam, "DigitalRxGroupList", i, "ContactMember", buf);
+				noOfViolations++;
+			}
+		}
+	}
+	return noOfViolations;
+}
+
+/*=========================================================================
+	RULE: records of referenced types that nothing refers to
+=========================================================================*/
+static int ruleUnusedRecords (const RuleContext* ctx)
+{
+	int noOfViolations = 0;
+	unsigned t, i;
+	for (t=0; t<NO_OF_RECORDS_TRDTFile; t++) {
+		const RecordDescriptor* rd = RECORDS_TRDTFile+t;
+		unsigned count = md380_RecordCount (rd, ctx->container);
+		if (ctx->referenceCounts[t] == NULL) continue;
+		for (i=0; i<count; i++) {
+			if (ctx->referenceCounts[t][i] == 0) {
+				ctx->reportErrorFunc (ctx->reportErrorParam, rd->recordName, i, rd->fieldDescriptors[ctx->keyFields[t]].fieldName, "not used by any other record");
+				noOfViolations++;
+			}
+		}
+	}
+	return noOfViolations;
+}
+
+static const RuleFunc RULES [] = {
+	ruleDuplicateChannels,
+	ruleListSizes,
+	ruleGroupListCallTypes,
+	ruleUnusedRecords
+};
+
+/* Initialize with the default limits */
+void INIT_MD380_RuleLimits (MD380_RuleLimits* limits)
+{
+	limits->maxZoneChannels = 0;
+	limits->maxScanChannels = 0;
+	limits->maxGroupContacts = 0;
+}
+
+/*=========================================================================
+	Runs all the rules
+=========================================================================*/
+int md380_CheckRules (const TRDTFile* container, const ReferenceEdge* edges, unsigned noOfEdges, const MD380_RuleLimits* limits, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+{
+	MD380_RuleLimits defaultLimits;
+	RuleContext ctx;
+	int noOfViolations = 0;
+	unsigned e, i, j;
+
+	INIT_MD380_RuleLimits (&defaultLimits);
+	memset (&ctx, 0, sizeof (ctx));
+	ctx.container = container;
+	ctx.edges = edges;
+	ctx.noOfEdges = noOfEdges;
+	ctx.limits = (limits ? limits : &defaultLimits);
+	ctx.reportErrorFunc = reportErrorFunc;
+	ctx.reportErrorParam = reportErrorParam;
+
+	/* Count the references to each record */
+	for (e=0; e<noOfEdges; e++) {
+		const ReferenceEdge* edge = edges+e;
+		const RecordDescriptor* source = RECORDS_TRDTFile+edge->sourceTable;
+		const RecordDescriptor* target = RECORDS_TRDTFile+edge->targetTable;
+		const FieldDescriptor* fd = source->fieldDescriptors+edge->sourceField;
+		const FieldLayout* fl = source->fieldLayouts+edge->sourceField;
+		unsigned count = md380_RecordCount (source, container);
+		unsigned targetCount = md380_RecordCount (target, container);
+		unsigned* counts = ctx.referenceCounts[edge->targetTable];
+		if (counts == NULL) {
+			counts = ctx.referenceCounts[edge->targetTable] = (unsigned*)binAlloc (target->maxCount*sizeof (unsigned));
+			if (counts == NULL) {noOfViolations = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+			memset (counts, 0, target->maxCount*sizeof (unsigned));
+			ctx.keyFields[edge->targetTable] = edge->targetKeyField;
+		}
+		for (i=0; i<count; i++) {
+			const unsigned char* record = (const unsigned char*)container+source->containerOffset+i*source->recordSize;
+			for (j=0; j<edge->arity; j++) {
+				const t_reference* ref = (const t_reference*)(record+fl[j].structOffset);
+				if (ref->refLineNo == 0 || ref->refLineNo > targetCount || md380_IsEnumReference (fd, ref)) continue;
+				counts[ref->refLineNo-1]++;
+			}
+		}
+	}
+
+	for (i=0; i<sizeof (RULES)/sizeof (RULES[0]); i++) {
+		int ret = RULES[i] (&ctx);
+		if (ret < 0) {noOfViolations = ret; goto exitFunc;}
+		noOfViolations += ret;
+	}
+
+exitFunc:
+	for (i=0; i<NO_OF_RECORDS_TRDTFile; i++) {
+		if (ctx.referenceCounts[i]) binFree (ctx.referenceCounts[i]);
+	}
+	return noOfViolations;
+}
@@ -0,0 +1,66 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_RULES_H
+#define __MD380_RULES_H
+#include "md380.h"
+#include "md380_tools.h"
+#include "md380_refgraph.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Cross-record rules.
+	
+	Unlike validateContainer, which checks each record by itself, these
+	rules look at the codeplug as a whole: duplicate channels, lists too
+	long or empty, RX group lists with non group contacts, records that
+	nothing refers to. The indexes they need (reference counts per
+	record, a hash of the channel settings) are built once, so every
+	rule runs in linear time.
+	
+	The rules describe suspicious codeplugs, not invalid ones: they are
+	not run by -e or -u, only by -check.
+=========================================================================*/
+
+/* Use INIT_MD380_RuleLimits */
+typedef struct {
+	/* Maximum number of members of a list before it is reported; */
+	/* 0 disables the check */
+	unsigned maxZoneChannels;
+	unsigned maxScanChannels;
+	unsigned maxGroupContacts;
+} MD380_RuleLimits;
+
+/* Initialize with the default limits: no check */
+extern void INIT_MD380_RuleLimits (MD380_RuleLimits* limits);
+
+/*=========================================================================
+	Runs all the rules on a bound or resolved container, whose
+	references are described by 'edges' (normally
+	REFERENCE_EDGES_TRDTFile). 'limits' may be NULL for the defaults.
+	Returns the number of violations reported, or CSVRET_OUT_OF_MEMORY.
+=========================================================================*/
+extern int md380_CheckRules (const TRDTFile* container, const ReferenceEdge* edges, unsigned noOfEdges, const MD380_RuleLimits* limits, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -0,0 +1,466 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_server.h"
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#ifdef _WIN32
+/*=========================================================================
+	No Unix domain sockets: not available
+=========================================================================*/
+int md380_RunServer (const char* socketName, unsigned noOfWorkers, FILE* log, char** errorMessage)
+{
+	(*errorMessage) = (char*)binAlloc (64);
+	if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
+	strcpy ((*errorMessage), "Server mode not available on this platform");
+	return MD380ERR_FILE_ERROR;
+}
+#else
+#include <errno.h>
+#include <stdint.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <arpa/inet.h>
+
+/* Connections accepted and not yet taken by a worker */
+#define SERVER_QUEUE_SIZE 64
+
+/* A worker waiting for a client checks every SERVER_POLL_MS whether the */
+/* server is stopping, and closes the connection if it has been silent */
+/* for SERVER_IDLE_MS while other connections are waiting for a worker */
+#define SERVER_POLL_MS 250
+#define SERVER_IDLE_MS 2000
+
+/* Shared by the acceptor and the workers */
+typedef struct {
+	pthread_mutex_t mutex;
+	pthread_cond_t notEmpty;
+	pthread_cond_t notFull;
+	int queue [SERVER_QUEUE_SIZE];
+	unsigned head;
+	unsigned noOfQueued;
+	int stopping;
+	FILE* log;
+} ServerQueue;
+
+/* State of a worker, allocated once and reused for every job */
+typedef struct {
+	ServerQueue* queue;
+	pthread_t thread;
+	MD380_Converter converter;
+	MD380_MemBuffer request;
+	MD380_MemBuffer response;
+	const char* csvData [NO_OF_CSV_STREAMS];
+	unsigned csvLength [NO_OF_CSV_STREAMS];
+} ServerWorker;
+
+static volatile sig_atomic_t md380_ServerStop = 0;
+
+/*=========================================================================
+	Signal handler: makes accept return with EINTR. The workers block
+	the signals, so that they are delivered to the accepting thread.
+=========================================================================*/
+static void md380_ServerSignal (int sig)
+{
+	md380_ServerStop = 1;
+}
+
+/*=========================================================================
+	True if a worker whose client has been silent for 'waited'
+	milliseconds has to close the connection
+=========================================================================*/
+static int md380_ServerYield (ServerQueue* q, unsigned waited)
+{
+	int yield;
+	pthread_mutex_lock (&q->mutex);
+	yield = (q->stopping || (waited >= SERVER_IDLE_MS && q->noOfQueued > 0));
+	pthread_mutex_unlock (&q->mutex);
+	return yield;
+}
+
+/*=========================================================================
+	Reads exactly 'length' octets; the socket has a receive timeout
+	of SERVER_POLL_MS.
+	Returns 0=ok  1=end of connection, error or connection to be closed
+=========================================================================*/
+static int md380_ServerRead (ServerWorker* w, int fd, void* buffer, unsigned length)
+{
+	char* p = (char*)buffer;
+	unsigned waited = 0;
+	while (length > 0) {
+		ssize_t n = read (fd, p, length);
+		if (n < 0 && errno == EINTR) continue;
+		if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+			waited += SERVER_POLL_MS;
+			if (md380_ServerYield (w->queue, waited)) return 1;
+			continue;
+		}
+		if (n <= 0) return 1;
+		p += n;
+		length -= (unsigned)n;
+		waited = 0;
+	}
+	return 0;
+}
+
+/*=========================================================================
+	Writes exactly 'length' octets.
+	Returns 0=ok  1=error
+=========================================================================*/
+static int md380_ServerWrite (int fd, const void* buffer, unsigned length)
+{
+	const char* p = (const char*)buffer;
+	while (length > 0) {
+		ssize_t n = write (fd, p, length);
+		if (n < 0 && errno == EINTR) continue;
+		if (n <= 0) return 1;
+		p += n;
+		length -= (unsigned)n;
+	}
+	return 0;
+}
+
+/*=========================================================================
+	Reads a number. Returns 0=ok  1=end of connection or error
+=========================================================================*/
+static int md380_ServerReadNumber (ServerWorker* w, int fd, unsigned* value)
+{
+	uint32_t n;
+	if (md380_ServerRead (w, fd, &n, sizeof (n))) return 1;
+	(*value) = ntohl (n);
+	return 0;
+}
+
+/*=========================================================================
+	Appends a number and a block to the response.
+	Return 0=ok  1=out of memory, as md380_MemWriteBinaryFunc
+=========================================================================*/
+static int md380_ServerPutNumber (MD380_MemBuffer* b, unsigned value)
+{
+	uint32_t n = htonl (value);
+	return md380_MemWriteBinaryFunc (b, (const char*)&n, sizeof (n));
+}
+
+static int md380_ServerPutBlock (MD380_MemBuffer* b, const char* data, unsigned length)
+{
+	if (md380_ServerPutNumber (b, length)) return 1;
+	return md380_MemWriteBinaryFunc (b, data, length);
+}
+
+/*=========================================================================
+	Reads the request of a job in w->request: every block is appended
+	to it and the CSV blocks are pointed by w->csvData once complete.
+	Returns 0=ok  1=end of connection or error
+=========================================================================*/
+static int md380_ServerReadRequest (ServerWorker* w, int fd, unsigned* job, char* separator, unsigned* tableMask, unsigned* imageLength)
+{
+	unsigned csvOffset [NO_OF_CSV_STREAMS];
+	unsigned value, i;
+	
+	if (md380_ServerReadNumber (w, fd, job)) return 1;
+	if (md380_ServerReadNumber (w, fd, &value)) return 1;
+	(*separator) = (char)value;
+	if (md380_ServerReadNumber (w, fd, tableMask)) return 1;
+	(*tableMask) &= TABLES_ALL_TRDTFile;
+	
+	/* The image first, then the CSV of the update */
+	w->request.length = 0;
+	for (i=0; i<=NO_OF_CSV_STREAMS; i++) {
+		unsigned length;
+		if (i > 0) {
+			w->csvData[i-1] = NULL;
+			w->csvLength[i-1] = 0;
+			if ((*job) != MD380_JOB_UPDATE || ((*tableMask) & (1u << (i-1))) == 0) continue;
+			csvOffset[i-1] = w->request.length;
+		}
+		if (md380_ServerReadNumber (w, fd, &length)) return 1;
+		if (length > MD380_SERVER_MAX_BLOCK) return 1;
+		if (md380_ReserveMemBuffer (&w->request, w->request.length+length)) return 1;
+		if (md380_ServerRead (w, fd, w->request.data+w->request.length, length)) return 1;
+		w->request.length += length;
+		if (i == 0) (*imageLength) = length;
+		else w->csvLength[i-1] = length;
+	}
+	
+	/* The buffer does not move anymore */
+	for (i=0; i<NO_OF_CSV_STREAMS; i++) {
+		if ((*job) == MD380_JOB_UPDATE && ((*tableMask) & (1u << i))) {
+			w->csvData[i] = w->request.data+csvOffset[i];
+		}
+	}
+	return 0;
+}
+
+/*=========================================================================
+	Runs a job and builds its response in w->response
+	Returns 0=ok  1=out of memory
+=========================================================================*/
+static int md380_ServerRunJob (ServerWorker* w, unsigned job, char separator, unsigned tableMask, unsigned imageLength)
+{
+	MD380_Converter* c = &w->converter;
+	MD380_MemBuffer* b = &w->response;
+	char* errorMessage = NULL;
+	char* text = NULL;
+	int ret;
+	unsigned i;
+	
+	ret = md380_LoadImage (c, w->request.data, imageLength, &errorMessage);
+	if (ret == CSVRET_OK) {
+		switch (job) {
+			case MD380_JOB_EXPORT: ret = md380_ExportCSV (c, tableMask, separator, &errorMessage); break;
+			case MD380_JOB_UPDATE: ret = md380_UpdateFromCSV (c, w->csvData, w->csvLength, separator, &errorMessage); break;
+			case MD380_JOB_VALIDATE: break;
+			default: ret = MD380ERR_INVALID_VALUE;
+		}
+	}
+	
+	/* Status, error and violations */
+	b->length = 0;
+	if (md380_ServerPutNumber (b, (unsigned)ret)) goto outOfMemory;
+	if (md380_ServerPutBlock (b, errorMessage, (errorMessage ? (unsigned)strlen (errorMessage) : 0))) goto outOfMemory;
+	if (md380_ServerPutNumber (b, c->diagnostics.noOfItems)) goto outOfMemory;
+	for (i=0; i<c->diagnostics.noOfItems; i++) {
+		const MD380_Diagnostic* d = c->diagnostics.items+i;
+		unsigned length;
+		text = (char*)binAlloc (strlen (d->recordType)+strlen (d->fieldName)+strlen (d->text)+64);
+		if (text == NULL) goto outOfMemory;
+		length = (unsigned)sprintf (text, "Record %s, ", d->recordType);
+		if (d->recordNumber >= 0) {
+			length += (unsigned)sprintf (text+length, "line %d, ", (int)(d->recordNumber+1));
+		}
+		length += (unsigned)sprintf (text+length, "field %s, violation: %s", d->fieldName, d->text);
+		if (md380_ServerPutBlock (b, text, length)) goto outOfMemory;
+		binFree (text);
+		text = NULL;
+	}
+	
+	/* Payload */
+	if (ret == CSVRET_OK && job == MD380_JOB_EXPORT) {
+		if (md380_ServerPutNumber (b, tableMask)) goto outOfMemory;
+		for (i=0; i<NO_OF_CSV_STREAMS; i++) {
+			if ((tableMask & (1u << i)) == 0) continue;
+			if (md380_ServerPutBlock (b, c->csv[i].data, c->csv[i].length)) goto outOfMemory;
+		}
+	}
+	else if (ret == CSVRET_OK && job == MD380_JOB_UPDATE) {
+		if (md380_ServerPutBlock (b, (const char*)c->image+c->offset, c->length)) goto outOfMemory;
+	}
+	if (errorMessage) binFree (errorMessage);
+	return 0;
+
+outOfMemory:
+	if (errorMessage) binFree (errorMessage);
+	if (text) binFree (text);
+	return 1;
+}
+
+/*=========================================================================
+	Serves the jobs of a connection until it is closed, the server
+	stops or it yields the worker (see SERVER_IDLE_MS)
+=========================================================================*/
+static void md380_ServeConnection (ServerWorker* w, int fd)
+{
+	unsigned job, tableMask, imageLength;
+	char separator;
+	struct timeval tv;
+	
+	tv.tv_sec = 0;
+	tv.tv_usec = SERVER_POLL_MS*1000;
+	setsockopt (fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof (tv));
+	while (md380_ServerReadRequest (w, fd, &job, &separator, &tableMask, &imageLength) == 0) {
+		if (md380_ServerRunJob (w, job, separator, tableMask, imageLength)) {
+			fprintf (w->queue->log, "Error allocating the response (out of memory?)\n");
+			break;
+		}
+		if (md380_ServerWrite (fd, w->response.data, w->response.length)) break;
+	}
+	close (fd);
+}
+
+/*=========================================================================
+	Worker thread
+=========================================================================*/
+static void* md380_ServerWorkerThread (void* param)
+{
+	ServerWorker* w = (ServerWorker*)param;
+	ServerQueue* q = w->queue;
+	
+	for (;;) {
+		int fd;
+		pthread_mutex_lock (&q->mutex);
+		while (q->noOfQueued == 0 && !q->stopping) pthread_cond_wait (&q->notEmpty, &q->mutex);
+		if (q->noOfQueued == 0) {
+			pthread_mutex_unlock (&q->mutex);
+			break;
+		}
+		fd = q->queue[q->head];
+		q->head = (q->head+1) % SERVER_QUEUE_SIZE;
+		q->noOfQueued--;
+		pthread_cond_signal (&q->notFull);
+		pthread_mutex_unlock (&q->mutex);
+		
+		md380_ServeConnection (w, fd);
+	}
+	return NULL;
+}
+
+/*=========================================================================
+	Allocates an error message about the server
+=========================================================================*/
+static int md380_ServerError (char** errorMessage, const char* socketName, const char* text, int ret)
+{
+	(*errorMessage) = (char*)binAlloc (strlen (socketName)+strlen (text)+64);
+	if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
+	sprintf ((*errorMessage), "Server '%s': %s", socketName, text);
+	return ret;
+}
+
+/*=========================================================================
+	Runs the server
+=========================================================================*/
+int md380_RunServer (const char* socketName, unsigned noOfWorkers, FILE* log, char** errorMessage)
+{
+	ServerQueue q;
+	ServerWorker* workers = NULL;
+	unsigned noOfStarted = 0;
+	struct sockaddr_un addr;
+	struct sigaction sa;
+	sigset_t blocked, previous;
+	int listenFd = -1;
+	int ret = CSVRET_OK;
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	if (noOfWorkers == 0) noOfWorkers = MD380_SERVER_DEFAULT_WORKERS;
+	if (strlen (socketName) >= sizeof (addr.sun_path)) {
+		return md380_ServerError (errorMessage, socketName, "socket name too long", MD380ERR_FILE_ERROR);
+	}
+	
+	memset (&q, 0, sizeof (q));
+	q.log = log;
+	pthread_mutex_init (&q.mutex, NULL);
+	pthread_cond_init (&q.notEmpty, NULL);
+	pthread_cond_init (&q.notFull, NULL);
+	
+	/* Prepare the workers before accepting anything */
+	workers = (ServerWorker*)binAlloc (noOfWorkers*sizeof (ServerWorker));
+	if (workers == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+	for (i=0; i<noOfWorkers; i++) {
+		memset (workers+i, 0, sizeof (ServerWorker));
+		workers[i].queue = &q;
+		INIT_MD380_Converter (&workers[i].converter);
+		INIT_MD380_MemBuffer (&workers[i].request);
+		INIT_MD380_MemBuffer (&workers[i].response);
+	}
+	for (i=0; i<noOfWorkers; i++) {
+		if (md380_AllocConverter (&workers[i].converter) != CSVRET_OK) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+	}
+	
+	/* Create the socket, replacing a stale one */
+	listenFd = socket (AF_UNIX, SOCK_STREAM, 0);
+	if (listenFd < 0) {
+		ret = md380_ServerError (errorMessage, socketName, strerror (errno), MD380ERR_FILE_ERROR);
+		goto exitFunc;
+	}
+	memset (&addr, 0, sizeof (addr));
+	addr.sun_family = AF_UNIX;
+	strcpy (addr.sun_path, socketName);
+	unlink (socketName);
+	if (bind (listenFd, (struct sockaddr*)&addr, sizeof (addr)) || listen (listenFd, SERVER_QUEUE_SIZE)) {
+		ret = md380_ServerError (errorMessage, socketName, strerror (errno), MD380ERR_FILE_ERROR);
+		goto exitFunc;
+	}
+	
+	/* SIGINT and SIGTERM interrupt accept; a client going away */
+	/* must not kill the server */
+	md380_ServerStop = 0;
+	memset (&sa, 0, sizeof (sa));
+	sa.sa_handler = md380_ServerSignal;
+	sigemptyset (&sa.sa_mask);
+	sigaction (SIGINT, &sa, NULL);
+	sigaction (SIGTERM, &sa, NULL);
+	signal (SIGPIPE, SIG_IGN);
+	
+	/* The workers inherit the signals blocked */
+	sigemptyset (&blocked);
+	sigaddset (&blocked, SIGINT);
+	sigaddset (&blocked, SIGTERM);
+	pthread_sigmask (SIG_BLOCK, &blocked, &previous);
+	for (noOfStarted=0; noOfStarted<noOfWorkers; noOfStarted++) {
+		if (pthread_create (&workers[noOfStarted].thread, NULL, md380_ServerWorkerThread, workers+noOfStarted)) break;
+	}
+	pthread_sigmask (SIG_SETMASK, &previous, NULL);
+	if (noOfStarted < noOfWorkers) {
+		ret = md380_ServerError (errorMessage, socketName, "cannot create the worker threads", MD380ERR_FILE_ERROR);
+		goto exitFunc;
+	}
+	fprintf (log, "Serving on '%s' with %u worker(s)\n", socketName, noOfWorkers);
+	
+	/* Accept the connections and queue them to the workers */
+	while (!md380_ServerStop) {
+		int fd = accept (listenFd, NULL, NULL);
+		if (fd < 0) {
+			if (errno == EINTR || errno == ECONNABORTED) continue;
+			ret = md380_ServerError (errorMessage, socketName, strerror (errno), MD380ERR_FILE_ERROR);
+			break;
+		}
+		pthread_mutex_lock (&q.mutex);
+		while (q.noOfQueued == SERVER_QUEUE_SIZE) pthread_cond_wait (&q.notFull, &q.mutex);
+		q.queue[(q.head+q.noOfQueued) % SERVER_QUEUE_SIZE] = fd;
+		q.noOfQueued++;
+		pthread_cond_signal (&q.notEmpty);
+		pthread_mutex_unlock (&q.mutex);
+	}
+	fprintf (log, "Server '%s' stopping\n", socketName);
+
+exitFunc:
+	if (listenFd >= 0) {
+		close (listenFd);
+		unlink (socketName);
+	}
+	
+	/* The workers close the connections queued or open as soon as */
+	/* they are silent, then exit */
+	pthread_mutex_lock (&q.mutex);
+	q.stopping = 1;
+	pthread_cond_broadcast (&q.notEmpty);
+	pthread_mutex_unlock (&q.mutex);
+	for (i=0; i<noOfStarted; i++) pthread_join (workers[i].thread, NULL);
+	
+	if (workers) {
+		for (i=0; i<noOfWorkers; i++) {
+			FREE_MD380_Converter (&workers[i].converter);
+			FREE_MD380_MemBuffer (&workers[i].request);
+			FREE_MD380_MemBuffer (&workers[i].response);
+		}
+		binFree (workers);
+	}
+	pthread_cond_destroy (&q.notFull);
+	pthread_cond_destroy (&q.notEmpty);
+	pthread_mutex_destroy (&q.mutex);
+	return ret;
+}
+#endif
@@ -0,0 +1,92 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_SERVER_H
+#define __MD380_SERVER_H
+#include <stdio.h>
+#include "md380_lib.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Conversion server.
+	
+	The server listens on a Unix domain socket and runs the jobs of
+	md380_lib for its clients, with a fixed pool of worker threads.
+	Each worker owns a MD380_Converter allocated at startup and reused
+	for every job, so that a job costs no process start, no file and
+	almost no allocation. A connection is served by one worker from
+	the first to the last job; a client can send any number of jobs
+	on it, one after the other. A connection silent for two seconds
+	is closed if other connections are waiting for a worker, so that
+	idle clients cannot hold the whole pool.
+	
+	Every number is a 32 bit unsigned integer in network byte order,
+	and a block is a number with the length followed by that many
+	octets. A request is:
+	
+	    job        MD380_JOB_xxx
+	    separator  CSV separator, e.g. 44 for ','
+	    tableMask  TABLE_xxx bits: the tables to be exported or the
+	               tables whose CSV follows the image
+	    image      block with the .rdt or .bin file
+	    csv...     MD380_JOB_UPDATE only: one block per table in
+	               tableMask, in the order of csvStreamFuncs
+	
+	The response is:
+	
+	    status     CSVRET_xxx or MD380ERR_xxx, as a two's complement
+	    error      block with the error message, empty if none
+	    count      number of the rules violations that follow
+	    text...    one block per violation, as printed by the tool
+	
+	followed, if the status is CSVRET_OK, by:
+	
+	    MD380_JOB_EXPORT    tableMask and a CSV block per table in it
+	    MD380_JOB_UPDATE    block with the updated .rdt or .bin file
+	    MD380_JOB_VALIDATE  nothing
+=========================================================================*/
+#define MD380_JOB_EXPORT    1
+#define MD380_JOB_UPDATE    2
+#define MD380_JOB_VALIDATE  3
+
+/* Largest block accepted in a request */
+#define MD380_SERVER_MAX_BLOCK  (16u*1024u*1024u)
+
+/* Number of workers when not given */
+#define MD380_SERVER_DEFAULT_WORKERS 4
+#define MD380_SERVER_MAX_WORKERS 64
+
+/*=========================================================================
+	Listens on 'socketName' and serves the clients with 'noOfWorkers'
+	threads until SIGINT or SIGTERM; then the connections still open
+	or queued are closed as soon as they are silent. Errors and the
+	end of the service are printed on 'log'.
+	Returns CSVRET_OK, CSVRET_OUT_OF_MEMORY or MD380ERR_FILE_ERROR if
+	the socket or the threads could not be created. The 'errorMessage'
+	string is allocated with binAlloc in case of error and it is to be
+	freed with binFree.
+=========================================================================*/
+extern int md380_RunServer (const char* socketName, unsigned noOfWorkers, FILE* log, char** errorMessage);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
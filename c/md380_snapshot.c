@@ -0,0 +1,257 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_snapshot.h"
+#include "version.h"
+#include "md380_resolve.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <assert.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define SNAPSHOT_HASH_PRIME  0x9E3779B97F4A7C15ull
+#define SNAPSHOT_HASH_SEED   0xCBF29CE484222325ull
+
+/*=========================================================================
+	Initialize and free
+=========================================================================*/
+void INIT_MD380_Snapshot (MD380_Snapshot* snapshot)
+{
+	memset (snapshot, 0, sizeof (*snapshot));
+}
+
+void FREE_MD380_Snapshot (MD380_Snapshot* snapshot)
+{
+	if (snapshot->data) {
+#ifndef _WIN32
+		if (snapshot->mapped) munmap (snapshot->data, snapshot->size);
+		else
+#endif
+		binFree (snapshot->data);
+	}
+	INIT_MD380_Snapshot (snapshot);
+}
+
+/*=========================================================================
+	Hash: 8 octets at a time, each one mixed by a multiplication and a
+	rotation; it is not cryptographic, the snapshot keeps the image
+	to be compared
+=========================================================================*/
+uint64_t md380_HashImage (const void* data, unsigned length)
+{
+	const unsigned char* p = (const unsigned char*)data;
+	uint64_t h = SNAPSHOT_HASH_SEED ^ length;
+	uint64_t v;
+	
+	for (; length >= 8; length -= 8, p += 8) {
+		memcpy (&v, p, 8);
+		h = (h ^ v) * SNAPSHOT_HASH_PRIME;
+		h = (h << 31) | (h >> 33);
+	}
+	for (; length > 0; length--, p++) {
+		h = (h ^ (*p)) * SNAPSHOT_HASH_PRIME;
+	}
+	h ^= h >> 29;
+	h *= SNAPSHOT_HASH_PRIME;
+	h ^= h >> 32;
+	return h;
+}
+
+/*=========================================================================
+	Moves the resolvedName pointers of the references of 'container'
+	from the container at address 'from' to the one at address 'to'
+=========================================================================*/
+static void md380_RelocateNames (TRDTFile* container, uintptr_t from, uintptr_t to)
+{
+	unsigned e, i, j;
+	
+	for (e=0; e<NO_OF_REFERENCE_EDGES_TRDTFile; e++) {
+		const ReferenceEdge* edge = REFERENCE_EDGES_TRDTFile+e;
+		const RecordDescriptor* source = RECORDS_TRDTFile+edge->sourceTable;
+		unsigned noOfRecs = md380_RecordCount (source, container);
+		for (i=0; i<noOfRecs; i++) {
+			unsigned char* record = (unsigned char*)container+source->containerOffset+i*source->recordSize;
+			for (j=0; j<edge->arity; j++) {
+				t_reference* ref = (t_reference*)(record+source->fieldLayouts[edge->sourceField+j].structOffset);
+				if (ref->resolvedName == NULL) continue;
+				assert ((uintptr_t)ref->resolvedName-from < sizeof (TRDTFile));
+				ref->resolvedName = (const t_unicode*)((uintptr_t)ref->resolvedName-from+to);
+			}
+		}
+	}
+}
+
+/*=========================================================================
+	Allocates the name of the snapshot of an image
+=========================================================================*/
+static char* md380_SnapshotFileName (const char* cacheDir, const t_buffer* image, unsigned offset, unsigned length)
+{
+	uint64_t h = md380_HashImage (image+offset, length);
+	char* name = (char*)binAlloc (strlen (cacheDir)+64);
+	if (name == NULL) return NULL;
+	sprintf (name, "%s/%08lx%08lx%s", cacheDir, (unsigned long)(h >> 32), (unsigned long)(h & 0xFFFFFFFFu), MD380_SNAPSHOT_EXTENSION);
+	return name;
+}
+
+/*=========================================================================
+	Fills the header of a snapshot for this build
+=========================================================================*/
+static void md380_SnapshotHeader (MD380_SnapshotHeader* header, unsigned offset, unsigned length)
+{
+	memset (header, 0, sizeof (*header));
+	memcpy (header->signature, MD380_SNAPSHOT_SIGNATURE, sizeof (header->signature));
+	header->release = SUBVERSION_RELEASE_N;
+	header->containerSize = (unsigned)sizeof (TRDTFile);
+	header->referenceSize = (unsigned)sizeof (t_reference);
+	header->imageOffset = offset;
+	header->imageLength = length;
+	header->containerOffset = (unsigned)((sizeof (MD380_SnapshotHeader)+length+MD380_SNAPSHOT_ALIGN-1) / MD380_SNAPSHOT_ALIGN * MD380_SNAPSHOT_ALIGN);
+	header->base = MD380_SNAPSHOT_BASE;
+}
+
+/*=========================================================================
+	Maps the snapshot of an image, if any
+=========================================================================*/
+int md380_LoadSnapshot (const char* cacheDir, const t_buffer* image, unsigned offset, unsigned length, MD380_Snapshot* snapshot)
+{
+	MD380_SnapshotHeader expected;
+	char* fileName;
+	
+	assert (snapshot->data == NULL);
+	fileName = md380_SnapshotFileName (cacheDir, image, offset, length);
+	if (fileName == NULL) return CSVRET_OUT_OF_MEMORY;
+	md380_SnapshotHeader (&expected, offset, length);
+	
+#ifndef _WIN32
+	{
+		struct stat st;
+		int fd = open (fileName, O_RDONLY);
+		if (fd >= 0 && fstat (fd, &st) == 0 && (size_t)st.st_size == expected.containerOffset+sizeof (TRDTFile)) {
+			void* data = mmap ((void*)MD380_SNAPSHOT_BASE, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data != MAP_FAILED) {
+				snapshot->data = data;
+				snapshot->size = (size_t)st.st_size;
+				snapshot->mapped = 1;
+			}
+		}
+		if (fd >= 0) close (fd);
+	}
+#else
+	{
+		FILE* f = fopen (fileName, "rb");
+		size_t size = expected.containerOffset+sizeof (TRDTFile);
+		if (f) {
+			snapshot->data = binAlloc (size);
+			if (snapshot->data == NULL) {fclose (f); binFree (fileName); return CSVRET_OUT_OF_MEMORY;}
+			snapshot->size = size;
+			if (fread (snapshot->data, 1, size, f) != size || fgetc (f) != EOF) FREE_MD380_Snapshot (snapshot);
+			fclose (f);
+		}
+	}
+#endif
+	binFree (fileName);
+	if (snapshot->data == NULL) return CSVRET_OK;
+	
+	/* Same build and same image, not just the same hash */
+	if (memcmp (snapshot->data, &expected, sizeof (expected)) != 0 || memcmp ((const char*)snapshot->data+sizeof (expected), image+offset, length) != 0) {
+		FREE_MD380_Snapshot (snapshot);
+		return CSVRET_OK;
+	}
+	
+	/* Not at the base address: move the pointers. The pages are private, */
+	/* so the file is not changed */
+	if ((uintptr_t)snapshot->data != MD380_SNAPSHOT_BASE) {
+		TRDTFile* container = (TRDTFile*)((char*)snapshot->data+expected.containerOffset);
+#ifndef _WIN32
+		if (mprotect (snapshot->data, snapshot->size, PROT_READ | PROT_WRITE) != 0) {
+			FREE_MD380_Snapshot (snapshot);
+			return CSVRET_OK;
+		}
+#endif
+		md380_RelocateNames (container, MD380_SNAPSHOT_BASE+expected.containerOffset, (uintptr_t)container);
+#ifndef _WIN32
+		mprotect (snapshot->data, snapshot->size, PROT_READ);
+#endif
+	}
+	snapshot->container = (const TRDTFile*)((const char*)snapshot->data+expected.containerOffset);
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Saves the snapshot of a container
+=========================================================================*/
+int md380_SaveSnapshot (const char* cacheDir, const t_buffer* image, unsigned offset, unsigned length, const TRDTFile* container, char** errorMessage)
+{
+	static const char padding [MD380_SNAPSHOT_ALIGN] = {0};
+	MD380_SnapshotHeader header;
+	char* fileName = NULL;
+	char* tempName = NULL;
+	TRDTFile* copy = NULL;
+	FILE* f;
+	int ret = CSVRET_OK;
+	size_t padLength;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	fileName = md380_SnapshotFileName (cacheDir, image, offset, length);
+	if (fileName) tempName = (char*)binAlloc (strlen (fileName)+8);
+	if (tempName) copy = (TRDTFile*)binAlloc (sizeof (TRDTFile));
+	if (copy == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+	
+	/* Written aside and renamed, so that a snapshot is never seen half written */
+	sprintf (tempName, "%s.tmp", fileName);
+	md380_SnapshotHeader (&header, offset, length);
+	padLength = header.containerOffset-sizeof (header)-length;
+	memcpy (copy, container, sizeof (TRDTFile));
+	md380_RelocateNames (copy, (uintptr_t)container, MD380_SNAPSHOT_BASE+header.containerOffset);
+	f = fopen (tempName, "wb");
+	if (f == NULL) ret = MD380ERR_FILE_ERROR;
+	else {
+		if (fwrite (&header, sizeof (header), 1, f) != 1 ||
+			fwrite (image+offset, 1, length, f) != length ||
+			fwrite (padding, 1, padLength, f) != padLength ||
+			fwrite (copy, sizeof (TRDTFile), 1, f) != 1) ret = MD380ERR_FILE_ERROR;
+		if (fclose (f) != 0) ret = MD380ERR_FILE_ERROR;
+	}
+	if (ret == CSVRET_OK) {
+#ifdef _WIN32
+		remove (fileName);
+#endif
+		if (rename (tempName, fileName) != 0) ret = MD380ERR_FILE_ERROR;
+	}
+	if (ret != CSVRET_OK) {
+		(*errorMessage) = (char*)binAlloc (strlen (tempName)+128);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "Error saving the snapshot '%s' (%s)", fileName, strerror (errno));
+		remove (tempName);
+	}
+
+exitFunc:
+	if (fileName) binFree (fileName);
+	if (tempName) binFree (tempName);
+	if (copy) binFree (copy);
+	return ret;
+}
@@ -0,0 +1,113 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_SNAPSHOT_H
+#define __MD380_SNAPSHOT_H
+#include <stddef.h>
+#include <stdint.h>
+#include "md380.h"
+#include "md380_tools.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Snapshot cache.
+	
+	A snapshot is the decoded, validated and bound container of an
+	image, saved as it is in memory, so that it can be mapped back and
+	used in place, without any decoding, validation or binding.
+	
+	The only pointers in TRDTFile are the resolvedName of the
+	references, pointing to the names of the records inside the
+	container itself. They are saved as if the file was mapped at
+	MD380_SNAPSHOT_BASE, where the snapshot is mapped if the address
+	is free; only if it is not, the pointers are moved to where the
+	file has been mapped.
+	
+	The snapshots are kept in a directory, one file per image, named
+	after a 64 bit hash of the image bytes. The file holds a copy of
+	the image too, compared with the one being exported to rule out
+	hash collisions. A snapshot is only valid for the same build: the
+	header holds the release and the size of the structures, and a
+	snapshot of another build is ignored and replaced.
+	
+	    header    MD380_SnapshotHeader
+	    image     the 'length' octets of the image, as in the file
+	    container TRDTFile, at a multiple of MD380_SNAPSHOT_ALIGN
+=========================================================================*/
+#define MD380_SNAPSHOT_SIGNATURE   "RDT2CSV-SNAPSHOT"
+#define MD380_SNAPSHOT_EXTENSION   ".snap"
+#define MD380_SNAPSHOT_ALIGN       64
+#define MD380_SNAPSHOT_BASE        ((uintptr_t)(sizeof (void*) >= 8 ? 0x3E0000000000ull : 0x48000000ul))
+
+typedef struct {
+	char signature [16];
+	unsigned release;
+	unsigned containerSize;
+	unsigned referenceSize;
+	unsigned imageOffset;
+	unsigned imageLength;
+	unsigned containerOffset;
+	uint64_t base;
+} MD380_SnapshotHeader;
+
+/* Snapshot in use. Use INIT_MD380_Snapshot and FREE_MD380_Snapshot */
+typedef struct {
+	/* Container of the snapshot, NULL if none; it is read only */
+	const TRDTFile* container;
+	
+	/* Memory holding the whole file */
+	void* data;
+	size_t size;
+	int mapped;
+} MD380_Snapshot;
+
+/* Initialize */
+extern void INIT_MD380_Snapshot (MD380_Snapshot* snapshot);
+
+/* Free: unmaps the file */
+extern void FREE_MD380_Snapshot (MD380_Snapshot* snapshot);
+
+/*=========================================================================
+	64 bit hash of 'length' octets, used to name the snapshots
+=========================================================================*/
+extern uint64_t md380_HashImage (const void* data, unsigned length);
+
+/*=========================================================================
+	Looks in 'cacheDir' for the snapshot of the 'length' octets of
+	'image' from 'offset' (see loadRdtFile) and maps it. A missing or
+	unusable snapshot is not an error: snapshot->container is NULL.
+	Returns CSVRET_OK or CSVRET_OUT_OF_MEMORY.
+=========================================================================*/
+extern int md380_LoadSnapshot (const char* cacheDir, const t_buffer* image, unsigned offset, unsigned length, MD380_Snapshot* snapshot);
+
+/*=========================================================================
+	Saves in 'cacheDir' the snapshot of 'container', decoded from
+	'image', replacing any previous one.
+	Returns CSVRET_OK or MD380ERR_FILE_ERROR. The 'errorMessage' string
+	is allocated with binAlloc in case of error and it is to be freed
+	with binFree.
+=========================================================================*/
+extern int md380_SaveSnapshot (const char* cacheDir, const t_buffer* image, unsigned offset, unsigned length, const TRDTFile* container, char** errorMessage);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -0,0 +1,433 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_stamp.h"
+#include "version.h"
+#include "csv.h"
+#include "md380_cli.h"
+#include "md380_lib.h"
+#include "md380_stdio.h"
+#include "md380_snapshot.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <assert.h>
+#include <sys/stat.h>
+
+/* Hash of a file that cannot be read */
+#define STAMP_MISSING_FILE  0x6D697373696E6721ull
+
+/*=========================================================================
+	Initialize and free
+=========================================================================*/
+void INIT_MD380_StampDB (MD380_StampDB* db)
+{
+	memset (db, 0, sizeof (*db));
+}
+
+void FREE_MD380_StampDB (MD380_StampDB* db)
+{
+	if (db->items) binFree (db->items);
+	INIT_MD380_StampDB (db);
+}
+
+/*=========================================================================
+	Adds 'value' to the running hash 'h'
+=========================================================================*/
+static uint64_t md380_StampMix (uint64_t h, uint64_t value)
+{
+	uint64_t pair [2];
+	pair[0] = h;
+	pair[1] = value;
+	return md380_HashImage (pair, sizeof (pair));
+}
+
+/* Adds a string, terminator included, or a NULL one */
+static uint64_t md380_StampMixName (uint64_t h, const char* name)
+{
+	return md380_StampMix (h, (name ? md380_HashImage (name, (unsigned)strlen (name)+1) : 0));
+}
+
+/*=========================================================================
+	Adds the contents of a file, or STAMP_MISSING_FILE if it cannot be
+	read. Returns CSVRET_OK or CSVRET_OUT_OF_MEMORY.
+=========================================================================*/
+static int md380_StampMixFile (uint64_t* h, const char* fileName)
+{
+	struct stat st;
+	FILE* f;
+	char* data;
+	uint64_t fileHash = STAMP_MISSING_FILE;
+	
+	if (fileName == NULL) return CSVRET_OK;
+	if (stat (fileName, &st) == 0 && (f = fopen (fileName, "rb")) != NULL) {
+		data = (char*)binAlloc ((size_t)st.st_size+1);
+		if (data == NULL) {
+			fclose (f);
+			return CSVRET_OUT_OF_MEMORY;
+		}
+		if (fread (data, 1, (size_t)st.st_size, f) == (size_t)st.st_size) {
+			fileHash = md380_HashImage (data, (unsigned)st.st_size);
+		}
+		binFree (data);
+		fclose (f);
+	}
+	(*h) = md380_StampMix (*h, fileHash);
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Outputs of a job: see md380_stamp.h
+=========================================================================*/
+int md380_OutputsStamp (MD380_Configuration* config, uint64_t* outputs)
+{
+	unsigned i;
+	int ret = CSVRET_OK;
+	
+	(*outputs) = 0;
+	if (config->updateMode == modeUpdate) {
+		return md380_StampMixFile (outputs, config->rdtFileName);
+	}
+	for (i=0; i<NO_OF_CLI_COMMANDS && ret == CSVRET_OK; i++) {
+		ret = md380_StampMixFile (outputs, *PATH_CSVFileNames (&config->csvFileNames, i));
+	}
+	if (ret == CSVRET_OK) ret = md380_StampMixFile (outputs, config->bundleFileName);
+	if (ret == CSVRET_OK) ret = md380_StampMixFile (outputs, config->columnarFileName);
+	return ret;
+}
+
+/*=========================================================================
+	Stamp of a job: see md380_stamp.h
+=========================================================================*/
+int md380_JobStamp (MD380_Configuration* config, MD380_Stamp* stamp, int* stampable)
+{
+	unsigned i;
+	int ret = CSVRET_OK;
+	
+	memset (stamp, 0, sizeof (*stamp));
+	(*stampable) = 0;
+	if (config->updateMode != modeExport && config->updateMode != modeUpdate) return CSVRET_OK;
+	if (config->rdtFileName == NULL || md380_IsStdioName (config->rdtFileName)) return CSVRET_OK;
+	if (md380_StdioTables (&config->csvFileNames)) return CSVRET_OK;
+	if (md380_IsStdioName (config->bundleFileName) || md380_IsStdioName (config->columnarFileName)) return CSVRET_OK;
+	(*stampable) = 1;
+	
+	/* The job: what is done on which files */
+	stamp->job = md380_StampMix (0, (uint64_t)config->updateMode);
+	stamp->job = md380_StampMixName (stamp->job, config->rdtFileName);
+	for (i=0; i<NO_OF_CLI_COMMANDS; i++) {
+		stamp->job = md380_StampMixName (stamp->job, *PATH_CSVFileNames (&config->csvFileNames, i));
+	}
+	stamp->job = md380_StampMixName (stamp->job, config->bundleFileName);
+	stamp->job = md380_StampMixName (stamp->job, config->columnarFileName);
+	
+	/* The inputs */
+	stamp->inputs = md380_StampMix (0, (uint64_t)(unsigned char)config->separator);
+	stamp->inputs = md380_StampMix (stamp->inputs, SUBVERSION_RELEASE_N);
+	if (config->updateMode == modeExport) {
+		ret = md380_StampMixFile (&stamp->inputs, config->rdtFileName);
+	}
+	else {
+		for (i=0; i<NO_OF_CLI_COMMANDS && ret == CSVRET_OK; i++) {
+			ret = md380_StampMixFile (&stamp->inputs, *PATH_CSVFileNames (&config->csvFileNames, i));
+		}
+		if (ret == CSVRET_OK) ret = md380_StampMixFile (&stamp->inputs, config->bundleFileName);
+	}
+	
+	if (ret == CSVRET_OK) ret = md380_OutputsStamp (config, &stamp->outputs);
+	return ret;
+}
+
+/*=========================================================================
+	Lookup: the stamps of a nightly build are a few hundreds at most,
+	a linear search is enough
+=========================================================================*/
+const MD380_Stamp* md380_FindStamp (const MD380_StampDB* db, uint64_t job)
+{
+	unsigned i;
+	for (i=0; i<db->noOfItems; i++) {
+		if (db->items[i].job == job) return db->items+i;
+	}
+	return NULL;
+}
+
+int md380_RecordStamp (MD380_StampDB* db, const MD380_Stamp* stamp)
+{
+	MD380_Stamp* found = (MD380_Stamp*)md380_FindStamp (db, stamp->job);
+	
+	if (found == NULL) {
+		if (db->noOfItems >= db->allocated) {
+			unsigned newAllocated = (db->allocated ? db->allocated*2 : 64);
+			MD380_Stamp* items = (MD380_Stamp*)binAlloc (newAllocated*sizeof (MD380_Stamp));
+			if (items == NULL) return CSVRET_OUT_OF_MEMORY;
+			if (db->items) {
+				memcpy (items, db->items, db->noOfItems*sizeof (MD380_Stamp));
+				binFree (db->items);
+			}
+			db->items = items;
+			db->allocated = newAllocated;
+		}
+		found = db->items+(db->noOfItems++);
+	}
+	memcpy (found, stamp, sizeof (*found));
+	db->changed = 1;
+	return CSVRET_OK;
+}
+
+void md380_RemoveStamp (MD380_StampDB* db, uint64_t job)
+{
+	MD380_Stamp* found = (MD380_Stamp*)md380_FindStamp (db, job);
+	
+	if (found == NULL) return;
+	memmove (found, found+1, (db->items+db->noOfItems-(found+1))*sizeof (MD380_Stamp));
+	db->noOfItems--;
+	db->changed = 1;
+}
+
+/*=========================================================================
+	Converts 16 hexadecimal digits; returns 0=ok 1=invalid
+=========================================================================*/
+static int md380_ParseStampHash (const char* text, uint64_t* value)
+{
+	unsigned i;
+	
+	(*value) = 0;
+	for (i=0; i<16; i++) {
+		char ch = text[i];
+		unsigned digit;
+		if (ch >= '0' && ch <= '9') digit = ch-'0';
+		else if (ch >= 'a' && ch <= 'f') digit = ch-'a'+10;
+		else if (ch >= 'A' && ch <= 'F') digit = ch-'A'+10;
+		else return 1;
+		(*value) = ((*value) << 4) | digit;
+	}
+	return (text[16] != '\0');
+}
+
+/*=========================================================================
+	Load the stamps
+=========================================================================*/
+int md380_LoadStamps (MD380_StampDB* db, const char* fileName, char** errorMessage)
+{
+	char token [32];
+	int tokenLength;
+	unsigned lineNo;
+	FILE* f;
+	int ret = CSVRET_OK;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	f = fopen (fileName, "rb");
+	if (f == NULL) {
+		if (errno == ENOENT) return CSVRET_OK;
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+128);
+		if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
+		sprintf ((*errorMessage), "Error opening the stamp file '%s' (%s)", fileName, strerror (errno));
+		return MD380ERR_FILE_ERROR;
+	}
+	
+	/* The header is skipped; every other line is a stamp */
+	for (lineNo=1;;lineNo++) {
+		uint64_t values [3];
+		MD380_Stamp stamp;
+		unsigned j = 0;
+		int invalid = 0;
+		
+		do {
+			ret = csvReadToken (token, sizeof (token), &tokenLength, ',', md380_FILEReadCharFunc, f);
+			if (ret != CSVRET_OK && ret != CSVRET_EOL && ret != CSVRET_EOF) {invalid = 1; break;}
+			if (j < 3 && md380_ParseStampHash (token, values+j)) invalid = 1;
+			j++;
+		} while (ret == CSVRET_OK);
+		
+		if (lineNo > 1 && !(j == 1 && tokenLength == 0 && (ret == CSVRET_EOL || ret == CSVRET_EOF))) {
+			if (invalid || j != 3) {
+				(*errorMessage) = (char*)binAlloc (strlen (fileName)+128);
+				if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; break;}
+				sprintf ((*errorMessage), "In stamp file '%s', line %u, invalid stamp", fileName, lineNo);
+				ret = MD380ERR_INVALID_CSV_FORMAT;
+				break;
+			}
+			stamp.job = values[0];
+			stamp.inputs = values[1];
+			stamp.outputs = values[2];
+			if (md380_RecordStamp (db, &stamp) != CSVRET_OK) {ret = CSVRET_OUT_OF_MEMORY; break;}
+		}
+		if (ret == CSVRET_EOF) {
+			ret = CSVRET_OK;
+			break;
+		}
+	}
+	fclose (f);
+	db->changed = 0;
+	return ret;
+}
+
+/*=========================================================================
+	Save the stamps
+=========================================================================*/
+int md380_SaveStamps (const MD380_StampDB* db, const char* fileName, char** errorMessage)
+{
+	char* tempName;
+	FILE* f;
+	unsigned i;
+	int ret = CSVRET_OK;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	tempName = (char*)binAlloc (strlen (fileName)+8);
+	if (tempName == NULL) return CSVRET_OUT_OF_MEMORY;
+	
+	/* Written aside and renamed, so that an interrupted build keeps the old stamps */
+	sprintf (tempName, "%s.tmp", fileName);
+	f = fopen (tempName, "wb");
+	if (f == NULL) ret = MD380ERR_FILE_ERROR;
+	else {
+		if (fprintf (f, "%s\r\n", MD380_STAMP_HEADER) < 0) ret = MD380ERR_FILE_ERROR;
+		for (i=0; i<db->noOfItems && ret == CSVRET_OK; i++) {
+			const MD380_Stamp* s = db->items+i;
+			if (fprintf (f, "%08lx%08lx,%08lx%08lx,%08lx%08lx\r\n",
+				(unsigned long)(s->job >> 32), (unsigned long)(s->job & 0xFFFFFFFFu),
+				(unsigned long)(s->inputs >> 32), (unsigned long)(s->inputs & 0xFFFFFFFFu),
+				(unsigned long)(s->outputs >> 32), (unsigned long)(s->outputs & 0xFFFFFFFFu)) < 0) ret = MD380ERR_FILE_ERROR;
+		}
+		if (fclose (f) != 0) ret = MD380ERR_FILE_ERROR;
+	}
+	if (ret == CSVRET_OK) {
+#ifdef _WIN32
+		remove (fileName);
+#endif
+		if (rename (tempName, fileName) != 0) ret = MD380ERR_FILE_ERROR;
+	}
+	if (ret != CSVRET_OK) {
+		(*errorMessage) = (char*)binAlloc (strlen (tempName)+128);
+		if ((*errorMessage) != NULL) sprintf ((*errorMessage), "Error saving the stamp file '%s' (%s)", fileName, strerror (errno));
+		else ret = CSVRET_OUT_OF_MEMORY;
+		remove (tempName);
+	}
+	binFree (tempName);
+	return ret;
+}
+
+/*=========================================================================
+	Jobs files are written by hand: a LF alone ends the line as well,
+	given to the CSV Lib as CR-LF
+=========================================================================*/
+typedef struct {
+	FILE* f;
+	int previous;
+	int pendingLF;
+} JobReader;
+
+static int md380_JobReadCharFunc (void* param)
+{
+	JobReader* reader = (JobReader*)param;
+	int ch;
+	
+	if (reader->pendingLF) {
+		reader->pendingLF = 0;
+		reader->previous = '\n';
+		return '\n';
+	}
+	ch = md380_FILEReadCharFunc (reader->f);
+	if (ch == '\n' && reader->previous != '\r') {
+		reader->pendingLF = 1;
+		ch = '\r';
+	}
+	reader->previous = ch;
+	return ch;
+}
+
+/*=========================================================================
+	Read a job: see md380_stamp.h
+=========================================================================*/
+int md380_ReadJob (FILE* f, const char* fileName, char separator, unsigned* lineNo, char*** argv, int* argc, char** errorMessage)
+{
+	char token [MD380_JOB_ARG_SIZE];
+	int tokenLength;
+	MD380_MemBuffer text;
+	JobReader reader;
+	int ret;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	(*argv) = NULL;
+	(*argc) = 0;
+	reader.f = f;
+	reader.previous = 0;
+	reader.pendingLF = 0;
+	INIT_MD380_MemBuffer (&text);
+	
+	for (;;) {
+		int count = 0;
+		int comment = 0;
+		
+		/* Collect the arguments of a line, each one with its terminator */
+		text.length = 0;
+		(*lineNo)++;
+		do {
+			ret = csvReadToken (token, sizeof (token), &tokenLength, separator, md380_JobReadCharFunc, &reader);
+			if (ret != CSVRET_OK && ret != CSVRET_EOL && ret != CSVRET_EOF) {
+				(*errorMessage) = (char*)binAlloc (strlen (fileName)+128);
+				if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+				sprintf ((*errorMessage), "file %s, line %u, error %s", fileName, (*lineNo), md380_CsvRetToString (ret));
+				ret = MD380ERR_INVALID_CSV_FORMAT;
+				goto exitFunc;
+			}
+			if (tokenLength >= MD380_JOB_ARG_SIZE) {
+				(*errorMessage) = (char*)binAlloc (strlen (fileName)+128);
+				if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+				sprintf ((*errorMessage), "file %s, line %u, argument too long", fileName, (*lineNo));
+				ret = MD380ERR_INVALID_CSV_FORMAT;
+				goto exitFunc;
+			}
+			if (count == 0 && token[0] == '#') comment = 1;
+			if (tokenLength > 0 && !comment) {
+				if (md380_MemWriteBinaryFunc (&text, token, (unsigned)tokenLength+1)) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+				count++;
+			}
+		} while (ret == CSVRET_OK);
+		
+		if (count > 0) {
+			/* One block: the pointers, then the strings they point to */
+			size_t pointersSize = (count+1)*sizeof (char*);
+			char* strings;
+			int k;
+			(*argv) = (char**)binAlloc (pointersSize+text.length);
+			if ((*argv) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+			strings = ((char*)(*argv))+pointersSize;
+			memcpy (strings, text.data, text.length);
+			for (k=0; k<count; k++) {
+				(*argv)[k] = strings;
+				strings += strlen (strings)+1;
+			}
+			(*argv)[count] = NULL;
+			(*argc) = count;
+			ret = CSVRET_OK;
+			goto exitFunc;
+		}
+		if (ret == CSVRET_EOF) goto exitFunc;
+	}
+
+exitFunc:
+	FREE_MD380_MemBuffer (&text);
+	return ret;
+}
@@ -0,0 +1,144 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_STAMP_H
+#define __MD380_STAMP_H
+#include <stdio.h>
+#include <stdint.h>
+#include "md380.h"
+#include "md380_tools.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Job stamps.
+	
+	A job is one export (-e) or update (-u) command line. Its stamp
+	holds three 64 bit hashes:
+	
+	    job      the action and the names of the files
+	    inputs   the separator, the release of this program and the
+	             contents of the files read: the image for -e, the
+	             .csv files and the bundle for -u
+	    outputs  the contents of the files written: the .csv files,
+	             the bundle and the columnar file for -e, the image
+	             for -u
+	
+	The image of -u is both read and written: it is among the outputs
+	only, since updating it again from the same .csv files would not
+	change it. A missing file is hashed too, so that deleting an output
+	runs the job again.
+	
+	The stamps are kept in a CSV file, one line per job:
+	
+	    Job,Inputs,Outputs
+	    0123456789abcdef,0123456789abcdef,0123456789abcdef
+	
+	A job whose inputs and outputs match its stamp is not run again.
+	Jobs on the standard input or output have no stamp and always run.
+=========================================================================*/
+#define MD380_STAMP_HEADER   "Job,Inputs,Outputs"
+
+/* Longest argument of a line of a jobs file, terminator included */
+#define MD380_JOB_ARG_SIZE   1024
+
+typedef struct {
+	uint64_t job;
+	uint64_t inputs;
+	uint64_t outputs;
+} MD380_Stamp;
+
+/* Stamps of a file. Use INIT_MD380_StampDB and FREE_MD380_StampDB */
+typedef struct {
+	MD380_Stamp* items;
+	unsigned noOfItems;
+	unsigned allocated;
+	
+	/* Set when a stamp is recorded or removed */
+	int changed;
+} MD380_StampDB;
+
+/* Initialize */
+extern void INIT_MD380_StampDB (MD380_StampDB* db);
+
+/* Free */
+extern void FREE_MD380_StampDB (MD380_StampDB* db);
+
+/*=========================================================================
+	Loads the stamps of 'fileName'; a missing file has no stamps.
+	Returns CSVRET_xxx and MD380ERR_xxx values. The 'errorMessage'
+	string is allocated with binAlloc in case of error and it is to be
+	freed with binFree.
+=========================================================================*/
+extern int md380_LoadStamps (MD380_StampDB* db, const char* fileName, char** errorMessage);
+
+/*=========================================================================
+	Writes the stamps to 'fileName', replacing it only once complete.
+	Returns CSVRET_OK, CSVRET_OUT_OF_MEMORY or MD380ERR_FILE_ERROR.
+=========================================================================*/
+extern int md380_SaveStamps (const MD380_StampDB* db, const char* fileName, char** errorMessage);
+
+/*=========================================================================
+	Computes the stamp of the job of 'config' from the files as they
+	are now. 'stampable' is cleared for the jobs that have no stamp.
+	Returns CSVRET_OK or CSVRET_OUT_OF_MEMORY.
+=========================================================================*/
+extern int md380_JobStamp (MD380_Configuration* config, MD380_Stamp* stamp, int* stampable);
+
+/*=========================================================================
+	Recomputes only the outputs hash, once the job has been run.
+	Returns CSVRET_OK or CSVRET_OUT_OF_MEMORY.
+=========================================================================*/
+extern int md380_OutputsStamp (MD380_Configuration* config, uint64_t* outputs);
+
+/*=========================================================================
+	Returns the stamp recorded for 'job', NULL if none
+=========================================================================*/
+extern const MD380_Stamp* md380_FindStamp (const MD380_StampDB* db, uint64_t job);
+
+/*=========================================================================
+	Records 'stamp', replacing the one of the same job.
+	Returns CSVRET_OK or CSVRET_OUT_OF_MEMORY.
+=========================================================================*/
+extern int md380_RecordStamp (MD380_StampDB* db, const MD380_Stamp* stamp);
+
+/*=========================================================================
+	Removes the stamp of 'job', if any
+=========================================================================*/
+extern void md380_RemoveStamp (MD380_StampDB* db, uint64_t job);
+
+/*=========================================================================
+	Reads the next line of a jobs file: a CSV file whose lines hold
+	the command line arguments of one job each, for example
+	
+	    -e,radio1.rdt,-ch,radio1/ch.csv,-zone,radio1/zone.csv
+	
+	Empty lines and lines starting with '#' are skipped. The arguments
+	are returned in the 'argv' array, allocated with binAlloc as one
+	block with the strings, and 'lineNo' is moved to the line read.
+	Returns CSVRET_OK, CSVRET_EOF when there are no more jobs, or
+	CSVRET_xxx and MD380ERR_xxx values in case of error.
+=========================================================================*/
+extern int md380_ReadJob (FILE* f, const char* fileName, char separator, unsigned* lineNo, char*** argv, int* argc, char** errorMessage);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
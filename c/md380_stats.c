@@ -0,0 +1,139 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_stats.h"
+#include "binlib.h"
+#include <string.h>
+#include <stdio.h>
+#include <assert.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+MD380_Stats md380_stats;
+
+/*=========================================================================
+	Monotonic clock in nanoseconds
+=========================================================================*/
+uint64_t md380_StatsNow (void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER counter, frequency;
+	QueryPerformanceCounter (&counter);
+	QueryPerformanceFrequency (&frequency);
+	return (uint64_t)((double)counter.QuadPart*1e9/(double)frequency.QuadPart);
+#else
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec*1000000000u+(uint64_t)ts.tv_nsec;
+#endif
+}
+
+/*=========================================================================
+	Clears the statistics and starts collecting them
+=========================================================================*/
+void md380_StatsEnable (void)
+{
+	memset (&md380_stats, 0, sizeof (md380_stats));
+	md380_stats.enabled = 1;
+	binNoOfAllocs = 0;
+	binCountAllocs = 1;
+}
+
+/*=========================================================================
+	Timing of the phases
+=========================================================================*/
+void md380_StatsStart (MD380_StatsTimer* timer)
+{
+	timer->wallNs = md380_StatsNow ();
+	timer->cpu = clock ();
+}
+
+void md380_StatsStop (const MD380_StatsTimer* timer, MD380_Phase phase)
+{
+	MD380_PhaseStats* ps = md380_stats.phases+phase;
+	assert (phase < MD380_NO_OF_PHASES);
+	ps->wallNs += md380_StatsNow ()-timer->wallNs;
+	ps->cpuNs += (uint64_t)((double)(clock ()-timer->cpu)*1e9/CLOCKS_PER_SEC);
+	ps->calls++;
+}
+
+void md380_StatsLap (MD380_StatsTimer* timer, MD380_Phase phase)
+{
+	md380_StatsStop (timer, phase);
+	md380_StatsStart (timer);
+}
+
+void md380_StatsStopTable (const MD380_StatsTimer* timer, MD380_Phase phase, unsigned table, unsigned records)
+{
+	unsigned i;
+	assert (phase == MD380_PHASE_CSV_READ || phase == MD380_PHASE_CSV_WRITE);
+	for (i=0; i<NO_OF_RECORDS_TRDTFile; i++) {
+		if (table == (1u << i)) break;
+	}
+	assert (i < NO_OF_RECORDS_TRDTFile);
+	md380_StatsStop (timer, (MD380_Phase)(phase+i));
+	if (phase == MD380_PHASE_CSV_READ) {
+		md380_stats.recordsRead[i] += records;
+	}
+	else {
+		md380_stats.recordsWritten[i] += records;
+	}
+}
+
+/*=========================================================================
+	Prints the phases that ran and the counters
+=========================================================================*/
+void md380_PrintStats (FILE* f)
+{
+	static const char* phaseNames [] = {"load", "decode", "validate", "register", "bind/resolve"};
+	unsigned i;
+	
+	fprintf (f, "%-40s %8s %12s %12s\n", "Phase", "Calls", "Wall (ms)", "CPU (ms)");
+	for (i=0; i<MD380_NO_OF_PHASES; i++) {
+		const MD380_PhaseStats* ps = md380_stats.phases+i;
+		char name [64];
+		if (ps->calls == 0) continue;
+		if (i < MD380_PHASE_CSV_READ) {
+			strcpy (name, phaseNames[i]);
+		}
+		else if (i < MD380_PHASE_CSV_WRITE) {
+			sprintf (name, "csv read %s", RECORDS_TRDTFile[i-MD380_PHASE_CSV_READ].recordName);
+		}
+		else if (i < MD380_PHASE_ENCODE) {
+			sprintf (name, "csv write %s", RECORDS_TRDTFile[i-MD380_PHASE_CSV_WRITE].recordName);
+		}
+		else {
+			strcpy (name, (i == MD380_PHASE_ENCODE ? "encode" : "save"));
+		}
+		fprintf (f, "%-40s %8lu %12.3f %12.3f\n", name, ps->calls, (double)ps->wallNs/1e6, (double)ps->cpuNs/1e6);
+	}
+	
+	fprintf (f, "\n%-40s %12s %12s\n", "Records", "Read", "Written");
+	for (i=0; i<NO_OF_RECORDS_TRDTFile; i++) {
+		if (md380_stats.recordsRead[i] == 0 && md380_stats.recordsWritten[i] == 0) continue;
+		fprintf (f, "%-40s %12lu %12lu\n", RECORDS_TRDTFile[i].recordName, md380_stats.recordsRead[i], md380_stats.recordsWritten[i]);
+	}
+	
+	fprintf (f, "\n");
+	fprintf (f, "%-40s %12.0f\n", "Bytes read", (double)md380_stats.bytesRead);
+	fprintf (f, "%-40s %12.0f\n", "Bytes written", (double)md380_stats.bytesWritten);
+	fprintf (f, "%-40s %12lu\n", "References resolved", md380_stats.referencesResolved);
+	fprintf (f, "%-40s %12lu\n", "Enum lookups", md380_stats.enumLookups);
+	fprintf (f, "%-40s %12lu\n", "Allocations", binNoOfAllocs);
+}
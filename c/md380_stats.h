@@ -0,0 +1,121 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_STATS_H
+#define __MD380_STATS_H
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include "md380.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Run statistics (--stats).
+	
+	The phases of a run are timed, both as wall time and as CPU time of
+	the process, and some counters are kept: bytes read and written by
+	the image and CSV files, records read and written per table,
+	references bound or resolved, enum lookups and binAlloc calls.
+	Timing a phase more than once (e.g. by -jobs) adds up.
+	
+	Everything is off until md380_StatsEnable is called: the macros
+	below then cost a single test of md380_stats.enabled. The counters
+	are not thread safe and cannot be used by -server.
+=========================================================================*/
+typedef enum {
+	MD380_PHASE_LOAD,
+	MD380_PHASE_DECODE,
+	MD380_PHASE_VALIDATE,
+	MD380_PHASE_REGISTER,
+	MD380_PHASE_BIND,
+	
+	/* Followed by one phase per table, in the order of RECORDS_TRDTFile */
+	MD380_PHASE_CSV_READ,
+	MD380_PHASE_CSV_WRITE = MD380_PHASE_CSV_READ+NO_OF_RECORDS_TRDTFile,
+	
+	MD380_PHASE_ENCODE = MD380_PHASE_CSV_WRITE+NO_OF_RECORDS_TRDTFile,
+	MD380_PHASE_SAVE,
+	MD380_NO_OF_PHASES
+} MD380_Phase;
+
+typedef struct {
+	uint64_t wallNs;
+	uint64_t cpuNs;
+	unsigned long calls;
+} MD380_PhaseStats;
+
+typedef struct {
+	int enabled;
+	MD380_PhaseStats phases [MD380_NO_OF_PHASES];
+	uint64_t bytesRead;
+	uint64_t bytesWritten;
+	unsigned long recordsRead [NO_OF_RECORDS_TRDTFile];
+	unsigned long recordsWritten [NO_OF_RECORDS_TRDTFile];
+	unsigned long referencesResolved;
+	unsigned long enumLookups;
+} MD380_Stats;
+
+extern MD380_Stats md380_stats;
+
+/* Start of a timed phase */
+typedef struct {
+	uint64_t wallNs;
+	clock_t cpu;
+} MD380_StatsTimer;
+
+#define MD380_STATS_START(timer)       do {if (md380_stats.enabled) md380_StatsStart (timer);} while (0)
+#define MD380_STATS_STOP(timer, phase) do {if (md380_stats.enabled) md380_StatsStop (timer, phase);} while (0)
+#define MD380_STATS_ADD(counter, n)    do {if (md380_stats.enabled) md380_stats.counter += (n);} while (0)
+
+/* Stops the phase and starts the next one with the same timer */
+#define MD380_STATS_LAP(timer, phase)  do {if (md380_stats.enabled) md380_StatsLap (timer, phase);} while (0)
+
+/* For MD380_PHASE_CSV_READ and MD380_PHASE_CSV_WRITE: 'table' is a TABLE_xxx */
+/* bit and 'records' is added to the records read or written of the table */
+#define MD380_STATS_STOP_TABLE(timer, phase, table, records) do {if (md380_stats.enabled) md380_StatsStopTable (timer, phase, table, records);} while (0)
+
+/*=========================================================================
+	Monotonic clock in nanoseconds
+=========================================================================*/
+extern uint64_t md380_StatsNow (void);
+
+/*=========================================================================
+	Clears the statistics and starts collecting them
+=========================================================================*/
+extern void md380_StatsEnable (void);
+
+/*=========================================================================
+	Use the MD380_STATS_XXX macros instead
+=========================================================================*/
+extern void md380_StatsStart (MD380_StatsTimer* timer);
+extern void md380_StatsStop (const MD380_StatsTimer* timer, MD380_Phase phase);
+extern void md380_StatsLap (MD380_StatsTimer* timer, MD380_Phase phase);
+extern void md380_StatsStopTable (const MD380_StatsTimer* timer, MD380_Phase phase, unsigned table, unsigned records);
+
+/*=========================================================================
+	Prints the phases that ran and the counters
+=========================================================================*/
+extern void md380_PrintStats (FILE* f);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,270 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_stdio.h"
+#include "md380_file.h"
+#include "md380_lib.h"
+#include "md380_stats.h"
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <assert.h>
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+/* Name used in the error messages */
+#define STDIO_STREAM_NAME "(standard input/output)"
+
+/*=========================================================================
+	On Windows, the standard streams are opened in text mode
+=========================================================================*/
+static void md380_StdioBinaryMode (FILE* f)
+{
+#ifdef _WIN32
+	_setmode (_fileno (f), _O_BINARY);
+#endif
+}
+
+/*=========================================================================
+	Allocates an error message about the standard streams
+=========================================================================*/
+static int md380_StdioError (char** errorMessage, const char* text, const char* detail, int ret)
+{
+	(*errorMessage) = (char*)binAlloc (strlen (text)+strlen (detail)+64);
+	if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
+	sprintf ((*errorMessage), "%s: %s%s", STDIO_STREAM_NAME, text, detail);
+	return ret;
+}
+
+/*=========================================================================
+	Names standing for the standard streams
+=========================================================================*/
+int md380_IsStdioName (const char* fileName)
+{
+	return (fileName != NULL && strcmp (fileName, MD380_STDIO_NAME) == 0);
+}
+
+unsigned md380_StdioTables (const CSVFileNames* csvFileNames)
+{
+	unsigned tableMask = 0;
+	unsigned i;
+	for (i=0; i<NO_OF_CSV_STREAMS; i++) {
+		if (md380_IsStdioName (*PATH_CSVFileNames ((CSVFileNames*)csvFileNames, i))) tableMask |= (1u << i);
+	}
+	return tableMask;
+}
+
+void md380_RemoveStdioTables (CSVFileNames* csvFileNames)
+{
+	unsigned i;
+	for (i=0; i<NO_OF_CSV_STREAMS; i++) {
+		char** path = PATH_CSVFileNames (csvFileNames, i);
+		if (md380_IsStdioName (*path)) {
+			binFree (*path);
+			(*path) = NULL;
+		}
+	}
+}
+
+/*=========================================================================
+	Reads a whole image
+=========================================================================*/
+int md380_ReadImageStream (FILE* f, t_buffer* image, unsigned* offset, unsigned* length, char** errorMessage)
+{
+	size_t readSize;
+	char sizeText [64];
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	/* A .rdt is the longest: anything beyond it is an error */
+	md380_StdioBinaryMode (f);
+	readSize = fread (image, 1, FILE_SIZE_TRDTFile, f);
+	MD380_STATS_ADD (bytesRead, readSize);
+	if (ferror (f)) {
+		return md380_StdioError (errorMessage, "error reading the image: ", strerror (errno), MD380ERR_FILE_ERROR);
+	}
+	if (readSize == FILE_SIZE_TRDTFile && fgetc (f) != EOF) {
+		return md380_StdioError (errorMessage, "image longer than a .rdt file", "", MD380ERR_FILE_ERROR);
+	}
+	if (md380_ImageLayout ((unsigned)readSize, offset, length) != CSVRET_OK) {
+		sprintf (sizeText, "%u octets", (unsigned)readSize);
+		return md380_StdioError (errorMessage, "image size does not match a .rdt or .bin/.img file: ", sizeText, MD380ERR_FILE_ERROR);
+	}
+	
+	/* Move a .bin to its place in the image */
+	if ((*offset) != 0) {
+		memmove (image+(*offset), image, (*length));
+		memset (image, 0, (*offset));
+		memset (image+(*offset)+(*length), 0, FILE_SIZE_TRDTFile-(*offset)-(*length));
+	}
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Writes a whole image
+=========================================================================*/
+int md380_WriteImageStream (FILE* f, const t_buffer* image, unsigned offset, unsigned length, char** errorMessage)
+{
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	md380_StdioBinaryMode (f);
+	if (fwrite (image+offset, 1, length, f) != length || fflush (f) != 0) {
+		return md380_StdioError (errorMessage, "error writing the image: ", strerror (errno), MD380ERR_FILE_ERROR);
+	}
+	MD380_STATS_ADD (bytesWritten, length);
+	return CSVRET_OK;
+}
+
+/*=========================================================================
+	Writes some tables
+=========================================================================*/
+int md380_SaveCSVStream (FILE* f, const TRDTFile* container, unsigned tableMask, char separator, char** errorMessage)
+{
+	int withHeaders = ((tableMask & (tableMask-1)) != 0);
+	int ret = CSVRET_OK;
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	md380_StdioBinaryMode (f);
+	for (i=0; i<NO_OF_CSV_STREAMS && ret == CSVRET_OK; i++) {
+		if ((tableMask & (1u << i)) == 0) continue;
+		if (withHeaders) {
+			if (fprintf (f, "%s%s\r\n", MD380_STDIO_TABLE_HEADER, csvStreamFuncs[i].recordName) < 0) break;
+		}
+		ret = csvStreamFuncs[i].saveCSVStream (STDIO_STREAM_NAME, container, separator, md380_FILEWriteBinaryFunc, f, errorMessage);
+	}
+	if (ret == CSVRET_OK && (fflush (f) != 0 || ferror (f))) {
+		ret = md380_StdioError (errorMessage, "error writing the tables: ", strerror (errno), MD380ERR_FILE_ERROR);
+	}
+	return ret;
+}
+
+/*=========================================================================
+	Returns the length of the header line at 'p' and the table it
+	names in 'table'; 0 if it is not a header line
+=========================================================================*/
+static unsigned md380_StdioHeaderLine (const char* p, const char* end, unsigned* table)
+{
+	const char* name = p+strlen (MD380_STDIO_TABLE_HEADER);
+	const char* q;
+	unsigned i;
+	
+	if ((unsigned)(end-p) < strlen (MD380_STDIO_TABLE_HEADER)) return 0;
+	if (memcmp (p, MD380_STDIO_TABLE_HEADER, strlen (MD380_STDIO_TABLE_HEADER))) return 0;
+	for (q=name; q<end && *q != '\r' && *q != '\n'; q++);
+	(*table) = NO_OF_CSV_STREAMS;
+	for (i=0; i<NO_OF_CSV_STREAMS; i++) {
+		if (strlen (csvStreamFuncs[i].recordName) == (size_t)(q-name) && memcmp (csvStreamFuncs[i].recordName, name, q-name) == 0) (*table) = i;
+	}
+	if (q < end && *q == '\r') q++;
+	if (q < end && *q == '\n') q++;
+	return (unsigned)(q-p);
+}
+
+/*=========================================================================
+	Reads some tables
+=========================================================================*/
+int md380_LoadCSVStream (FILE* f, TRDTFile* container, unsigned tableMask, char separator, char** errorMessage)
+{
+	MD380_MemBuffer input;
+	MD380_MemReader reader;
+	unsigned loadedMask = 0;
+	char chunk [4096];
+	size_t n;
+	int ret = CSVRET_OK;
+	unsigned i;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	/* The sections are found on the whole input */
+	INIT_MD380_MemBuffer (&input);
+	md380_StdioBinaryMode (f);
+	while ((n = fread (chunk, 1, sizeof (chunk), f)) > 0) {
+		MD380_STATS_ADD (bytesRead, n);
+		if (md380_MemWriteBinaryFunc (&input, chunk, (unsigned)n)) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+	}
+	if (ferror (f)) {
+		ret = md380_StdioError (errorMessage, "error reading the tables: ", strerror (errno), MD380ERR_FILE_ERROR);
+		goto exitFunc;
+	}
+	
+	if ((tableMask & (tableMask-1)) == 0) {
+		/* A single table: plain CSV */
+		for (i=0; i<NO_OF_CSV_STREAMS && (tableMask & (1u << i)) == 0; i++);
+		assert (i < NO_OF_CSV_STREAMS);
+		md380_OpenMemReader (&reader, input.data, input.length);
+		ret = csvStreamFuncs[i].loadCSVStream (STDIO_STREAM_NAME, container, separator, md380_MemReadCharFunc, &reader, errorMessage);
+		loadedMask = tableMask;
+	}
+	else {
+		/* Several tables, each one after its header line */
+		const char* end = input.data+input.length;
+		const char* p = input.data;
+		unsigned table, headerLength;
+		
+		if (input.length == 0 || (headerLength = md380_StdioHeaderLine (p, end, &table)) == 0) {
+			ret = md380_StdioError (errorMessage, "missing table header ", MD380_STDIO_TABLE_HEADER, MD380ERR_INVALID_CSV_FORMAT);
+			goto exitFunc;
+		}
+		while (p < end) {
+			const char* section = p+headerLength;
+			const char* next;
+			unsigned nextTable = NO_OF_CSV_STREAMS;
+			unsigned nextHeaderLength = 0;
+			
+			if (table >= NO_OF_CSV_STREAMS || (tableMask & (1u << table)) == 0 || (loadedMask & (1u << table))) {
+				char name [64];
+				unsigned nameLength = headerLength-(unsigned)strlen (MD380_STDIO_TABLE_HEADER);
+				if (nameLength >= sizeof (name)) nameLength = sizeof (name)-1;
+				memcpy (name, p+strlen (MD380_STDIO_TABLE_HEADER), nameLength);
+				name[nameLength] = 0;
+				name[strcspn (name, "\r\n")] = 0;
+				ret = md380_StdioError (errorMessage, "unexpected or repeated table ", name, MD380ERR_INVALID_CSV_FORMAT);
+				goto exitFunc;
+			}
+			
+			/* The section ends at the next header line */
+			for (next=section; next<end; next++) {
+				if ((next == section || next[-1] == '\n') && (nextHeaderLength = md380_StdioHeaderLine (next, end, &nextTable)) != 0) break;
+			}
+			md380_OpenMemReader (&reader, section, (unsigned)(next-section));
+			ret = csvStreamFuncs[table].loadCSVStream (STDIO_STREAM_NAME, container, separator, md380_MemReadCharFunc, &reader, errorMessage);
+			if (ret != CSVRET_OK) goto exitFunc;
+			loadedMask |= (1u << table);
+			p = next;
+			table = nextTable;
+			headerLength = nextHeaderLength;
+		}
+	}
+	
+	if (ret == CSVRET_OK && loadedMask != tableMask) {
+		for (i=0; i<NO_OF_CSV_STREAMS && ((tableMask & ~loadedMask) & (1u << i)) == 0; i++);
+		ret = md380_StdioError (errorMessage, "missing table ", csvStreamFuncs[i].recordName, MD380ERR_INVALID_CSV_FORMAT);
+	}
+
+exitFunc:
+	FREE_MD380_MemBuffer (&input);
+	return ret;
+}
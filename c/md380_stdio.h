@@ -0,0 +1,93 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_STDIO_H
+#define __MD380_STDIO_H
+#include <stdio.h>
+#include "md380.h"
+#include "md380_tools.h"
+#include "md380_cli.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Standard input and output.
+	
+	The name "-" given for the image or for a CSV file stands for the
+	standard input when reading and for the standard output when
+	writing, so that the tool can sit in a pipeline.
+	
+	The image is read to its end and its format is told by its length:
+	FILE_SIZE_TRDTFile octets for a .rdt, FILE_SIZE_TBINFile for a .bin.
+	An updated image is always written whole.
+	
+	When a single table is given as "-" the stream is plain CSV. When
+	several are, each table is preceded by a line
+	
+	    #RDT2CSV-TABLE <recordName>
+	
+	and is followed by the next one or by the end of the stream; on
+	input the tables can be in any order.
+=========================================================================*/
+#define MD380_STDIO_NAME "-"
+#define MD380_STDIO_TABLE_HEADER "#RDT2CSV-TABLE "
+
+/* Returns non zero if 'fileName' stands for standard input or output */
+extern int md380_IsStdioName (const char* fileName);
+
+/* Returns the TABLE_xxx bits of the CSV file names given as "-" */
+extern unsigned md380_StdioTables (const CSVFileNames* csvFileNames);
+
+/* Removes the CSV file names given as "-", once they have been handled */
+extern void md380_RemoveStdioTables (CSVFileNames* csvFileNames);
+
+/*=========================================================================
+	Reads a whole .rdt or .bin image from 'f' into 'image', which must
+	be FILE_SIZE_TRDTFile octets, and returns where it has been put as
+	loadRdtFile does.
+	Returns CSVRET_OK, CSVRET_OUT_OF_MEMORY or MD380ERR_FILE_ERROR. The
+	'errorMessage' string is allocated with binAlloc in case of error
+	and it is to be freed with binFree.
+=========================================================================*/
+extern int md380_ReadImageStream (FILE* f, t_buffer* image, unsigned* offset, unsigned* length, char** errorMessage);
+
+/*=========================================================================
+	Writes the 'length' octets of the image from 'offset' to 'f'.
+	Returns CSVRET_OK or MD380ERR_FILE_ERROR.
+=========================================================================*/
+extern int md380_WriteImageStream (FILE* f, const t_buffer* image, unsigned offset, unsigned length, char** errorMessage);
+
+/*=========================================================================
+	Writes the tables selected by 'tableMask' (TABLE_xxx bits) to 'f'.
+	Returns CSVRET_xxx and MD380ERR_xxx values.
+=========================================================================*/
+extern int md380_SaveCSVStream (FILE* f, const TRDTFile* container, unsigned tableMask, char separator, char** errorMessage);
+
+/*=========================================================================
+	Reads the tables selected by 'tableMask' (TABLE_xxx bits) from 'f';
+	every one of them must be found.
+	Returns CSVRET_xxx and MD380ERR_xxx values.
+=========================================================================*/
+extern int md380_LoadCSVStream (FILE* f, TRDTFile* container, unsigned tableMask, char separator, char** errorMessage);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -0,0 +1,212 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#define _CRT_SECURE_NO_WARNINGS
+#include "md380_synth.h"
+#include "md380_file.h"
+#include "md380_cli.h"
+#include "md380_lib.h"
+#include "md380_resolve.h"
+#include "md380_valid.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <assert.h>
+
+/* Non ASCII character added to the names of FC_unicode fields */
+#define SYNTH_NON_ASCII  0x00E8
+
+/*=========================================================================
+	Counts the violations without reporting them
+=========================================================================*/
+static void md380_SynthCountFunc (void* param, const char* recordType, int recordNumber, const char* fieldName, const char* text)
+{
+	NOWARN_UNUSED(param);
+	NOWARN_UNUSED(recordType);
+	NOWARN_UNUSED(recordNumber);
+	NOWARN_UNUSED(fieldName);
+	NOWARN_UNUSED(text);
+}
+
+/*=========================================================================
+	Writes a unique text for record 'recordNo' of the table 'letter':
+	the number comes first, so that it survives the truncation to
+	'chars' characters, then quotes and separators, repeated to fill
+	the field
+=========================================================================*/
+static void md380_SynthText (t_unicode* target, unsigned chars, int nonAscii, char letter, unsigned recordNo)
+{
+	char ascii [32];
+	unsigned length, i;
+	
+	sprintf (ascii, "\"%c\"%u, \"A;B\"\t", letter, recordNo);
+	length = (unsigned)strlen (ascii);
+	for (i=0; i<chars; i++) target[i] = (t_unicode)(unsigned char)ascii[i % length];
+	if (nonAscii && chars > length) target[length] = SYNTH_NON_ASCII;
+	target[chars] = 0;
+}
+
+/*=========================================================================
+	Synthesize the container
+=========================================================================*/
+int md380_SynthesizeContainer (TRDTFile* container)
+{
+	T_GeneralSettings* gs = &container->GeneralSettings;
+	unsigned t, i, j;
+	
+	memset (container, 0, sizeof (*container));
+	
+	/* Every record, with enumerated values rotating through the */
+	/* enumerators and the other numbers left to zero */
+	for (t=0; t<NO_OF_RECORDS_TRDTFile; t++) {
+		const RecordDescriptor* rd = RECORDS_TRDTFile+t;
+		unsigned char* records = (unsigned char*)container+rd->containerOffset;
+		if (rd->countOffset != RD_NO_COUNT) {
+			*(unsigned*)((unsigned char*)container+rd->countOffset) = rd->maxCount;
+		}
+		for (i=0; i<rd->maxCount; i++) {
+			unsigned char* record = records+i*rd->recordSize;
+			for (j=0; j<rd->noOfFields; j++) {
+				const FieldDescriptor* fd = rd->fieldDescriptors+j;
+				const FieldLayout* fl = rd->fieldLayouts+j;
+				if (fl->layoutType == FL_unicode) {
+					md380_SynthText ((t_unicode*)(record+fl->structOffset), fl->unicodeChars, (fl->codec == FC_unicode), rd->recordName[0], i);
+				}
+				else if (fl->layoutType == FL_numeric && fd->enumCount > 0) {
+					md380_SetNumeric (record+fl->structOffset, fl->numericSize, fd->fieldEnumerators[(i+j) % fd->enumCount].enumValue);
+				}
+			}
+		}
+	}
+	
+	/* Every reference used, the members of a list all different */
+	for (t=0; t<NO_OF_REFERENCE_EDGES_TRDTFile; t++) {
+		const ReferenceEdge* edge = REFERENCE_EDGES_TRDTFile+t;
+		const RecordDescriptor* source = RECORDS_TRDTFile+edge->sourceTable;
+		unsigned targetCount = RECORDS_TRDTFile[edge->targetTable].maxCount;
+		unsigned char* records = (unsigned char*)container+source->containerOffset;
+		for (i=0; i<source->maxCount; i++) {
+			for (j=0; j<edge->arity; j++) {
+				t_reference* ref = (t_reference*)(records+i*source->recordSize+source->fieldLayouts[edge->sourceField+j].structOffset);
+				ref->refLineNo = (unsigned short)(1+(i*edge->arity+j) % targetCount);
+			}
+		}
+	}
+	
+	/* The numbers that are keys or have a range */
+	for (i=0; i<COUNT_ChannelInformation; i++) {
+		T_ChannelInformation* ch = container->ChannelInformation+i;
+		ch->RxFrequency = 43000000+i*1250;
+		ch->TxFrequency = ch->RxFrequency+760000;
+		ch->Colorcode = (t_numeric8)(i % 16);
+		ch->PrivacyNo = (t_numeric8)(i % 8);
+	}
+	for (i=0; i<COUNT_DigitalContact; i++) {
+		container->DigitalContact[i].CallId = 2220000+i;
+	}
+	gs->RadioId = 2221234;
+	gs->TxPreamble = 60;
+	gs->GroupCallHangTime = 30;
+	gs->PrivateCallHangTime = 40;
+	gs->VoxSensitivity = 3;
+	gs->RxLowBatteryInterval = 120;
+	gs->LoneWorkerRespTime = 1;
+	gs->LoneWorkerReminderTime = 10;
+	gs->ScanDigitalHangTime = 10;
+	gs->ScanAnalogHangTime = 10;
+	
+	return validateContainer (container, md380_SynthCountFunc, NULL) + bindReferences (container, md380_SynthCountFunc, NULL);
+}
+
+/*=========================================================================
+	Writes 'length' octets to a file of 'dirName'
+=========================================================================*/
+static int md380_SynthWriteFile (const char* dirName, const char* name, const void* data, unsigned length, char** errorMessage)
+{
+	char* fileName = (char*)binAlloc (strlen (dirName)+strlen (name)+2);
+	FILE* f;
+	int ret = CSVRET_OK;
+	
+	if (fileName == NULL) return CSVRET_OUT_OF_MEMORY;
+	sprintf (fileName, "%s/%s", dirName, name);
+	f = fopen (fileName, "wb");
+	if (f == NULL) ret = MD380ERR_FILE_ERROR;
+	else {
+		if (fwrite (data, 1, length, f) != length) ret = MD380ERR_FILE_ERROR;
+		if (fclose (f) != 0) ret = MD380ERR_FILE_ERROR;
+	}
+	if (ret != CSVRET_OK) {
+		(*errorMessage) = (char*)binAlloc (strlen (fileName)+128);
+		if ((*errorMessage) != NULL) sprintf ((*errorMessage), "Error writing file '%s' (%s)", fileName, strerror (errno));
+		else ret = CSVRET_OUT_OF_MEMORY;
+	}
+	binFree (fileName);
+	return ret;
+}
+
+/*=========================================================================
+	Synthesize the files
+=========================================================================*/
+int md380_SynthesizeFiles (const char* dirName, char separator, char** errorMessage)
+{
+	TRDTFile* container;
+	t_buffer* image;
+	MD380_MemBuffer csv;
+	unsigned i;
+	int ret = CSVRET_OK;
+	
+	assert (errorMessage != NULL);
+	assert ((*errorMessage) == NULL);
+	
+	container = (TRDTFile*)binAlloc (sizeof (TRDTFile));
+	image = (t_buffer*)binAlloc (FILE_SIZE_TRDTFile);
+	INIT_MD380_MemBuffer (&csv);
+	if (container == NULL || image == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+	
+	if (md380_SynthesizeContainer (container) != 0) {
+		(*errorMessage) = (char*)binAlloc (128);
+		if ((*errorMessage) == NULL) {ret = CSVRET_OUT_OF_MEMORY; goto exitFunc;}
+		sprintf ((*errorMessage), "The synthetic container violates the rules");
+		ret = MD380ERR_RULES_VIOLATION;
+		goto exitFunc;
+	}
+	memset (image, 0, FILE_SIZE_TRDTFile);
+	encodeBinary_TRDTFile (image, container);
+	ret = md380_SynthWriteFile (dirName, MD380_SYNTH_IMAGE_NAME, image, FILE_SIZE_TRDTFile, errorMessage);
+	
+	/* The .csv files are those exported from the image: some fields, */
+	/* as the passwords, are changed by the encoding. The container is */
+	/* already bound: it is cleared before decoding the image again */
+	memset (container, 0, sizeof (TRDTFile));
+	decodeBinary_TRDTFile (image, container);
+	bindReferences (container, md380_SynthCountFunc, NULL);
+	for (i=0; i<NO_OF_CSV_STREAMS && ret == CSVRET_OK; i++) {
+		char name [32];
+		csv.length = 0;
+		ret = csvStreamFuncs[i].saveCSVStream (csvStreamFuncs[i].recordName, container, separator, md380_MemWriteBinaryFunc, &csv, errorMessage);
+		if (ret != CSVRET_OK) break;
+		sprintf (name, "%s.csv", cliCommands[i].parameter+1);
+		ret = md380_SynthWriteFile (dirName, name, csv.data, csv.length, errorMessage);
+	}
+
+exitFunc:
+	if (container) binFree (container);
+	if (image) binFree (image);
+	FREE_MD380_MemBuffer (&csv);
+	return ret;
+}
@@ -0,0 +1,64 @@
+/* 
+	This Program is written and owned by Davide Achilli and is released
+	under the GPL v.3 license agreement (see gpl-3.0.txt).
+	
+	IN NO EVENT SHALL THE AUTHOR BE LIABLE TO ANY PARTY FOR DIRECT, 
+	INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING 
+	OUT OF THE USE OF TH_IS_SOFTWARE, ITS DOCUMENTATION, OR ANY
+	DERIVATIVES THEREOF, EVEN IF THE AUTHOR HAS BEEN ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+	
+	THE AUTHOR SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT 
+	NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.  
+	TH_IS_SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, AND THE AUTHOR 
+	HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, 
+	ENHANCEMENTS, OR MODIFICATIONS.
+*******************************************************************************/
+#ifndef __MD380_SYNTH_H
+#define __MD380_SYNTH_H
+#include "md380.h"
+#include "md380_tools.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*=========================================================================
+	Synthetic codeplugs, the worst case for the benchmark (see
+	md380_bench.c).
+	
+	Every record of every table is used: 1000 channels with tones,
+	1000 contacts, 250 RX group lists of 32 contacts, 250 scan lists
+	of 31 channels, 250 zones of 16 channels and 50 text messages.
+	The names hold quotes, separators and a non ASCII character, so
+	that every field of the CSV files is quoted and escaped. The
+	values are enumerated or in range, so that the container passes
+	the validation and survives a round trip through the CSV files.
+=========================================================================*/
+
+/* Name of the image written by md380_SynthesizeFiles */
+#define MD380_SYNTH_IMAGE_NAME  "bench.rdt"
+
+/*=========================================================================
+	Fills 'container' with the synthetic records and binds their
+	references. Returns the number of rules violations, 0 unless the
+	generator is out of step with the rules.
+=========================================================================*/
+extern int md380_SynthesizeContainer (TRDTFile* container);
+
+/*=========================================================================
+	Writes to directory 'dirName' the synthetic image, named
+	MD380_SYNTH_IMAGE_NAME, and its .csv files, named after the
+	<csv-files> options (ch.csv, cont.csv...).
+	Returns CSVRET_xxx and MD380ERR_xxx values. The 'errorMessage'
+	string is allocated with binAlloc in case of error and it is to be
+	freed with binFree.
+=========================================================================*/
+extern int md380_SynthesizeFiles (const char* dirName, char separator, char** errorMessage);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
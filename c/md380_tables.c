@@ -42,6 +42,15 @@ void FREE_MD380Tables (MD380Tables* tables)
 	Returns number of errors.
 ==================================================================*/
 int registerContainerNames (MD380Tables* tab, const TRDTFile* container, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+{
+	return registerContainerNamesTables (tab, container, TABLES_ALL_TRDTFile, reportErrorFunc, reportErrorParam);
+}
+
+/*==================================================================
+	Same as registerContainerNames, limited to the record types
+	selected by tableMask (TABLE_xxx bits)
+==================================================================*/
+int registerContainerNamesTables (MD380Tables* tab, const TRDTFile* container, unsigned tableMask, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
 {
 	unsigned i;
 	int ret;
@@ -53,65 +62,73 @@ int registerContainerNames (MD380Tables* tab, const TRDTFile* container, ReportE
 	/*-------------------------------------------------------------------
 		ChannelInformation
 	-------------------------------------------------------------------*/
-	for (i=0; i<container->ChannelInformation_COUNT; i++) {
-		ret = ADD_LookupTableUnicode (&tab->TAB_ChannelInformation, container->ChannelInformation[i].Name, i+1);
-		if (ret < 0) {
-			reportErrorFunc (reportErrorParam, "ChannelInformation", i, "Name", "Lookup table overflow");
-			noOfViolations++;
-			break;
-		}
-		else if (ret > 0) {
-			sprintf (buf, "Dupe entry (already found at line %d)", ret);
-			reportErrorFunc (reportErrorParam, "ChannelInformation", i, "Name", buf);
-			noOfViolations++;
+	if (tableMask & TABLE_ChannelInformation) {
+		for (i=0; i<container->ChannelInformation_COUNT; i++) {
+			ret = ADD_LookupTableUnicode (&tab->TAB_ChannelInformation, container->ChannelInformation[i].Name, i+1);
+			if (ret < 0) {
+				reportErrorFunc (reportErrorParam, "ChannelInformation", i, "Name", "Lookup table overflow");
+				noOfViolations++;
+				break;
+			}
+			else if (ret > 0) {
+				sprintf (buf, "Dupe entry (already found at line %d)", ret);
+				reportErrorFunc (reportErrorParam, "ChannelInformation", i, "Name", buf);
+				noOfViolations++;
+			}
 		}
 	}
 	/*-------------------------------------------------------------------
 		DigitalContact
 	-------------------------------------------------------------------*/
-	for (i=0; i<container->DigitalContact_COUNT; i++) {
-		ret = ADD_LookupTableNumeric (&tab->TAB_DigitalContact, container->DigitalContact[i].CallId, i+1);
-		if (ret < 0) {
-			reportErrorFunc (reportErrorParam, "DigitalContact", i, "CallId", "Lookup table overflow");
-			noOfViolations++;
-			break;
-		}
-		else if (ret > 0) {
-			sprintf (buf, "Dupe entry (already found at line %d)", ret);
-			reportErrorFunc (reportErrorParam, "DigitalContact", i, "CallId", buf);
-			noOfViolations++;
+	if (tableMask & TABLE_DigitalContact) {
+		for (i=0; i<container->DigitalContact_COUNT; i++) {
+			ret = ADD_LookupTableNumeric (&tab->TAB_DigitalContact, container->DigitalContact[i].CallId, i+1);
+			if (ret < 0) {
+				reportErrorFunc (reportErrorParam, "DigitalContact", i, "CallId", "Lookup table overflow");
+				noOfViolations++;
+				break;
+			}
+			else if (ret > 0) {
+				sprintf (buf, "Dupe entry (already found at line %d)", ret);
+				reportErrorFunc (reportErrorParam, "DigitalContact", i, "CallId", buf);
+				noOfViolations++;
+			}
 		}
 	}
 	/*-------------------------------------------------------------------
 		DigitalRxGroupList
 	-------------------------------------------------------------------*/
-	for (i=0; i<container->DigitalRxGroupList_COUNT; i++) {
-		ret = ADD_LookupTableUnicode (&tab->TAB_DigitalRxGroupList, container->DigitalRxGroupList[i].Name, i+1);
-		if (ret < 0) {
-			reportErrorFunc (reportErrorParam, "DigitalRxGroupList", i, "Name", "Lookup table overflow");
-			noOfViolations++;
-			break;
-		}
-		else if (ret > 0) {
-			sprintf (buf, "Dupe entry (already found at line %d)", ret);
-			reportErrorFunc (reportErrorParam, "DigitalRxGroupList", i, "Name", buf);
-			noOfViolations++;
+	if (tableMask & TABLE_DigitalRxGroupList) {
+		for (i=0; i<container->DigitalRxGroupList_COUNT; i++) {
+			ret = ADD_LookupTableUnicode (&tab->TAB_DigitalRxGroupList, container->DigitalRxGroupList[i].Name, i+1);
+			if (ret < 0) {
+				reportErrorFunc (reportErrorParam, "DigitalRxGroupList", i, "Name", "Lookup table overflow");
+				noOfViolations++;
+				break;
+			}
+			else if (ret > 0) {
+				sprintf (buf, "Dupe entry (already found at line %d)", ret);
+				reportErrorFunc (reportErrorParam, "DigitalRxGroupList", i, "Name", buf);
+				noOfViolations++;
+			}
 		}
 	}
 	/*-------------------------------------------------------------------
 		ScanList
 	-------------------------------------------------------------------*/
-	for (i=0; i<container->ScanList_COUNT; i++) {
-		ret = ADD_LookupTableUnicode (&tab->TAB_ScanList, container->ScanList[i].Name, i+1);
-		if (ret < 0) {
-			reportErrorFunc (reportErrorParam, "ScanList", i, "Name", "Lookup table overflow");
-			noOfViolations++;
-			break;
-		}
-		else if (ret > 0) {
-			sprintf (buf, "Dupe entry (already found at line %d)", ret);
-			reportErrorFunc (reportErrorParam, "ScanList", i, "Name", buf);
-			noOfViolations++;
+	if (tableMask & TABLE_ScanList) {
+		for (i=0; i<container->ScanList_COUNT; i++) {
+			ret = ADD_LookupTableUnicode (&tab->TAB_ScanList, container->ScanList[i].Name, i+1);
+			if (ret < 0) {
+				reportErrorFunc (reportErrorParam, "ScanList", i, "Name", "Lookup table overflow");
+				noOfViolations++;
+				break;
+			}
+			else if (ret > 0) {
+				sprintf (buf, "Dupe entry (already found at line %d)", ret);
+				reportErrorFunc (reportErrorParam, "ScanList", i, "Name", buf);
+				noOfViolations++;
+			}
 		}
 	}
 
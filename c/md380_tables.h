@@ -38,6 +38,12 @@ extern void FREE_MD380Tables (MD380Tables* tables);
 ==================================================================*/
 extern int registerContainerNames (MD380Tables* tab, const TRDTFile* container, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
 
+/*==================================================================
+	Same as registerContainerNames, limited to the record types
+	selected by tableMask (TABLE_xxx bits)
+==================================================================*/
+extern int registerContainerNamesTables (MD380Tables* tab, const TRDTFile* container, unsigned tableMask, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
 #ifdef __cplusplus
 }
 #endif
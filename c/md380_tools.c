@@ -18,6 +18,7 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include "md380_tools.h"
 #include "crc.h"
+#include "md380_stats.h"
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -36,6 +37,16 @@ void FREE_MD380_Configuration(MD380_Configuration* config)
 {
 	FREE_CSVFileNames(&config->csvFileNames);
 	if (config->rdtFileName) {binFree (config->rdtFileName); config->rdtFileName=NULL;}
+	if (config->overlayFileName) {binFree (config->overlayFileName); config->overlayFileName=NULL;}
+	if (config->bundleFileName) {binFree (config->bundleFileName); config->bundleFileName=NULL;}
+	if (config->columnarFileName) {binFree (config->columnarFileName); config->columnarFileName=NULL;}
+	if (config->fieldRecordName) {binFree (config->fieldRecordName); config->fieldRecordName=NULL;}
+	if (config->fieldName) {binFree (config->fieldName); config->fieldName=NULL;}
+	if (config->fieldValue) {binFree (config->fieldValue); config->fieldValue=NULL;}
+	if (config->cacheDirName) {binFree (config->cacheDirName); config->cacheDirName=NULL;}
+	if (config->serverSocketName) {binFree (config->serverSocketName); config->serverSocketName=NULL;}
+	if (config->stampFileName) {binFree (config->stampFileName); config->stampFileName=NULL;}
+	if (config->jobsFileName) {binFree (config->jobsFileName); config->jobsFileName=NULL;}
 }
 
 /*=================================================================================
@@ -56,6 +67,7 @@ static int md380_CsvWriteReferenceFieldCommon (int* exitNow, const FieldDescript
 	if (fieldDescriptor->enumCount > 0) {
 		unsigned i;
 		
+		MD380_STATS_ADD (enumLookups, 1);
 		/* Find the enumeration among all values */
 		for (i=0; i<fieldDescriptor->enumCount; i++) {
 			if (fieldDescriptor->fieldEnumerators[i].enumValue == fieldValue->refLineNo) {
@@ -142,6 +154,7 @@ int md380_CsvWriteNumericField (const FieldDescriptor* fieldDescriptor, t_numeri
 		ret = csvWriteTokenUnsigned ((unsigned)fieldValue, writeBinaryFunc, writeBinaryFuncParameter);
 	}
 	else {
+		MD380_STATS_ADD (enumLookups, 1);
 		/* Find the enumeration among all values */
 		for (i=0; i<fieldDescriptor->enumCount; i++) {
 			if (fieldDescriptor->fieldEnumerators[i].enumValue == fieldValue) {
@@ -203,6 +216,9 @@ const char* md380_CsvRetToString (int ret)
 		case MD380ERR_FILE_ERROR     : desc = "MD380ERR_FILE_ERROR"; break;
 		case MD380ERR_INVALID_CSV_HEADER: desc = "MD380ERR_INVALID_CSV_HEADER"; break;
 		case MD380ERR_INVALID_CSV_FORMAT: desc = "MD380ERR_INVALID_CSV_FORMAT"; break;
+		case MD380ERR_FIELD_NOT_FOUND: desc = "MD380ERR_FIELD_NOT_FOUND"; break;
+		case MD380ERR_INVALID_VALUE  : desc = "MD380ERR_INVALID_VALUE"; break;
+		case MD380ERR_RULES_VIOLATION: desc = "MD380ERR_RULES_VIOLATION"; break;
 		default: desc = "UNKNWOWN_RET";
 	}
 	return desc;
@@ -216,6 +232,7 @@ int md380_FILEReadCharFunc (void* f)
 {
 	int ret = fgetc ((FILE*)f);
 	if (ret == EOF) return csvEOF;
+	MD380_STATS_ADD (bytesRead, 1);
 	return ret;
 }
 
@@ -225,6 +242,7 @@ int md380_FILEReadCharFunc (void* f)
 int md380_FILEWriteBinaryFunc (void* f, const char* buffer, unsigned length)
 {
 	int ret = fwrite (buffer, 1, length, (FILE*)f);
+	MD380_STATS_ADD (bytesWritten, length);
 	return (ret != (int)length);
 }
 
@@ -352,9 +370,9 @@ exitFunc:
 int md380_ReadFieldUnicode (const FieldDescriptor* fieldDescriptor, t_unicode* fieldPointer, unsigned unicodeChars, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
 {
 	int ret = CSVRET_OK;
-	#define BUFFER_SIZE 128
-	char buffer[BUFFER_SIZE];
-	int i;
+	/* Each t_unicode takes at most 3 octets in UTF-8 */
+	#define UNICODE_BUFFER_SIZE 512
+	char buffer[UNICODE_BUFFER_SIZE];
 	int fieldLength;
 	int errorLength = strlen (fieldDescriptor->fieldName) + strlen(fileName) + 256;
 	
@@ -362,8 +380,9 @@ int md380_ReadFieldUnicode (const FieldDescriptor* fieldDescriptor, t_unicode* f
 	assert (errorMessage != NULL);
 	assert ((*errorMessage) == NULL);
 	assert (fieldDescriptor->fieldType == BL_unicode);
+	assert (unicodeChars*3 < UNICODE_BUFFER_SIZE);
 	
-	ret = csvReadToken (buffer, BUFFER_SIZE, &fieldLength, separator, readCharFunc, readCharFuncParameter);
+	ret = csvReadToken (buffer, UNICODE_BUFFER_SIZE, &fieldLength, separator, readCharFunc, readCharFuncParameter);
 	switch (ret) {
 		case CSVRET_OK: break;
 		case CSVRET_EOF: {
@@ -379,16 +398,12 @@ int md380_ReadFieldUnicode (const FieldDescriptor* fieldDescriptor, t_unicode* f
 		}
 	}
 	
-	if (fieldLength > (int)unicodeChars) {
+	if (fieldLength >= UNICODE_BUFFER_SIZE || utf8ToUnicode (fieldPointer, unicodeChars, buffer, fieldLength) > unicodeChars) {
 		(*errorMessage) = (char*)binAlloc (errorLength);
 		if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
 		sprintf ((*errorMessage), "file %s, line %u, field '%s' too long", fileName, lineNo, fieldDescriptor->fieldName);
 		return MD380ERR_INVALID_CSV_FORMAT;
 	}
-
-	for (i=0; i<fieldLength; i++) {
-		fieldPointer[i] = (unsigned char)buffer[i];
-	}
 	
 	return ret;
 }
@@ -460,15 +475,14 @@ int md380_ReadFieldReferenceUnicode (const FieldDescriptor* fieldDescriptor, t_r
 	#define BUFFER_SIZE 128
 	char buffer[BUFFER_SIZE];
 	int fieldLength;
-	int i;
+	t_unicode name[BUFFER_SIZE];
 
 	ret = md380_ReadFieldReferenceCommon (buffer, BUFFER_SIZE, &fieldLength, fieldDescriptor, fieldPointer, fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);
 
-	fieldPointer->refId = crc32_AddAsciizLowerCase (0, buffer);
-	for (i=0; i<fieldLength && i<BL_TEXT_SAMPLE_LEN; i++) {
-		fieldPointer->textSample[i] = buffer[i];
-	}
-	fieldPointer->textSample[i] = '\0';
+	/* Hash the decoded name, so that ISO-8859-1 files match too */
+	utf8ToUnicode (name, BUFFER_SIZE-1, buffer, fieldLength < BUFFER_SIZE ? fieldLength : BUFFER_SIZE-1);
+	fieldPointer->refId = crc32_AddUnicodeLowerCase (0, name);
+	fieldPointer->csvLineNo = (unsigned short)(lineNo < 0xFFFF ? lineNo : 0xFFFF);
 	
 	return ret;
 }
@@ -495,14 +509,19 @@ int md380_ReadFieldReferenceNumeric (const FieldDescriptor* fieldDescriptor, t_r
 	#define BUFFER_SIZE 128
 	char buffer[BUFFER_SIZE];
 	int fieldLength;
+	int valueRead;
 	int i;
 	int errorLength = strlen (fieldDescriptor->fieldName) + strlen(fileName) + 256;
 
 	ret = md380_ReadFieldReferenceCommon (buffer, BUFFER_SIZE, &fieldLength, fieldDescriptor, fieldPointer, fileName, lineNo, separator, readCharFunc, readCharFuncParameter, errorMessage);
 
+	/* The last field of a line comes with CSVRET_EOL or CSVRET_EOF */
+	valueRead = (ret == CSVRET_OK || ret == CSVRET_EOL || ret == CSVRET_EOF);
+
 	/* If the field supports some enumeration, calculate the CRC */
-	if (ret == CSVRET_OK && fieldDescriptor->enumCount) {
+	if (valueRead && fieldDescriptor->enumCount) {
 		unsigned textCrc = crc32_AddAsciizLowerCase (0, buffer);
+		MD380_STATS_ADD (enumLookups, 1);
 		for (i=0; i<(int)fieldDescriptor->enumCount; i++) {
 			if (fieldDescriptor->fieldEnumerators[i].enumNameCRC == textCrc) {
 				fieldPointer->refId = fieldDescriptor->fieldEnumerators[i].enumValue;
@@ -511,7 +530,7 @@ int md380_ReadFieldReferenceNumeric (const FieldDescriptor* fieldDescriptor, t_r
 		}
 	}
 	
-	if (ret == CSVRET_OK) {
+	if (valueRead) {
 		char* endPtr;
 		fieldPointer->refId = strtoul (buffer, &endPtr, 10);
 		if ((*endPtr) != '\0') {
@@ -520,10 +539,6 @@ int md380_ReadFieldReferenceNumeric (const FieldDescriptor* fieldDescriptor, t_r
 			sprintf ((*errorMessage), "file %s, line %u, field '%s': invalid value '%s'", fileName, lineNo, fieldDescriptor->fieldName, buffer);
 			return MD380ERR_INVALID_CSV_FORMAT;
 		}
-		for (i=0; i<fieldLength && i<BL_TEXT_SAMPLE_LEN; i++) {
-			fieldPointer->textSample[i] = buffer[i];
-		}
-		fieldPointer->textSample[i] = '\0';
 	}
 	
 exitFunc:
@@ -531,13 +546,55 @@ exitFunc:
 
 }
 
+/*=========================================================================
+	Numeric fields accessors
+=========================================================================*/
+t_numeric md380_GetNumeric (const void* fieldPointer, unsigned fieldSize)
+{
+	switch (fieldSize) {
+		case sizeof (t_numeric8): return *(const t_numeric8*)fieldPointer;
+		case sizeof (t_numeric16): return *(const t_numeric16*)fieldPointer;
+		default: assert (fieldSize == sizeof (t_numeric32)); return *(const t_numeric32*)fieldPointer;
+	}
+}
+
+int md380_SetNumeric (void* fieldPointer, unsigned fieldSize, t_numeric value)
+{
+	switch (fieldSize) {
+		case sizeof (t_numeric8):
+			if (value > 0xFF) return -1;
+			*(t_numeric8*)fieldPointer = (t_numeric8)value;
+			break;
+		case sizeof (t_numeric16):
+			if (value > 0xFFFF) return -1;
+			*(t_numeric16*)fieldPointer = (t_numeric16)value;
+			break;
+		default:
+			assert (fieldSize == sizeof (t_numeric32));
+			if (value > 0xFFFFFFFFUL) return -1;
+			*(t_numeric32*)fieldPointer = (t_numeric32)value;
+			break;
+	}
+	return 0;
+}
+
+/*=========================================================================
+	Number of records of a type
+=========================================================================*/
+unsigned md380_RecordCount (const RecordDescriptor* rd, const TRDTFile* container)
+{
+	if (rd->countOffset == RD_NO_COUNT) return 1;
+	return *(const unsigned*)((const unsigned char*)container+rd->countOffset);
+}
+
 /*=========================================================================
 	Reads one numeric field from a CSV source
 	
 	PARAMTERS
 	
 	fieldDescriptors   pointer to the FieldDescriptor for this field
-	fieldPointer       pointer to the t_numeric field
+	fieldPointer       pointer to the t_numericN field
+	fieldSize          size of the field in octets; values not fitting in it are rejected
 	lineNo             line number in the CSV file (used for error reporting)
 	separator          separator used in the CSV file
 	readCharFunc       See csvReadToken
@@ -545,13 +602,14 @@ exitFunc:
 	
 	Returns CSVRET_xxx and MD380ERR_xxx values.
 =========================================================================*/
-int md380_ReadFieldNumeric (const FieldDescriptor* fieldDescriptor, t_numeric* fieldPointer, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
+int md380_ReadFieldNumeric (const FieldDescriptor* fieldDescriptor, void* fieldPointer, unsigned fieldSize, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage)
 {
 	int ret = CSVRET_OK;
 	#define BUFFER_SIZE 128
 	char buffer[BUFFER_SIZE];
 	unsigned i;
 	int fieldLength;
+	t_numeric value;
 	int errorLength = strlen (fieldDescriptor->fieldName) + strlen(fileName) + 256;
 	
 	assert (errorMessage != NULL);
@@ -577,6 +635,7 @@ int md380_ReadFieldNumeric (const FieldDescriptor* fieldDescriptor, t_numeric* f
 	/* If the field supports some enumeration, calculate the CRC */
 	if (fieldDescriptor->enumCount) {
 		unsigned textCrc = crc32_AddAsciizLowerCase (0, buffer);
+		MD380_STATS_ADD (enumLookups, 1);
 		for (i=0; i<fieldDescriptor->enumCount; i++) {
 			if (fieldDescriptor->fieldEnumerators[i].enumNameCRC == textCrc) break;
 		}
@@ -602,13 +661,13 @@ int md380_ReadFieldNumeric (const FieldDescriptor* fieldDescriptor, t_numeric* f
 			return MD380ERR_INVALID_CSV_FORMAT;
 		}
 		else {
-			(*fieldPointer) = fieldDescriptor->fieldEnumerators[i].enumValue;
+			value = fieldDescriptor->fieldEnumerators[i].enumValue;
 		}
 	}
 	/* Normal value */
 	else {
 		char* endPtr;
-		(*fieldPointer) = strtoul (buffer, &endPtr, 10);
+		value = strtoul (buffer, &endPtr, 10);
 		if ((*endPtr) != '\0') {
 			(*errorMessage) = (char*)binAlloc (errorLength+strlen (buffer));
 			if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
@@ -617,6 +676,13 @@ int md380_ReadFieldNumeric (const FieldDescriptor* fieldDescriptor, t_numeric* f
 		}
 	}
 	
+	if (md380_SetNumeric (fieldPointer, fieldSize, value) != 0) {
+		(*errorMessage) = (char*)binAlloc (errorLength+strlen (buffer));
+		if ((*errorMessage) == NULL) return CSVRET_OUT_OF_MEMORY;
+		sprintf ((*errorMessage), "file %s, line %u, field '%s': value '%s' out of range", fileName, lineNo, fieldDescriptor->fieldName, buffer);
+		return MD380ERR_INVALID_CSV_FORMAT;
+	}
+	
 	return ret;
 }
 
@@ -649,9 +715,16 @@ int md380_ResolveReference (const FieldDescriptor* fieldDescriptor, t_reference*
 
 	lineNo = FIND_LookupTableId(tab, ref->refId, &ref->resolvedName);
 	if (lineNo == 0) {
-		char* txt = (char*)binAlloc (BL_TEXT_SAMPLE_LEN+60+strlen(searchedTable));
+		char* txt = (char*)binAlloc (strlen(fieldDescriptor->fieldName)+80+strlen(searchedTable));
 		if (txt) {
-			sprintf (txt, "name '%s%s' not found in table %s", ref->textSample, (strlen(ref->textSample)>=BL_TEXT_SAMPLE_LEN ? "..." : ""), searchedTable);
+			/* Names read from a CSV file are reported by their cell; */
+			/* otherwise the key is refId */
+			if (ref->csvLineNo == 0) {
+				sprintf (txt, "name '%u' not found in table %s", ref->refId, searchedTable);
+			}
+			else {
+				sprintf (txt, "name in CSV line %u, column %s not found in table %s", (unsigned)ref->csvLineNo, fieldDescriptor->fieldName, searchedTable);
+			}
 			reportErrorFunc (reportErrorParam, recordType, recordNumber, fieldName, txt);
 			binFree(txt);
 			ret = 1;
@@ -664,6 +737,18 @@ int md380_ResolveReference (const FieldDescriptor* fieldDescriptor, t_reference*
 	return ret;
 }
 
+/*==================================================================
+	True if a bound reference holds an enumeration value
+==================================================================*/
+int md380_IsEnumReference (const FieldDescriptor* fieldDescriptor, const t_reference* ref)
+{
+	unsigned i;
+	for (i=0; i<fieldDescriptor->enumCount; i++) {
+		if (fieldDescriptor->fieldEnumerators[i].enumValue == ref->refLineNo) return 1;
+	}
+	return 0;
+}
+
 /*==================================================================
 	Bind the references in a container
 	Returns 0 if ok, < 0 in case of error
@@ -676,15 +761,7 @@ static int md380_BindReferenceCommon (const FieldDescriptor* fieldDescriptor, t_
 	assert (ref->refId == 0);
 
 	/* Verify if the value is a valid enumeration */
-	if (fieldDescriptor->enumCount > 0) {
-		unsigned i;
-		for (i=0; i<fieldDescriptor->enumCount; i++) {
-			if (fieldDescriptor->fieldEnumerators[i].enumValue == ref->refLineNo) {
-				ret = 1;
-				goto exitFunc;
-			}
-		}
-	}
+	if (md380_IsEnumReference (fieldDescriptor, ref)) {ret=1; goto exitFunc;}
 
 	if (ref->refLineNo == 0) {ret=1; goto exitFunc;}
 
@@ -705,21 +782,16 @@ exitFunc:
 
 
 /*==================================================================
-	Bind the references in a container
+	Bind a reference to the key of the referenced record
 	Returns 0 if ok, != 0 in case of error
 ==================================================================*/
-int md380_BindReferenceUnicode (const FieldDescriptor* fieldDescriptor, t_reference* ref, unsigned noOfRecsInReferencedTable, const t_unicode* referencedString, const char* recordType, int recordNumber, const char* fieldName, const char* searchedTable, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+int md380_BindReferenceKey (const FieldDescriptor* fieldDescriptor, t_reference* ref, unsigned noOfRecsInReferencedTable, const t_unicode* referencedString, unsigned referencedId, const char* recordType, int recordNumber, const char* fieldName, const char* searchedTable, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
 {
 	unsigned ret = md380_BindReferenceCommon (fieldDescriptor, ref, noOfRecsInReferencedTable, recordType, recordNumber, fieldName, searchedTable, reportErrorFunc, reportErrorParam);
 
 	if (ret == 0) {
-		unsigned i;
 		ref->resolvedName = referencedString;
-		ref->refId = crc32_AddUnicodeLowerCase (0, referencedString);
-		for (i=0; referencedString[i] && i<BL_TEXT_SAMPLE_LEN; i++) {
-			ref->textSample[i] = (char)(unsigned char)referencedString[i];
-		}
-		ref->textSample[i] = '\0';
+		ref->refId = referencedId;
 	}
 	else if (ret > 0) {ret = 0;}
 
@@ -730,19 +802,17 @@ int md380_BindReferenceUnicode (const FieldDescriptor* fieldDescriptor, t_refere
 	Bind the references in a container
 	Returns 0 if ok, != 0 in case of error
 ==================================================================*/
-int md380_BindReferenceNumeric (const FieldDescriptor* fieldDescriptor, t_reference* ref, unsigned noOfRecsInReferencedTable, t_numeric referencedValue, const char* recordType, int recordNumber, const char* fieldName, const char* searchedTable, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+int md380_BindReferenceUnicode (const FieldDescriptor* fieldDescriptor, t_reference* ref, unsigned noOfRecsInReferencedTable, const t_unicode* referencedString, const char* recordType, int recordNumber, const char* fieldName, const char* searchedTable, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
 {
-	unsigned ret = md380_BindReferenceCommon (fieldDescriptor, ref, noOfRecsInReferencedTable, recordType, recordNumber, fieldName, searchedTable, reportErrorFunc, reportErrorParam);
-
-	if (ret == 0) {
-		char buf [65];
-		ref->resolvedName = NULL;
-		ref->refId = (unsigned)referencedValue;
-		sprintf (buf, "%u", (unsigned)referencedValue);
-		strncpy (ref->textSample, buf, BL_TEXT_SAMPLE_LEN);
-		ref->textSample[BL_TEXT_SAMPLE_LEN] = '\0';
-	}
-	else if (ret > 0) {ret = 0;}
+	return md380_BindReferenceKey (fieldDescriptor, ref, noOfRecsInReferencedTable, referencedString, crc32_AddUnicodeLowerCase (0, referencedString), recordType, recordNumber, fieldName, searchedTable, reportErrorFunc, reportErrorParam);
+}
 
-	return ret;
+/*==================================================================
+	Bind the references in a container. The text sample is left
+	empty: the value is printed from refId if an error is reported
+	Returns 0 if ok, != 0 in case of error
+==================================================================*/
+int md380_BindReferenceNumeric (const FieldDescriptor* fieldDescriptor, t_reference* ref, unsigned noOfRecsInReferencedTable, t_numeric referencedValue, const char* recordType, int recordNumber, const char* fieldName, const char* searchedTable, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+{
+	return md380_BindReferenceKey (fieldDescriptor, ref, noOfRecsInReferencedTable, NULL, (unsigned)referencedValue, recordType, recordNumber, fieldName, searchedTable, reportErrorFunc, reportErrorParam);
 }
@@ -31,6 +31,9 @@
 #define MD380ERR_FILE_ERROR          (-10002)
 #define MD380ERR_INVALID_CSV_HEADER  (-10003)
 #define MD380ERR_INVALID_CSV_FORMAT  (-10004)
+#define MD380ERR_FIELD_NOT_FOUND     (-10005)
+#define MD380ERR_INVALID_VALUE       (-10006)
+#define MD380ERR_RULES_VIOLATION     (-10007)
 
 #define MD380_UNUSED_FIELD 0xFFFFFFFF
 #define MD380_CSV_BUFFER_SIZE 192
@@ -39,6 +42,10 @@
 #define FILE_SIZE_TBINFile 262144
 #define FILE_OFST_TBINFile 0x225
 
+/* Exit status of an update, rename, delete or sort run with -exitcode */
+/* that did not change the file; 0 is then returned only if it changed */
+#define MAIN_NOT_CHANGED 3
+
 /* Pointer to function for reporting validation errors */
 typedef void (*ReportErrorFunc)(void* reportErrorParam, const char* recordType, int recordNumber, const char* fieldName, const char* text);
 
@@ -53,7 +60,54 @@ typedef struct {
 	char* rdtFileName;
 	
 	/* False if read, true if export */
-	enum {modeUnset, modeExport, modeUpdate} updateMode;
+	enum {modeUnset, modeExport, modeUpdate, modeGenerate, modeGet, modeSet, modeRename, modeDelete, modeSort, modeCheck, modeServer} updateMode;
+	
+	/* Filename of the overlay .csv file (modeGenerate only) */
+	char* overlayFileName;
+	
+	/* Filename of the bundle with all the tables, NULL if not used */
+	char* bundleFileName;
+	
+	/* Filename of the columnar export (modeExport only), NULL if not used */
+	char* columnarFileName;
+	
+	/* Record type, 1-based line, field and new value (modeGet, modeSet, */
+	/* modeRename, modeDelete and modeSort; the line is not used by */
+	/* modeSort, the field is used by modeGet, modeSet and modeSort, */
+	/* the value by modeSet and, as the new name, by modeRename) */
+	char* fieldRecordName;
+	unsigned fieldRecordNo;
+	char* fieldName;
+	char* fieldValue;
+	
+	/* Directory of the snapshot cache (modeExport and modeCheck), NULL if not used */
+	char* cacheDirName;
+	
+	/* Members of a zone, scan list and RX group list above which the */
+	/* list is reported (modeCheck only), 0 to not check it */
+	unsigned maxZoneChannels;
+	unsigned maxScanChannels;
+	unsigned maxGroupContacts;
+	
+	/* Socket name and number of workers (modeServer only; 0 for the default) */
+	char* serverSocketName;
+	unsigned serverWorkers;
+	
+	/* Stamp file, jobs file and flag to run the jobs even if up to date */
+	/* (modeExport and modeUpdate only), NULL if not used */
+	char* stampFileName;
+	char* jobsFileName;
+	int forceJobs;
+	
+	/* Set to print the run statistics at the end (see md380_stats.h) */
+	int showStats;
+	
+	/* Set to exit with MAIN_NOT_CHANGED if the file is not changed */
+	/* (modeUpdate, modeRename, modeDelete and modeSort only) */
+	int exitIfNotChanged;
+	
+	/* Asynchronous I/O of the jobs file, MD380_AIO_xxx (see md380_aio.h) */
+	int aioBackend;
 	
 	/* CSV File Names */
 	CSVFileNames csvFileNames;
@@ -153,13 +207,28 @@ extern int md380_ReadFieldUnicode (const FieldDescriptor* fieldDescriptor, t_uni
 extern int md380_ReadFieldReferenceUnicode (const FieldDescriptor* fieldDescriptor, t_reference* fieldPointer, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
 extern int md380_ReadFieldReferenceNumeric (const FieldDescriptor* fieldDescriptor, t_reference* fieldPointer, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
 
+/*=========================================================================
+	Reads and writes a numeric field stored as t_numeric8, t_numeric16 or
+	t_numeric32 (fieldSize octets). md380_SetNumeric returns 0 if ok,
+	!= 0 if the value does not fit in the field, which is left untouched.
+=========================================================================*/
+extern t_numeric md380_GetNumeric (const void* fieldPointer, unsigned fieldSize);
+extern int md380_SetNumeric (void* fieldPointer, unsigned fieldSize, t_numeric value);
+
+/*=========================================================================
+	Number of records of the type 'rd' present in the container (always
+	1 for single records)
+=========================================================================*/
+extern unsigned md380_RecordCount (const RecordDescriptor* rd, const TRDTFile* container);
+
 /*=========================================================================
 	Reads one numeric field from a CSV source
 	
 	PARAMTERS
 	
 	fieldDescriptors   pointer to the FieldDescriptor for this field
-	fieldPointer       pointer to the t_numeric field
+	fieldPointer       pointer to the t_numericN field
+	fieldSize          size of the field in octets; values not fitting in it are rejected
 	lineNo             line number in the CSV file (used for error reporting)
 	separator          separator used in the CSV file
 	readCharFunc       See csvReadToken
@@ -167,7 +236,7 @@ extern int md380_ReadFieldReferenceNumeric (const FieldDescriptor* fieldDescript
 	
 	Returns CSVRET_xxx and MD380ERR_xxx values.
 =========================================================================*/
-extern int md380_ReadFieldNumeric (const FieldDescriptor* fieldDescriptor, t_numeric* fieldPointer, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
+extern int md380_ReadFieldNumeric (const FieldDescriptor* fieldDescriptor, void* fieldPointer, unsigned fieldSize, const char* fileName, unsigned lineNo, char separator, ReadCharFunc readCharFunc, void* readCharFuncParameter, char** errorMessage);
 
 
 /*==================================================================
@@ -176,6 +245,19 @@ extern int md380_ReadFieldNumeric (const FieldDescriptor* fieldDescriptor, t_num
 ==================================================================*/
 extern int md380_ResolveReference (const FieldDescriptor* fieldDescriptor, t_reference* ref, const LookupTable* tab, const char* recordType, int recordNumber, const char* fieldName, const char* searchedTable, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
 
+/*==================================================================
+	True if a bound reference holds a value of the enumeration of its
+	field (e.g. "None") rather than a line number
+==================================================================*/
+extern int md380_IsEnumReference (const FieldDescriptor* fieldDescriptor, const t_reference* ref);
+
+/*==================================================================
+	Bind a reference to the key of the referenced record, whose hash
+	(or numeric value) has already been computed
+	Returns 0 if ok, != 0 in case of error
+==================================================================*/
+extern int md380_BindReferenceKey (const FieldDescriptor* fieldDescriptor, t_reference* ref, unsigned noOfRecsInReferencedTable, const t_unicode* referencedString, unsigned referencedId, const char* recordType, int recordNumber, const char* fieldName, const char* searchedTable, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
 /*==================================================================
 	Bind the references in a container
 	Returns 0 if ok, != 0 in case of error
@@ -7,7 +7,7 @@
 #include <assert.h>
 
 /* Validate record ChannelInformation */
-static int validate_ChannelInformation (const TRDTFile* container, const T_ChannelInformation* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+int validate_ChannelInformation (const TRDTFile* container, const T_ChannelInformation* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
 {
 	int noOfViolations = 0;
 	NOWARN_UNUSED(container);
@@ -25,7 +25,7 @@ static int validate_ChannelInformation (const TRDTFile* container, const T_Chann
 }
 
 /* Validate record DigitalContact */
-static int validate_DigitalContact (const TRDTFile* container, const T_DigitalContact* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+int validate_DigitalContact (const TRDTFile* container, const T_DigitalContact* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
 {
 	int noOfViolations = 0;
 	NOWARN_UNUSED(container);
@@ -38,7 +38,7 @@ static int validate_DigitalContact (const TRDTFile* container, const T_DigitalCo
 }
 
 /* Validate record DigitalRxGroupList */
-static int validate_DigitalRxGroupList (const TRDTFile* container, const T_DigitalRxGroupList* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+int validate_DigitalRxGroupList (const TRDTFile* container, const T_DigitalRxGroupList* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
 {
 	int noOfViolations = 0;
 	NOWARN_UNUSED(container);
@@ -51,7 +51,7 @@ static int validate_DigitalRxGroupList (const TRDTFile* container, const T_Digit
 }
 
 /* Validate record GeneralSettings */
-static int validate_GeneralSettings (const TRDTFile* container, const T_GeneralSettings* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+int validate_GeneralSettings (const TRDTFile* container, const T_GeneralSettings* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
 {
 	int noOfViolations = 0;
 	NOWARN_UNUSED(container);
@@ -121,7 +121,7 @@ static int validate_GeneralSettings (const TRDTFile* container, const T_GeneralS
 }
 
 /* Validate record ScanList */
-static int validate_ScanList (const TRDTFile* container, const T_ScanList* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+int validate_ScanList (const TRDTFile* container, const T_ScanList* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
 {
 	int noOfViolations = 0;
 	NOWARN_UNUSED(container);
@@ -134,7 +134,7 @@ static int validate_ScanList (const TRDTFile* container, const T_ScanList* rec,
 }
 
 /* Validate record TextMessage */
-static int validate_TextMessage (const TRDTFile* container, const T_TextMessage* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+int validate_TextMessage (const TRDTFile* container, const T_TextMessage* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
 {
 	int noOfViolations = 0;
 	NOWARN_UNUSED(container);
@@ -152,7 +152,7 @@ static int validate_TextMessage (const TRDTFile* container, const T_TextMessage*
 }
 
 /* Validate record ZoneInformation */
-static int validate_ZoneInformation (const TRDTFile* container, const T_ZoneInformation* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+int validate_ZoneInformation (const TRDTFile* container, const T_ZoneInformation* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
 {
 	int noOfViolations = 0;
 	NOWARN_UNUSED(container);
@@ -165,34 +165,54 @@ static int validate_ZoneInformation (const TRDTFile* container, const T_ZoneInfo
 }
 /* Validate an entire container */
 int validateContainer(const TRDTFile* container, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
+{
+	return validateContainerTables (container, TABLES_ALL_TRDTFile, reportErrorFunc, reportErrorParam);
+}
+
+/* Validate the record types of a container selected by tableMask (TABLE_xxx bits) */
+int validateContainerTables(const TRDTFile* container, unsigned tableMask, ReportErrorFunc reportErrorFunc, void* reportErrorParam)
 {
 	int noOfViolations = 0;
 	unsigned i;
 	
-	for (i=0; i<container->ChannelInformation_COUNT; i++) {
-		noOfViolations += validate_ChannelInformation (container, container->ChannelInformation+i, i, reportErrorFunc, reportErrorParam);
+	if (tableMask & TABLE_ChannelInformation) {
+		for (i=0; i<container->ChannelInformation_COUNT; i++) {
+			noOfViolations += validate_ChannelInformation (container, container->ChannelInformation+i, i, reportErrorFunc, reportErrorParam);
+		}
 	}
 	
-	for (i=0; i<container->DigitalContact_COUNT; i++) {
-		noOfViolations += validate_DigitalContact (container, container->DigitalContact+i, i, reportErrorFunc, reportErrorParam);
+	if (tableMask & TABLE_DigitalContact) {
+		for (i=0; i<container->DigitalContact_COUNT; i++) {
+			noOfViolations += validate_DigitalContact (container, container->DigitalContact+i, i, reportErrorFunc, reportErrorParam);
+		}
 	}
 	
-	for (i=0; i<container->DigitalRxGroupList_COUNT; i++) {
-		noOfViolations += validate_DigitalRxGroupList (container, container->DigitalRxGroupList+i, i, reportErrorFunc, reportErrorParam);
+	if (tableMask & TABLE_DigitalRxGroupList) {
+		for (i=0; i<container->DigitalRxGroupList_COUNT; i++) {
+			noOfViolations += validate_DigitalRxGroupList (container, container->DigitalRxGroupList+i, i, reportErrorFunc, reportErrorParam);
+		}
 	}
 	
-	noOfViolations += validate_GeneralSettings (container, &container->GeneralSettings, -1, reportErrorFunc, reportErrorParam);
+	if (tableMask & TABLE_GeneralSettings) {
+		noOfViolations += validate_GeneralSettings (container, &container->GeneralSettings, -1, reportErrorFunc, reportErrorParam);
+	}
 	
-	for (i=0; i<container->ScanList_COUNT; i++) {
-		noOfViolations += validate_ScanList (container, container->ScanList+i, i, reportErrorFunc, reportErrorParam);
+	if (tableMask & TABLE_ScanList) {
+		for (i=0; i<container->ScanList_COUNT; i++) {
+			noOfViolations += validate_ScanList (container, container->ScanList+i, i, reportErrorFunc, reportErrorParam);
+		}
 	}
 	
-	for (i=0; i<container->TextMessage_COUNT; i++) {
-		noOfViolations += validate_TextMessage (container, container->TextMessage+i, i, reportErrorFunc, reportErrorParam);
+	if (tableMask & TABLE_TextMessage) {
+		for (i=0; i<container->TextMessage_COUNT; i++) {
+			noOfViolations += validate_TextMessage (container, container->TextMessage+i, i, reportErrorFunc, reportErrorParam);
+		}
 	}
 	
-	for (i=0; i<container->ZoneInformation_COUNT; i++) {
-		noOfViolations += validate_ZoneInformation (container, container->ZoneInformation+i, i, reportErrorFunc, reportErrorParam);
+	if (tableMask & TABLE_ZoneInformation) {
+		for (i=0; i<container->ZoneInformation_COUNT; i++) {
+			noOfViolations += validate_ZoneInformation (container, container->ZoneInformation+i, i, reportErrorFunc, reportErrorParam);
+		}
 	}
 	return noOfViolations;
 }
@@ -7,4 +7,28 @@
 /* Validate an entire container */
 extern int validateContainer(const TRDTFile* container, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
 
+/* Validate the record types of a container selected by tableMask (TABLE_xxx bits) */
+extern int validateContainerTables(const TRDTFile* container, unsigned tableMask, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
+/* Validate record ChannelInformation */
+extern int validate_ChannelInformation (const TRDTFile* container, const T_ChannelInformation* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
+/* Validate record DigitalContact */
+extern int validate_DigitalContact (const TRDTFile* container, const T_DigitalContact* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
+/* Validate record DigitalRxGroupList */
+extern int validate_DigitalRxGroupList (const TRDTFile* container, const T_DigitalRxGroupList* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
+/* Validate record GeneralSettings */
+extern int validate_GeneralSettings (const TRDTFile* container, const T_GeneralSettings* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
+/* Validate record ScanList */
+extern int validate_ScanList (const TRDTFile* container, const T_ScanList* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
+/* Validate record TextMessage */
+extern int validate_TextMessage (const TRDTFile* container, const T_TextMessage* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
+/* Validate record ZoneInformation */
+extern int validate_ZoneInformation (const TRDTFile* container, const T_ZoneInformation* rec, int recordLine, ReportErrorFunc reportErrorFunc, void* reportErrorParam);
+
 #endif